@@ -5,39 +5,51 @@
 #include "adasdisplay.h"
 #include "styles.h"
 #include "icon.h"
+#include "cameracaptureworker.h"
+#include "framecopycounter.h"
+#include "frametiming.h"
+#include "lanedetector.h"
+#include "overlaylayer.h"
+#include "startuptimeline.h"
 
 #include <QApplication>
+#include <QGuiApplication>
 #include <QFont>
-#include <QRandomGenerator>
 #include <QDebug>
 #include <QPainter>
+#include <QScreen>
 #include <QShortcut>
+#include <QShowEvent>
+
+namespace {
+
+// 等待所有摄像头首帧的最长时间，超时后输出启动报告
+constexpr int kStartupReportTimeoutMs = 10000;
+
+} // namespace
 
 /**
  * @brief ADASDisplay类的构造函数
- * @param camera0Path 摄像头0的设备路径
- * @param camera1Path 摄像头1的设备路径
- * @param camera2Path 摄像头2的设备路径
- * @param camera3Path 摄像头3的设备路径
+ * @param registry 摄像头注册表
  * @param parent 父窗口指针
  * 
  * 初始化成员变量并调用initUI()和setupTimers()方法设置界面和定时器
  */
-ADASDisplay::ADASDisplay(const QString& camera0Path, const QString& camera1Path, 
-                         const QString& camera2Path, const QString& camera3Path, 
-                         QWidget *parent)
+ADASDisplay::ADASDisplay(const CameraRegistry& registry, QWidget *parent)
     : QMainWindow(parent)
-    , m_currentSpeed(0)
-    , m_alarmActive(false)
-    , m_fatigueLevel(20)
-    , m_camera0Active(false)
-    , m_camera1Active(false)
-    , m_camera2Active(false)
-    , m_camera3Active(false)
-    , m_camera0Path(camera0Path)
-    , m_camera1Path(camera1Path)
-    , m_camera2Path(camera2Path)
-    , m_camera3Path(camera3Path)
+    , m_state(new ADASState(this))
+    , m_okPalette(textPalette(STATUS_OK_COLOR))
+    , m_warningPalette(textPalette(STATUS_WARNING_COLOR))
+    , m_dangerPalette(textPalette(STATUS_DANGER_COLOR))
+    , m_registry(registry)
+    , m_firstFramesPending(0)
+    , m_startupReported(false)
+    , m_latencyOverlayVisible(false)
+    , m_eventRecorder(nullptr)
+    , m_vehicleReader(nullptr)
+    , m_governor(new QualityGovernor(this))
+    , m_driverMonitor(nullptr)
+    , m_vehicleDetector(nullptr)
 {
     // 设置窗口标题
     setWindowTitle("高级驾驶辅助系统");
@@ -48,20 +60,32 @@ ADASDisplay::ADASDisplay(const QString& camera0Path, const QString& camera1Path,
     // 隐藏标题栏
     setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
     
-    // 设置全屏显示
-    showFullScreen();
-    
     // 添加ESC键退出全屏快捷键
     QShortcut *shortcut = new QShortcut(QKeySequence(Qt::Key_Escape), this);
     connect(shortcut, &QShortcut::activated, this, &ADASDisplay::toggleFullScreen);
     
+    // 添加F2键切换延迟统计叠加层
+    QShortcut *latencyShortcut = new QShortcut(QKeySequence(Qt::Key_F2), this);
+    connect(latencyShortcut, &QShortcut::activated, this, &ADASDisplay::toggleLatencyOverlay);
+    
     initUI();
+    
+    // 控件只随状态变化更新，先按初始状态整体更新一次
+    connect(m_state, &ADASState::changed, this, &ADASDisplay::applyState);
+    applyState(ADASState::AllFields);
     setupTimers();
+    StartupTimeline::mark("界面创建完成");
     
-    // 初始化摄像头
+    // 初始化摄像头，设备在各采集线程中并行打开，这里立即返回
     if (!initCameras()) {
-        statusBar()->showMessage("摄像头初始化失败，请检查设备连接", 5000);
+        statusBar()->showMessage("未配置摄像头", 5000);
     }
+    
+    // 界面和占位画面就绪后再全屏显示，避免initUI()中修改窗口标志导致窗口重建
+    showFullScreen();
+    
+    // 部分摄像头一直没有画面时也输出启动报告
+    QTimer::singleShot(kStartupReportTimeoutMs, this, &ADASDisplay::reportStartup);
 }
 
 /**
@@ -72,12 +96,53 @@ ADASDisplay::ADASDisplay(const QString& camera0Path, const QString& camera1Path,
 ADASDisplay::~ADASDisplay()
 {
     // 释放资源
-    delete m_dataTimer;
     delete m_datetimeTimer;
-    delete m_cameraTimer;
     
-    // 关闭摄像头
+    // 停止车辆信号读取线程
+    if (m_vehicleReader) {
+        std::cout << "CAN帧数: " << m_vehicleReader->receivedFrames()
+                  << "，包含已知信号: " << m_vehicleReader->decodedFrames() << std::endl;
+        delete m_vehicleReader;
+    }
+    
+    // 画面控件仍然有效，关闭摄像头前输出延迟统计
+    reportLatency();
+    
+    // 关闭摄像头，之后不再有帧进入录像器
     closeCameras();
+    
+    // 写完正在进行的事件录像
+    delete m_eventRecorder;
+    
+    // 采集线程已停止，不再有帧提交给驾驶员监测
+    if (m_driverMonitor->processedFrames() > 0) {
+        std::cout << "驾驶员监测: 处理" << m_driverMonitor->processedFrames()
+                  << "帧，人脸检测" << m_driverMonitor->detections()
+                  << "次，平均" << m_driverMonitor->meanProcessMs()
+                  << " ms，最长" << m_driverMonitor->maxProcessMs() << " ms" << std::endl;
+    }
+    delete m_driverMonitor;
+    
+    // 车辆检测的推理吞吐量，用于估算所需的硬件
+    if (m_vehicleDetector->inferences() > 0) {
+        std::cout << "车辆检测: 推理" << m_vehicleDetector->inferences()
+                  << "次，平均每批" << m_vehicleDetector->meanBatchSize()
+                  << "帧，平均" << m_vehicleDetector->meanInferenceMs()
+                  << " ms，每核每秒" << m_vehicleDetector->imagesPerCoreSecond()
+                  << "帧 / " << m_vehicleDetector->detectionsPerCoreSecond() << "个目标" << std::endl;
+    }
+    delete m_vehicleDetector;
+    
+    // 输出状态面板的更新统计
+    std::cout << "状态写入: " << m_state->writes()
+              << "，实际变化: " << m_state->changes()
+              << "，控件更新批次: " << m_state->notifications() << std::endl;
+    
+    // 输出显示路径的拷贝统计
+    const FrameCopyCounter::Snapshot copies = FrameCopyCounter::snapshot();
+    std::cout << "显示帧数: " << copies.frames
+              << "，每帧像素遍历: " << copies.passesPerFrame()
+              << "，每帧分配: " << copies.allocationsPerFrame() << std::endl;
 }
 
 /**
@@ -97,8 +162,9 @@ void ADASDisplay::initUI()
     // 设置应用图标
     setWindowIcon(createAppIcon());
     
-    // 应用样式表
+    // 应用样式表，文字颜色由调色板决定，状态颜色切换时不需要重新解析样式表
     setStyleSheet(MAIN_STYLE);
+    setPalette(textPalette(TEXT_COLOR));
     
     // 创建中央窗口部件
     QWidget *centralWidget = new QWidget();
@@ -109,89 +175,12 @@ void ADASDisplay::initUI()
     mainLayout->setSpacing(2);  // 减小间距
     mainLayout->setContentsMargins(2, 2, 2, 2);  // 减小边距
     
-    // 上部摄像头区域容器
-    QWidget *cameraContainer = new QWidget();
-    QHBoxLayout *cameraLayout = new QHBoxLayout(cameraContainer);
-    cameraLayout->setSpacing(2);  // 减小间距
-    cameraLayout->setContentsMargins(0, 0, 0, 0);  // 移除边距
-    
-    // 左侧 - 2x2摄像头网格
-    QWidget *cameraGrid = new QWidget();
-    QGridLayout *gridLayout = new QGridLayout(cameraGrid);
-    gridLayout->setSpacing(2);  // 减小网格间距
-    gridLayout->setContentsMargins(0, 0, 0, 0);  // 移除边距
-    
-    // 创建4个摄像头面板 - 使用普通QFrame替代DraggableCameraPanel
-    QVector<QPair<int, int>> positions = {
-        {0, 0}, {0, 1}, {1, 0}, {1, 1}
-    };
-    
-    for (int i = 0; i < 4; ++i) {
-        // 创建固定的摄像头面板（不可拖拽）
-        QFrame *cameraFrame = new QFrame();
-        cameraFrame->setFrameShape(QFrame::NoFrame);
-        cameraFrame->setLineWidth(0);
-        cameraFrame->setStyleSheet("background-color: #222222;");
-        cameraFrame->setMinimumSize(450, 360);
-        
-        // 使用QGridLayout以便更好地控制填充
-        QGridLayout *frameLayout = new QGridLayout(cameraFrame);
-        frameLayout->setContentsMargins(0, 0, 0, 0);
-        frameLayout->setSpacing(0);
-        
-        // 添加摄像头画面
-        QLabel *cameraFeed = new QLabel();
-        cameraFeed->setAlignment(Qt::AlignCenter);
-        cameraFeed->setText("无信号");
-        cameraFeed->setStyleSheet("color: white;");
-        cameraFeed->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-        cameraFeed->setMinimumSize(450, 360);
-        cameraFeed->setScaledContents(true);
-        
-        frameLayout->addWidget(cameraFeed, 0, 0);
-        
-        // 存储摄像头引用
-        m_cameraLabels.append(cameraFeed);
-        
-        gridLayout->addWidget(cameraFrame, positions[i].first, positions[i].second);
-    }
-    
-    // 设置网格单元的拉伸
-    for (int i = 0; i < 2; ++i) {
-        gridLayout->setColumnStretch(i, 1);
-        gridLayout->setRowStretch(i, 1);
-    }
+    // 上部摄像头区域 - 网格和驾驶员摄像头由一个合成器控件绘制，只有一个后备缓冲区
+    m_compositor = new CameraCompositor(m_registry.count());
+    m_compositor->setMinimumSize(900 + CameraCompositor::kSpacing + CameraCompositor::kDriverColumnWidth, 720);
     
-    // 右侧 - 驾驶员摄像头面板（不可拖拽）
-    QFrame *driverFrame = new QFrame();
-    driverFrame->setFrameShape(QFrame::NoFrame);
-    driverFrame->setLineWidth(0);
-    driverFrame->setStyleSheet("background-color: #222222;");
-    driverFrame->setFixedWidth(450);
-    driverFrame->setMinimumHeight(720);
-    
-    // 使用QGridLayout以便更好地控制填充
-    QGridLayout *driverLayout = new QGridLayout(driverFrame);
-    driverLayout->setContentsMargins(0, 0, 0, 0);
-    driverLayout->setSpacing(0);
-    
-    // 添加驾驶员摄像头画面
-    m_driverFeed = new QLabel();
-    m_driverFeed->setAlignment(Qt::AlignCenter);
-    m_driverFeed->setText("无信号");
-    m_driverFeed->setStyleSheet("color: white;");
-    m_driverFeed->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_driverFeed->setMinimumSize(450, 720);
-    m_driverFeed->setScaledContents(true);
-    
-    driverLayout->addWidget(m_driverFeed, 0, 0);
-    
-    // 添加摄像头区域到布局
-    cameraLayout->addWidget(cameraGrid, 4);  // 摄像头网格占比
-    cameraLayout->addWidget(driverFrame, 1);  // 驾驶员摄像头占比
-    
-    // 将摄像头容器添加到主布局
-    mainLayout->addWidget(cameraContainer, 10);  // 摄像头区域占比
+    // 将摄像头区域添加到主布局
+    mainLayout->addWidget(m_compositor, 10);  // 摄像头区域占比
     
     // 底部状态面板 - 扩展到整个窗口宽度
     m_statusPanel = createStatusPanel();
@@ -211,359 +200,280 @@ void ADASDisplay::initUI()
 /**
  * @brief 设置定时器
  * 
- * 设置数据更新、日期时间更新和摄像头更新的定时器
+ * 设置日期时间更新的定时器，车速、疲劳度和摄像头画面都由各自的线程通知
  */
 void ADASDisplay::setupTimers()
 {
-    // 数据更新计时器
-    m_dataTimer = new QTimer(this);
-    connect(m_dataTimer, &QTimer::timeout, this, &ADASDisplay::updateData);
-    m_dataTimer->start(100);  // 每100毫秒更新一次
-    
     // 日期时间更新计时器
     m_datetimeTimer = new QTimer(this);
     connect(m_datetimeTimer, &QTimer::timeout, this, &ADASDisplay::updateDateTime);
     m_datetimeTimer->start(1000);  // 每秒更新一次
     
-    // 摄像头更新计时器
-    m_cameraTimer = new QTimer(this);
-    connect(m_cameraTimer, &QTimer::timeout, this, &ADASDisplay::updateCameraFeeds);
-    m_cameraTimer->start(33);  // 约30帧每秒
+    // 摄像头画面不使用定时器轮询，由采集线程的frameAvailable()驱动
 }
 
 /**
- * @brief 更新数据
- * 
- * 模拟车速的小幅随机变化，更新车速显示和驾驶员疲劳度
+ * @brief 驾驶员监测给出新的估计
+ * @param estimate 估计结果
+ *
+ * 观测时间不足时不更新疲劳度；超过疲劳阈值时自动触发报警
+ */
+void ADASDisplay::onDriverEstimate(const DriverEstimate& estimate)
+{
+    if (!estimate.valid)
+        return;
+    
+    m_state->setFatigueLevel(estimate.fatigueLevel);
+    if (m_state->driverCondition() == ADASState::DriverCondition::Fatigued && !m_state->alarmActive()) {
+        toggleAlarm();
+    }
+}
+
+/**
+ * @brief 按变化的字段更新状态面板控件
+ * @param fields 变化的字段
+ *
+ * 状态颜色通过预先构建的调色板切换，不调用setStyleSheet()，不触发样式重新计算
  */
-void ADASDisplay::updateData()
+void ADASDisplay::applyState(ADASState::Fields fields)
 {
-    // 模拟车速的小幅随机变化
-    double speedChange = QRandomGenerator::global()->bounded(4.0) - 2.0;
-    m_currentSpeed = qBound(0.0, m_currentSpeed + speedChange, 200.0);
+    if (fields & ADASState::SpeedField) {
+        m_speedGauge->setValue(m_state->speed());
+    }
     
-    // 更新车速显示
-    m_speedValue->setText(QString("%1 km/h").arg(static_cast<int>(m_currentSpeed)));
-    m_speedProgress->setValue(static_cast<int>(m_currentSpeed));
+    if (fields & ADASState::AlarmField) {
+        if (m_state->alarmActive()) {
+            m_alarmStatus->setText("警报");
+            m_alarmStatus->setPalette(m_dangerPalette);
+            m_alarmButton->setText("解除");
+        } else {
+            m_alarmStatus->setText("正常");
+            m_alarmStatus->setPalette(m_okPalette);
+            m_alarmButton->setText("报警");
+        }
+    }
     
-    // 模拟驾驶员疲劳度随时间略微增加
-    if (QRandomGenerator::global()->bounded(1.0) < 0.1) {  // 每秒10%的几率增加疲劳度
-        m_fatigueLevel = qMin(100, m_fatigueLevel + 1);
-        
-        // 根据疲劳度更新驾驶员状态
-        if (m_fatigueLevel > 70) {
+    if (fields & ADASState::FatigueField) {
+        m_fatigueMeter->setValue(m_state->fatigueLevel());
+    }
+    
+    if (fields & ADASState::DriverConditionField) {
+        switch (m_state->driverCondition()) {
+        case ADASState::DriverCondition::Fatigued:
             m_driverStatus->setText("警告：驾驶员疲劳");
-            m_driverStatus->setStyleSheet("color: #e74c3c;");
-            
-            // 如果疲劳度高，自动触发报警
-            if (!m_alarmActive) {
-                toggleAlarm();
-            }
-        } else if (m_fatigueLevel > 50) {
+            m_driverStatus->setPalette(m_dangerPalette);
+            break;
+        case ADASState::DriverCondition::Tired:
             m_driverStatus->setText("注意：驾驶员轻度疲劳");
-            m_driverStatus->setStyleSheet("color: #f39c12;");
-        } else {
+            m_driverStatus->setPalette(m_warningPalette);
+            break;
+        case ADASState::DriverCondition::Alert:
             m_driverStatus->setText("正常：驾驶员状态良好");
-            m_driverStatus->setStyleSheet("color: #2ecc71;");
+            m_driverStatus->setPalette(m_okPalette);
+            break;
         }
-        
-        // 更新疲劳度进度条
-        m_driverFatigue->setValue(m_fatigueLevel);
     }
 }
 
 /**
  * @brief 初始化摄像头
- * @return 是否成功初始化摄像头
+ * @return 是否有需要采集的摄像头
  * 
- * 打开摄像头设备
+ * 按注册表为网格中的每个摄像头和驾驶员摄像头创建流水线并启动采集线程，不等待设备打开。
+ * 驾驶员摄像头的流水线排在最后，索引为网格摄像头数量
  */
 bool ADASDisplay::initCameras()
 {
-    // 检查摄像头设备是否存在
-    bool camera0Exists = QFile::exists(m_camera0Path);
-    bool camera1Exists = QFile::exists(m_camera1Path);
-    bool camera2Exists = QFile::exists(m_camera2Path);
-    bool camera3Exists = QFile::exists(m_camera3Path);
-    
-    // 输出设备状态信息
-    std::cout << "摄像头设备状态：" << std::endl;
-    std::cout << "摄像头0 (" << m_camera0Path.toStdString() << "): " << (camera0Exists ? "存在" : "不存在") << std::endl;
-    std::cout << "摄像头1 (" << m_camera1Path.toStdString() << "): " << (camera1Exists ? "存在" : "不存在") << std::endl;
-    std::cout << "摄像头2 (" << m_camera2Path.toStdString() << "): " << (camera2Exists ? "存在" : "不存在") << std::endl;
-    std::cout << "摄像头3 (" << m_camera3Path.toStdString() << "): " << (camera3Exists ? "存在" : "不存在") << std::endl;
-    
-    // 只尝试打开存在的摄像头设备
-    // 尝试打开摄像头0
-    if (camera0Exists) {
-        m_camera0Active = m_camera0.open(m_camera0Path.toStdString(), cv::CAP_V4L2);
-        if (m_camera0Active) {
-            // 设置摄像头属性
-            m_camera0.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-            m_camera0.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-            // 禁用不必要的功能，减少警告
-            m_camera0.set(cv::CAP_PROP_BUFFERSIZE, 1);
-            // 设置更多属性以解决内存分配问题
-            m_camera0.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-            std::cout << "摄像头0初始化成功" << std::endl;
-        } else {
-            std::cout << "摄像头0打开失败" << std::endl;
-        }
-    } else {
-        m_camera0Active = false;
-        std::cout << "摄像头0设备不存在，跳过初始化" << std::endl;
+    // 录像回放的各摄像头从同一时刻开始走会话时间轴
+    m_registry.setReplayClock(monotonicNowUs());
+    QVector<CameraConfig> cameras = m_registry.cameras();
+    const QVector<VideoTile*>& tiles = m_compositor->tiles();
+    cameras.append(m_registry.driverCamera());
+    
+    // 输出设备配置信息，设备是否可用由采集线程报告
+    std::cout << "摄像头配置：" << std::endl;
+    for (int i = 0; i < cameras.size(); ++i) {
+        std::cout << "摄像头" << i << " " << cameras[i].name.toStdString()
+                  << " (" << cameras[i].location.toStdString() << ")" << std::endl;
     }
     
-    // 尝试打开摄像头1
-    if (camera1Exists) {
-        m_camera1Active = m_camera1.open(m_camera1Path.toStdString(), cv::CAP_V4L2);
-        if (m_camera1Active) {
-            // 设置摄像头属性
-            m_camera1.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-            m_camera1.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-            // 禁用不必要的功能，减少警告
-            m_camera1.set(cv::CAP_PROP_BUFFERSIZE, 1);
-            // 设置更多属性以解决内存分配问题
-            m_camera1.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-            std::cout << "摄像头1初始化成功" << std::endl;
-        } else {
-            std::cout << "摄像头1打开失败" << std::endl;
-        }
-    } else {
-        m_camera1Active = false;
-        std::cout << "摄像头1设备不存在，跳过初始化" << std::endl;
+    // 各摄像头的MJPEG帧在采集线程中进入录像缓存，报警时写入磁盘
+    QStringList cameraNames;
+    for (const CameraConfig& camera : cameras) {
+        cameraNames.append(camera.name);
     }
-    
-    // 尝试打开摄像头2
-    if (camera2Exists) {
-        m_camera2Active = m_camera2.open(m_camera2Path.toStdString(), cv::CAP_V4L2);
-        if (m_camera2Active) {
-            // 设置摄像头属性
-            m_camera2.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-            m_camera2.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-            // 禁用不必要的功能，减少警告
-            m_camera2.set(cv::CAP_PROP_BUFFERSIZE, 1);
-            // 设置更多属性以解决内存分配问题
-            m_camera2.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-            std::cout << "摄像头2初始化成功" << std::endl;
-        } else {
-            std::cout << "摄像头2打开失败" << std::endl;
+    m_eventRecorder = new EventRecorder(cameraNames);
+    
+    // 驾驶员监测分析驾驶员摄像头解码后的画面，须在采集线程启动前接好
+    m_driverMonitor = new DriverMonitor();
+    m_driverMonitor->loadModels();
+    connect(m_driverMonitor, &DriverMonitor::estimateChanged, this, &ADASDisplay::onDriverEstimate);
+    
+    // 车辆检测把所有网格摄像头的采样合并为一批推理，同样须在采集线程启动前接好
+    m_vehicleDetector = new VehicleDetector();
+    m_vehicleDetector->loadModel();
+    
+    // 打开和读取都在各自的采集线程中进行，打开失败的摄像头在后台重连；解码和缩放共享线程池
+    bool anyStarted = false;
+    for (int i = 0; i < cameras.size(); ++i) {
+        CameraPipeline *pipeline = new CameraPipeline(i, cameras[i], tiles[i]);
+        // 状态由采集线程发出，这里自动排队到界面线程处理
+        connect(pipeline->worker(), &CameraCaptureWorker::stateChanged,
+                this, &ADASDisplay::onCameraStateChanged);
+        connect(pipeline->worker(), &CameraCaptureWorker::frameAvailable,
+                this, &ADASDisplay::onFrameAvailable);
+        pipeline->worker()->setEventRecorder(m_eventRecorder);
+        if (i == cameras.size() - 1) {
+            pipeline->worker()->addFrameAnalyzer(m_driverMonitor);
+        } else if (cameras[i].objectDetection) {
+            // 检测结果由检测线程直接发布到画面块的叠加层
+            pipeline->worker()->addFrameAnalyzer(m_vehicleDetector->addCamera(tiles[i]->overlay()->addChannel()));
         }
-    } else {
-        m_camera2Active = false;
-        std::cout << "摄像头2设备不存在，跳过初始化" << std::endl;
-    }
-    
-    // 尝试打开摄像头3
-    if (camera3Exists) {
-        m_camera3Active = m_camera3.open(m_camera3Path.toStdString(), cv::CAP_V4L2);
-        if (m_camera3Active) {
-            // 设置摄像头属性
-            m_camera3.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-            m_camera3.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-            // 禁用不必要的功能，减少警告
-            m_camera3.set(cv::CAP_PROP_BUFFERSIZE, 1);
-            // 设置更多属性以解决内存分配问题
-            m_camera3.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-            std::cout << "摄像头3初始化成功" << std::endl;
-        } else {
-            std::cout << "摄像头3打开失败" << std::endl;
+        if (pipeline->start()) {
+            anyStarted = true;
+            ++m_firstFramesPending;
         }
-    } else {
-        m_camera3Active = false;
-        std::cout << "摄像头3设备不存在，跳过初始化" << std::endl;
+        m_pipelines.append(pipeline);
+        m_governor->addCamera(pipeline, i == cameras.size() - 1);
     }
+    m_governor->start();
+    m_driverMonitor->start();
+    m_vehicleDetector->start();
     
-    return m_camera0Active || m_camera1Active || m_camera2Active || m_camera3Active;
+    return anyStarted;
 }
 
 /**
  * @brief 关闭摄像头
  * 
- * 释放摄像头资源
+ * 停止采集线程并释放摄像头资源
  */
 void ADASDisplay::closeCameras()
 {
-    if (m_camera0Active) {
-        m_camera0.release();
-        m_camera0Active = false;
+    m_governor->stop();
+    m_governor->clear();
+    for (CameraPipeline *pipeline : m_pipelines) {
+        pipeline->stop();
+        delete pipeline;
     }
-    
-    if (m_camera1Active) {
-        m_camera1.release();
-        m_camera1Active = false;
+    m_pipelines.clear();
+}
+
+/**
+ * @brief 设置报警事件录像的保存目录
+ * @param directory 目录路径
+ */
+void ADASDisplay::setRecordingDirectory(const QString& directory)
+{
+    m_eventRecorder->setDirectory(directory);
+}
+
+/**
+ * @brief 设置是否按显示延迟自动调整摄像头画质
+ * @param enabled 是否启用
+ */
+void ADASDisplay::setQualityGovernorEnabled(bool enabled)
+{
+    if (enabled) {
+        m_governor->start();
+    } else {
+        m_governor->stop();
     }
-    
-    if (m_camera2Active) {
-        m_camera2.release();
-        m_camera2Active = false;
+}
+
+/**
+ * @brief 从指定目录重新加载驾驶员监测的级联模型
+ * @param directory 模型目录
+ *
+ * 监测线程停止期间采集线程提交的帧直接丢弃，不需要停止摄像头
+ */
+void ADASDisplay::setDriverModelDirectory(const QString& directory)
+{
+    m_driverMonitor->stop();
+    if (m_driverMonitor->loadModels(directory)) {
+        m_driverMonitor->start();
+    }
+}
+
+/**
+ * @brief 加载指定的车辆检测模型并重新开始检测
+ * @param path 模型文件路径
+ */
+void ADASDisplay::setVehicleModel(const QString& path)
+{
+    m_vehicleDetector->stop();
+    if (m_vehicleDetector->loadModel(path)) {
+        m_vehicleDetector->start();
+    }
+}
+
+/**
+ * @brief 设置车辆检测推理可以使用的CPU预算
+ * @param cores 核数
+ */
+void ADASDisplay::setDetectorCpuBudget(double cores)
+{
+    m_vehicleDetector->setCpuBudget(cores);
+}
+
+/**
+ * @brief 把各摄像头的统计加入性能报告
+ * @param report 性能报告
+ */
+void ADASDisplay::fillPerfReport(PerfReport& report) const
+{
+    for (CameraPipeline *pipeline : m_pipelines) {
+        report.addCamera(pipeline->config().name, pipeline->worker()->capturedFrames(),
+                         pipeline->tile()->latencyStats().summary());
     }
+    report.setDetection(m_vehicleDetector->inferences(), m_vehicleDetector->inferredImages(),
+                        m_vehicleDetector->detectedObjects(), m_vehicleDetector->inferenceCpuUs());
+}
 
-    if (m_camera3Active) {
-        m_camera3.release();
-        m_camera3Active = false;
+/**
+ * @brief 输出各摄像头的延迟统计
+ */
+void ADASDisplay::reportLatency()
+{
+    std::cout << "采集到显示延迟统计（毫秒）:" << std::endl;
+    for (CameraPipeline *pipeline : m_pipelines) {
+        const LatencyStats::Summary stats = pipeline->tile()->latencyStats().summary();
+        std::cout << "  " << pipeline->config().name.toStdString()
+                  << ": 显示" << stats.frames << "帧，丢帧" << stats.dropped
+                  << "，p50 " << stats.p50Ms << "，p99 " << stats.p99Ms
+                  << "，最大 " << stats.maxMs << "，历史最大 " << stats.worstMs
+                  << "，显示间隔 " << stats.intervalMs << "±" << stats.jitterMs << std::endl;
+        if (const LaneDetector *lanes = pipeline->laneDetector()) {
+            std::cout << "    车道线检测: 处理" << lanes->processedFrames()
+                      << "帧，平均" << lanes->meanProcessMs()
+                      << " ms，最长" << lanes->maxProcessMs() << " ms" << std::endl;
+        }
     }
 }
 
 /**
- * @brief 更新摄像头画面
+ * @brief 摄像头有新帧
+ * @param index 摄像头索引
  * 
- * 从摄像头获取画面并更新显示
+ * 帧到达后立即取走信箱中的最新帧交给画面块缩放，不会在界面线程上阻塞读取；
+ * 通知排队期间到达的帧只保留最新一帧，过时的帧不排队。
+ * 多个摄像头的画面由合成器合并到同一个显示刷新周期中绘制
  */
-void ADASDisplay::updateCameraFeeds()
+void ADASDisplay::onFrameAvailable(int index)
 {
+    if (index < 0 || index >= m_pipelines.size())
+        return;
+    
     try {
-        // 更新真实摄像头画面
-        if (m_camera0Active) {
-            cv::Mat frame;
-            bool success = false;
-            try {
-                success = m_camera0.read(frame);
-            } catch (const cv::Exception& e) {
-                std::cerr << "摄像头0读取异常: " << e.what() << std::endl;
-            }
-            
-            if (success && !frame.empty()) {
-                QImage image = matToQImage(frame);
-                if (m_cameraLabels.size() > 0) {
-                    m_cameraLabels[0]->setPixmap(QPixmap::fromImage(image));
-                }
-            } else if (!success) {
-                std::cerr << "摄像头0读取失败" << std::endl;
-                // 检查设备是否存在
-                if (QFile::exists(m_camera0Path)) {
-                    // 尝试重新初始化摄像头
-                    m_camera0.release();
-                    m_camera0Active = m_camera0.open(m_camera0Path.toStdString(), cv::CAP_V4L2);
-                    if (m_camera0Active) {
-                        m_camera0.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-                        m_camera0.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-                        m_camera0.set(cv::CAP_PROP_BUFFERSIZE, 1);
-                        m_camera0.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-                        std::cout << "摄像头0重新初始化成功" << std::endl;
-                    } else {
-                        std::cout << "摄像头0重新初始化失败" << std::endl;
-                    }
-                } else {
-                    m_camera0Active = false;
-                    std::cout << "摄像头0设备不存在，无法重新初始化" << std::endl;
-                }
-            }
-        }
-        
-        if (m_camera1Active) {
-            cv::Mat frame;
-            bool success = false;
-            try {
-                success = m_camera1.read(frame);
-            } catch (const cv::Exception& e) {
-                std::cerr << "摄像头1读取异常: " << e.what() << std::endl;
-            }
-            
-            if (success && !frame.empty()) {
-                QImage image = matToQImage(frame);
-                if (m_cameraLabels.size() > 1) {
-                    m_cameraLabels[1]->setPixmap(QPixmap::fromImage(image));
-                }
-            } else if (!success) {
-                std::cerr << "摄像头1读取失败" << std::endl;
-                // 检查设备是否存在
-                if (QFile::exists(m_camera1Path)) {
-                    // 尝试重新初始化摄像头
-                    m_camera1.release();
-                    m_camera1Active = m_camera1.open(m_camera1Path.toStdString(), cv::CAP_V4L2);
-                    if (m_camera1Active) {
-                        m_camera1.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-                        m_camera1.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-                        m_camera1.set(cv::CAP_PROP_BUFFERSIZE, 1);
-                        m_camera1.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-                        std::cout << "摄像头1重新初始化成功" << std::endl;
-                    } else {
-                        std::cout << "摄像头1重新初始化失败" << std::endl;
-                    }
-                } else {
-                    m_camera1Active = false;
-                    std::cout << "摄像头1设备不存在，无法重新初始化" << std::endl;
-                }
-            }
-        }
-        
-        if (m_camera2Active) {
-            cv::Mat frame;
-            bool success = false;
-            try {
-                success = m_camera2.read(frame);
-            } catch (const cv::Exception& e) {
-                std::cerr << "摄像头2读取异常: " << e.what() << std::endl;
-            }
-            
-            if (success && !frame.empty()) {
-                QImage image = matToQImage(frame);
-                if (m_cameraLabels.size() > 2) {
-                    m_cameraLabels[2]->setPixmap(QPixmap::fromImage(image));
-                }
-            } else if (!success) {
-                std::cerr << "摄像头2读取失败" << std::endl;
-                // 检查设备是否存在
-                if (QFile::exists(m_camera2Path)) {
-                    // 尝试重新初始化摄像头
-                    m_camera2.release();
-                    m_camera2Active = m_camera2.open(m_camera2Path.toStdString(), cv::CAP_V4L2);
-                    if (m_camera2Active) {
-                        m_camera2.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-                        m_camera2.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-                        m_camera2.set(cv::CAP_PROP_BUFFERSIZE, 1);
-                        m_camera2.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-                        std::cout << "摄像头2重新初始化成功" << std::endl;
-                    } else {
-                        std::cout << "摄像头2重新初始化失败" << std::endl;
-                    }
-                } else {
-                    m_camera2Active = false;
-                    std::cout << "摄像头2设备不存在，无法重新初始化" << std::endl;
-                }
-            }
-        }
+        CameraPipeline *pipeline = m_pipelines[index];
+        if (!pipeline->present() || m_startupReported)
+            return;
         
-        if (m_camera3Active) {
-            cv::Mat frame;
-            bool success = false;
-            try {
-                success = m_camera3.read(frame);
-            } catch (const cv::Exception& e) {
-                std::cerr << "摄像头3读取异常: " << e.what() << std::endl;
-            }
-            
-            if (success && !frame.empty()) {
-                QImage image = matToQImage(frame);
-                if (m_cameraLabels.size() > 3) {
-                    m_cameraLabels[3]->setPixmap(QPixmap::fromImage(image));
-                }
-            } else if (!success) {
-                std::cerr << "摄像头3读取失败" << std::endl;
-                // 检查设备是否存在
-                if (QFile::exists(m_camera3Path)) {
-                    // 尝试重新初始化摄像头
-                    m_camera3.release();
-                    m_camera3Active = m_camera3.open(m_camera3Path.toStdString(), cv::CAP_V4L2);
-                    if (m_camera3Active) {
-                        m_camera3.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-                        m_camera3.set(cv::CAP_PROP_FRAME_HEIGHT, 360);
-                        m_camera3.set(cv::CAP_PROP_BUFFERSIZE, 1);
-                        m_camera3.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M','J','P','G')); // 使用MJPG格式
-                        std::cout << "摄像头3重新初始化成功" << std::endl;
-                    } else {
-                        std::cout << "摄像头3重新初始化失败" << std::endl;
-                    }
-                } else {
-                    m_camera3Active = false;
-                    std::cout << "摄像头3设备不存在，无法重新初始化" << std::endl;
-                }
-            }
+        // 记录每个摄像头的首帧显示时间，全部到齐后输出启动报告
+        if (StartupTimeline::mark(QString("摄像头%1首帧显示").arg(pipeline->index()))
+            && --m_firstFramesPending == 0) {
+            reportStartup();
         }
-        
-        // 模拟其他摄像头画面
-        simulateOtherCameras();
     } catch (const std::exception& e) {
         qDebug() << "Camera update error:" << e.what();
     } catch (...) {
@@ -572,88 +482,69 @@ void ADASDisplay::updateCameraFeeds()
 }
 
 /**
- * @brief 模拟其他摄像头画面
+ * @brief 摄像头连接状态变化
+ * @param index 摄像头索引
+ * @param state 新状态
  * 
- * 生成模拟的摄像头画面用于演示
+ * 只更新提示文字，不访问设备
  */
-void ADASDisplay::simulateOtherCameras()
+void ADASDisplay::onCameraStateChanged(int index, CameraState state)
 {
-    // 模拟驾驶员监测画面
-    QImage driverImage(640, 480, QImage::Format_RGB888);
-    driverImage.fill(QColor(30, 30, 30));
-    
-    QPainter painter(&driverImage);
-    painter.setPen(Qt::white);
-    painter.setFont(QFont("Arial", 20));
-    painter.drawText(driverImage.rect(), Qt::AlignCenter, "驾驶员监测\n(模拟数据)");
-    
-    // 绘制一个简单的人脸轮廓
-    painter.setPen(QPen(Qt::green, 2));
-    painter.drawEllipse(QPoint(320, 240), 100, 120);
-    painter.drawEllipse(QPoint(280, 210), 20, 20); // 左眼
-    painter.drawEllipse(QPoint(360, 210), 20, 20); // 右眼
-    painter.drawArc(270, 260, 100, 50, 0, 180 * 16); // 微笑
-    
-    // 更新UI
-    m_driverFeed->setPixmap(QPixmap::fromImage(driverImage));
-    
-    // 只模拟摄像头2和3（索引2和3），因为0和1使用真实摄像头
-    for (int i = 3; i < 4 && i < m_cameraLabels.size(); ++i) {
-        QImage image(640, 480, QImage::Format_RGB888);
-        image.fill(QColor(30, 30, 30));
-        
-        QPainter painter(&image);
-        painter.setPen(Qt::white);
-        painter.setFont(QFont("Arial", 20));
-        
-        // 根据索引绘制不同的模拟画面
-        // if (i == 2) {
-        //     painter.drawText(image.rect(), Qt::AlignCenter, "车道线检测\n(模拟数据)");
-            
-        //     // 绘制简单的车道线
-        //     painter.setPen(QPen(Qt::yellow, 3));
-        //     painter.drawLine(160, 480, 280, 240);
-        //     painter.drawLine(480, 480, 360, 240);
-        // } else
-         {
-            painter.drawText(image.rect(), Qt::AlignCenter, "车辆检测\n(模拟数据)");
-            
-            // 绘制简单的车辆轮廓
-            painter.setPen(QPen(Qt::red, 2));
-            painter.drawRect(220, 280, 200, 100);
-            painter.drawRect(250, 230, 140, 50);
-            painter.drawEllipse(250, 380, 40, 40); // 左前轮
-            painter.drawEllipse(350, 380, 40, 40); // 右前轮
-        }
-        
-        // 更新UI
-        m_cameraLabels[i]->setPixmap(QPixmap::fromImage(image));
+    if (index < 0 || index >= m_pipelines.size())
+        return;
+    
+    CameraPipeline *pipeline = m_pipelines[index];
+    VideoTile *tile = pipeline->tile();
+    switch (state) {
+    case CameraState::Connecting:
+        tile->setPlaceholderText("连接中");
+        break;
+    case CameraState::Streaming:
+        tile->setPlaceholderText("无信号");
+        break;
+    case CameraState::Degraded:
+        tile->setPlaceholderText("重新连接中");
+        break;
+    case CameraState::Lost:
+        tile->setPlaceholderText("信号丢失");
+        tile->clearFrame();
+        break;
     }
+    
+    statusBar()->showMessage(QString("%1: %2").arg(pipeline->config().name,
+                                                   QString::fromUtf8(cameraStateName(state))), 3000);
 }
 
 /**
- * @brief 将OpenCV的Mat转换为QImage
- * @param mat OpenCV的Mat图像
- * @return 转换后的QImage
+ * @brief 窗口显示事件处理
+ * @param event 显示事件
  * 
- * 将OpenCV的Mat图像格式转换为Qt的QImage格式
+ * 在事件循环处理完本次显示（包括首次绘制）后记录时间
  */
-QImage ADASDisplay::matToQImage(const cv::Mat& mat)
+void ADASDisplay::showEvent(QShowEvent *event)
 {
-    // 检查图像是否为空
-    if (mat.empty())
-        return QImage();
-    
-    // 转换颜色空间从BGR到RGB
-    cv::Mat rgbMat;
-    cv::cvtColor(mat, rgbMat, cv::COLOR_BGR2RGB);
-    
-    // 创建QImage
-    QImage image(rgbMat.data, rgbMat.cols, rgbMat.rows, 
-                 rgbMat.step, QImage::Format_RGB888);
-    
-    // 深拷贝，确保数据不会被OpenCV释放
-    return image.copy();
+    QMainWindow::showEvent(event);
+    QTimer::singleShot(0, this, [] {
+        StartupTimeline::mark("窗口显示");
+    });
+}
+
+/**
+ * @brief 输出启动时间线报告
+ * 
+ * 所有摄像头都显示首帧或等待超时后调用，只输出一次
+ */
+void ADASDisplay::reportStartup()
+{
+    if (m_startupReported)
+        return;
+    m_startupReported = true;
+    
+    std::cout << "启动时间线（以进程启动为零点）：" << std::endl
+              << StartupTimeline::report().toStdString();
+    if (m_firstFramesPending > 0) {
+        std::cout << "仍有" << m_firstFramesPending << "个摄像头没有画面" << std::endl;
+    }
 }
 
 /**
@@ -684,34 +575,12 @@ QFrame* ADASDisplay::createStatusPanel()
     speedTitle->setAlignment(Qt::AlignCenter);
     speedTitle->setFont(QFont("Arial", 10, QFont::Bold));  // 减小字体
     
-    m_speedValue = new QLabel("0 km/h");
-    m_speedValue->setAlignment(Qt::AlignCenter);
-    m_speedValue->setFont(QFont("Arial", 14, QFont::Bold));  // 减小字体
-    
-    m_speedProgress = new QProgressBar();
-    m_speedProgress->setRange(0, 200);
-    m_speedProgress->setValue(0);
-    m_speedProgress->setFixedHeight(12);  // 减小进度条高度
-    
-    // 添加车速调整按钮到车速部分
-    QHBoxLayout *speedControlsLayout = new QHBoxLayout();
-    speedControlsLayout->setSpacing(2);  // 减小间距
-    
-    QPushButton *decreaseSpeedBtn = new QPushButton("-");
-    decreaseSpeedBtn->setFixedSize(25, 20);  // 减小按钮尺寸
-    connect(decreaseSpeedBtn, &QPushButton::clicked, this, &ADASDisplay::decreaseSpeed);
-    
-    QPushButton *increaseSpeedBtn = new QPushButton("+");
-    increaseSpeedBtn->setFixedSize(25, 20);  // 减小按钮尺寸
-    connect(increaseSpeedBtn, &QPushButton::clicked, this, &ADASDisplay::increaseSpeed);
-    
-    speedControlsLayout->addWidget(decreaseSpeedBtn);
-    speedControlsLayout->addWidget(increaseSpeedBtn);
+    // 自绘车速表取代数值标签和进度条，值变化时只重绘变化的弧段和数字
+    m_speedGauge = new SpeedGauge();
+    m_speedGauge->setFont(QFont("Arial", 9));
     
     speedLayout->addWidget(speedTitle);
-    speedLayout->addWidget(m_speedValue);
-    speedLayout->addWidget(m_speedProgress);
-    speedLayout->addLayout(speedControlsLayout);
+    speedLayout->addWidget(m_speedGauge, 1);
     
     // 合并报警状态和驾驶员信息部分
     QWidget *statusWidget = new QWidget();
@@ -754,13 +623,12 @@ QFrame* ADASDisplay::createStatusPanel()
     fatigueLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
     fatigueLabel->setFont(QFont("Arial", 10));  // 减小字体
     
-    m_driverFatigue = new QProgressBar();
-    m_driverFatigue->setRange(0, 100);
-    m_driverFatigue->setValue(20);
-    m_driverFatigue->setFixedHeight(12);  // 减小进度条高度
+    m_fatigueMeter = new FatigueMeter();
+    m_fatigueMeter->setFont(QFont("Arial", 9));
+    m_fatigueMeter->setFixedHeight(16);
     
     statusProgressLayout->addWidget(fatigueLabel, 1);
-    statusProgressLayout->addWidget(m_driverFatigue, 3);
+    statusProgressLayout->addWidget(m_fatigueMeter, 3);
     
     // 添加报警按钮到状态部分
     QHBoxLayout *alarmButtonLayout = new QHBoxLayout();
@@ -796,51 +664,60 @@ QFrame* ADASDisplay::createStatusPanel()
 }
 
 /**
- * @brief 增加车速
- * 
- * 增加车速值并更新显示
+ * @brief 启动车辆信号读取线程
+ * @param location "can:<接口名>"或candump日志文件路径
+ * @param table 信号表
+ * @param config 帧源参数
+ *
+ * 通知周期取主显示器的刷新周期，界面每个刷新周期最多更新一次车辆信号
  */
-void ADASDisplay::increaseSpeed()
+void ADASDisplay::startVehicleSignals(const QString& location, const QVector<CanSignalDef>& table,
+                                      const CanSourceConfig& config)
 {
-    // 增加车速值
-    m_currentSpeed = qMin(200.0, m_currentSpeed + 10.0);
-    m_speedValue->setText(QString("%1 km/h").arg(static_cast<int>(m_currentSpeed)));
-    m_speedProgress->setValue(static_cast<int>(m_currentSpeed));
-    statusBar()->showMessage(QString("车速增加到 %1 km/h").arg(static_cast<int>(m_currentSpeed)), 2000);
+    delete m_vehicleReader;
+    m_vehicleReader = new VehicleSignalReader(location, table, config);
+
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    if (screen && screen->refreshRate() > 1.0) {
+        m_vehicleReader->setNotifyIntervalUs(static_cast<qint64>(1000000.0 / screen->refreshRate()));
+    }
+    connect(m_vehicleReader, &VehicleSignalReader::signalsAvailable,
+            this, &ADASDisplay::onVehicleSignalsAvailable);
+    m_vehicleReader->start();
 }
 
 /**
- * @brief 减少车速
- * 
- * 减少车速值并更新显示
+ * @brief 车辆信号有新值
+ *
+ * 车速写入状态模型，显示的整数车速不变时不更新控件
  */
-void ADASDisplay::decreaseSpeed()
+void ADASDisplay::onVehicleSignalsAvailable()
 {
-    // 减少车速值
-    m_currentSpeed = qMax(0.0, m_currentSpeed - 10.0);
-    m_speedValue->setText(QString("%1 km/h").arg(static_cast<int>(m_currentSpeed)));
-    m_speedProgress->setValue(static_cast<int>(m_currentSpeed));
-    statusBar()->showMessage(QString("车速减少到 %1 km/h").arg(static_cast<int>(m_currentSpeed)), 2000);
+    if (!m_vehicleReader)
+        return;
+
+    m_vehicleSignals = m_vehicleReader->takeSnapshot();
+    if (!m_vehicleSignals.hasValue(VehicleSignal::Speed))
+        return;
+
+    m_state->setSpeed(qBound(0.0, m_vehicleSignals.value(VehicleSignal::Speed), 200.0));
 }
 
 /**
  * @brief 切换报警状态
  * 
- * 切换报警状态并更新显示
+ * 切换报警状态，控件由applyState()更新
  */
 void ADASDisplay::toggleAlarm()
 {
-    m_alarmActive = !m_alarmActive;
+    m_state->setAlarmActive(!m_state->alarmActive());
     
-    if (m_alarmActive) {
-        m_alarmStatus->setText("警报");
-        m_alarmStatus->setStyleSheet("color: red; font-weight: bold;");
-        m_alarmButton->setText("解除");
-        statusBar()->showMessage("系统报警已激活", 2000);
+    if (m_state->alarmActive()) {
+        statusBar()->showMessage("系统报警已激活，正在保存事件录像", 2000);
+        
+        // 保存报警前的缓存和报警后的画面，写盘在录像线程中进行
+        m_eventRecorder->trigger();
     } else {
-        m_alarmStatus->setText("正常");
-        m_alarmStatus->setStyleSheet("color: green; font-weight: bold;");
-        m_alarmButton->setText("报警");
         statusBar()->showMessage("系统报警已解除", 2000);
     }
 }
@@ -885,10 +762,10 @@ void ADASDisplay::showHelp()
         </ul>
         <p>操作说明：</p>
         <ul>
-            <li>使用+/-按钮调整车速</li>
             <li>点击"触发报警"按钮可手动触发/解除系统报警</li>
             <li>驾驶员疲劳度超过70%会自动触发系统报警</li>
             <li>可以拖拽摄像头窗口互换位置</li>
+            <li>按F2键显示/隐藏各画面的延迟统计</li>
         </ul>
         <p>版本：1.0.0</p>
     )";
@@ -947,3 +824,14 @@ void ADASDisplay::toggleFullScreen()
         showFullScreen();
     }
 }
+
+/**
+ * @brief 切换所有摄像头画面上的延迟统计叠加层
+ */
+void ADASDisplay::toggleLatencyOverlay()
+{
+    m_latencyOverlayVisible = !m_latencyOverlayVisible;
+    for (CameraPipeline *pipeline : m_pipelines) {
+        pipeline->tile()->setStatsOverlayVisible(m_latencyOverlayVisible);
+    }
+}
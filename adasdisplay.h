@@ -10,7 +10,6 @@
 
 #include <QMainWindow>
 #include <QLabel>
-#include <QProgressBar>
 #include <QPushButton>
 #include <QTimer>
 #include <QDateTime>
@@ -22,9 +21,9 @@
 #include <QFrame>
 #include <QWidget>
 #include <QMessageBox>
-#include <QRandomGenerator>
 #include <QImage>
 #include <QPixmap>
+#include <QPalette>
 
 // OpenCV头文件
 #include <opencv2/opencv.hpp>
@@ -32,6 +31,19 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 #include "draggablecamerapanel.h"
+#include "cameracompositor.h"
+#include "adasstate.h"
+#include "fatiguemeter.h"
+#include "speedgauge.h"
+#include "camerapipeline.h"
+#include "cameraregistry.h"
+#include "camerastate.h"
+#include "drivermonitor.h"
+#include "eventrecorder.h"
+#include "perfreport.h"
+#include "qualitygovernor.h"
+#include "vehicledetector.h"
+#include "vehiclesignalreader.h"
 
 /**
  * @class ADASDisplay
@@ -47,23 +59,63 @@ class ADASDisplay : public QMainWindow
 public:
     /**
      * @brief 构造函数
-     * @param camera0Path 摄像头0的设备路径，默认为"/dev/video0"
-     * @param camera1Path 摄像头1的设备路径，默认为"/dev/video2"
-     * @param camera2Path 摄像头2的设备路径，默认为"/dev/video4"
-     * @param camera3Path 摄像头3的设备路径，默认为"/dev/video6"
+     * @param registry 摄像头注册表，默认为/dev/video0、2、4、6四个摄像头
      * @param parent 父窗口指针，默认为nullptr
      */
-    ADASDisplay(const QString& camera0Path = "/dev/video0", 
-                const QString& camera1Path = "/dev/video2", 
-                const QString& camera2Path = "/dev/video4", 
-                const QString& camera3Path = "/dev/video6", 
-                QWidget *parent = nullptr);
+    explicit ADASDisplay(const CameraRegistry& registry = CameraRegistry::defaults(),
+                         QWidget *parent = nullptr);
     
     /**
      * @brief 析构函数
      */
     ~ADASDisplay();
     
+    /**
+     * @brief 把各摄像头的帧率、丢帧和延迟统计加入性能报告
+     * @param report 性能报告
+     */
+    void fillPerfReport(PerfReport& report) const;
+    
+    /**
+     * @brief 设置报警事件录像的保存目录
+     * @param directory 目录路径
+     */
+    void setRecordingDirectory(const QString& directory);
+    
+    /**
+     * @brief 设置是否按显示延迟自动调整摄像头画质
+     * @param enabled 是否启用，禁用时保持当前画质不再调整
+     */
+    void setQualityGovernorEnabled(bool enabled);
+    
+    /**
+     * @brief 从指定目录重新加载驾驶员监测的级联模型并重新开始监测
+     * @param directory 模型目录
+     */
+    void setDriverModelDirectory(const QString& directory);
+    
+    /**
+     * @brief 加载指定的车辆检测模型并重新开始检测
+     * @param path 模型文件路径（ONNX）
+     */
+    void setVehicleModel(const QString& path);
+    
+    /**
+     * @brief 设置车辆检测推理可以使用的CPU预算
+     * @param cores 核数，采样频率随之调整
+     */
+    void setDetectorCpuBudget(double cores);
+    
+    /**
+     * @brief 启动车辆信号读取线程，未调用时车速保持为0
+     * @param location "can:<接口名>"（如can:vcan0）或candump日志文件路径
+     * @param table 信号表
+     * @param config 帧源参数
+     */
+    void startVehicleSignals(const QString& location,
+                             const QVector<CanSignalDef>& table = CanSignalDecoder::defaultTable(),
+                             const CanSourceConfig& config = CanSourceConfig());
+    
 public slots:
     /**
      * @brief 交换两个摄像头的位置（已禁用）
@@ -74,24 +126,26 @@ public slots:
     
 private slots:
     /**
-     * @brief 更新显示数据，包括车速、驾驶员疲劳度等
+     * @brief 更新日期时间显示
      */
-    void updateData();
+    void updateDateTime();
     
     /**
-     * @brief 更新日期时间显示
+     * @brief 车辆信号有新值，更新车速显示
      */
-    void updateDateTime();
+    void onVehicleSignalsAvailable();
     
     /**
-     * @brief 增加车速
+     * @brief 驾驶员监测给出新的估计，更新疲劳度，疲劳时自动报警
+     * @param estimate 估计结果
      */
-    void increaseSpeed();
+    void onDriverEstimate(const DriverEstimate& estimate);
     
     /**
-     * @brief 减少车速
+     * @brief 按变化的字段更新状态面板控件
+     * @param fields 变化的字段
      */
-    void decreaseSpeed();
+    void applyState(ADASState::Fields fields);
     
     /**
      * @brief 切换警报状态
@@ -109,21 +163,39 @@ private slots:
     void showHelp();
     
     /**
-     * @brief 更新摄像头画面
+     * @brief 切换全屏模式
      */
-    void updateCameraFeeds();
+    void toggleFullScreen();
     
     /**
-     * @brief 切换全屏模式
+     * @brief 切换所有摄像头画面上的延迟统计叠加层
      */
-    void toggleFullScreen();
+    void toggleLatencyOverlay();
     
     /**
-     * @brief 模拟其他摄像头画面
-     * 
-     * 生成模拟的摄像头画面用于演示
+     * @brief 摄像头连接状态变化时更新画面提示和状态栏
+     * @param index 摄像头索引
+     * @param state 新状态
      */
-    void simulateOtherCameras();
+    void onCameraStateChanged(int index, CameraState state);
+    
+    /**
+     * @brief 摄像头有新帧时取走最新帧并交给画面块
+     * @param index 摄像头索引
+     */
+    void onFrameAvailable(int index);
+    
+    /**
+     * @brief 输出启动时间线报告（只输出一次）
+     */
+    void reportStartup();
+    
+protected:
+    /**
+     * @brief 窗口显示事件处理，记录窗口显示时间
+     * @param event 显示事件
+     */
+    void showEvent(QShowEvent *event) override;
     
 private:
     /**
@@ -154,11 +226,9 @@ private:
     void closeCameras();
     
     /**
-     * @brief 将OpenCV的Mat转换为QImage
-     * @param mat OpenCV的Mat图像
-     * @return 转换后的QImage
+     * @brief 输出各摄像头的延迟统计
      */
-    QImage matToQImage(const cv::Mat& mat);
+    void reportLatency();
     
     /**
      * @brief 创建应用程序图标
@@ -171,44 +241,38 @@ private:
     QVector<DraggableCameraPanel*> m_cameras; ///< 其他摄像头面板集合（旧的，保留以避免大量修改）
     
     // 新的摄像头UI组件
-    QVector<QLabel*> m_cameraLabels;          ///< 摄像头画面标签集合
-    QLabel *m_driverFeed;                     ///< 驾驶员摄像头画面标签
+    CameraCompositor *m_compositor;           ///< 摄像头画面合成器，网格画面块与注册表一一对应
     
     // 状态面板组件
     QFrame *m_statusPanel;           ///< 状态面板框架
-    QLabel *m_speedValue;            ///< 车速值标签
-    QProgressBar *m_speedProgress;   ///< 车速进度条
+    SpeedGauge *m_speedGauge;        ///< 车速表
     QLabel *m_alarmStatus;           ///< 警报状态标签
     QPushButton *m_alarmButton;      ///< 警报按钮
     QLabel *m_driverStatus;          ///< 驾驶员状态标签
-    QProgressBar *m_driverFatigue;   ///< 驾驶员疲劳度进度条
+    FatigueMeter *m_fatigueMeter;    ///< 驾驶员疲劳度表
     QLabel *m_datetimeLabel;         ///< 日期时间标签
     
     // 计时器
-    QTimer *m_dataTimer;             ///< 数据更新定时器
     QTimer *m_datetimeTimer;         ///< 日期时间更新定时器
-    QTimer *m_cameraTimer;           ///< 摄像头更新定时器
     
     // 数据值
-    double m_currentSpeed;           ///< 当前车速
-    bool m_alarmActive;              ///< 警报激活状态
-    int m_fatigueLevel;              ///< 疲劳度级别
-    
-    // OpenCV摄像头
-    cv::VideoCapture m_camera0;      ///< 摄像头0 (/dev/video0)
-    cv::VideoCapture m_camera1;      ///< 摄像头1 (/dev/video2)
-    cv::VideoCapture m_camera2;      ///< 摄像头2 (/dev/video4)
-    cv::VideoCapture m_camera3;      ///< 摄像头3 (/dev/video6)
-    // 摄像头状态
-    bool m_camera0Active;            ///< 摄像头0是否激活
-    bool m_camera1Active;            ///< 摄像头1是否激活
-    bool m_camera2Active;            ///< 摄像头2是否激活
-    bool m_camera3Active;            ///< 摄像头3是否激活
-    // 摄像头设备路径
-    QString m_camera0Path;           ///< 摄像头0的设备路径
-    QString m_camera1Path;           ///< 摄像头1的设备路径
-    QString m_camera2Path;           ///< 摄像头2的设备路径
-    QString m_camera3Path;           ///< 摄像头3的设备路径
+    ADASState *m_state;              ///< 状态面板数据模型，车速来自CAN总线，疲劳度来自驾驶员监测
+    const QPalette m_okPalette;      ///< 正常状态的文字调色板
+    const QPalette m_warningPalette; ///< 注意状态的文字调色板
+    const QPalette m_dangerPalette;  ///< 警告状态的文字调色板
+    
+    // 摄像头配置与流水线，前count()个索引与合成器的网格画面块一致
+    CameraRegistry m_registry;               ///< 摄像头注册表
+    QVector<CameraPipeline*> m_pipelines;    ///< 摄像头流水线集合，最后一个为驾驶员摄像头
+    int m_firstFramesPending;                ///< 尚未显示首帧的摄像头数量
+    bool m_startupReported;                  ///< 是否已输出启动报告
+    bool m_latencyOverlayVisible;            ///< 是否叠加显示延迟统计
+    EventRecorder *m_eventRecorder;          ///< 报警事件录像器，缓存各摄像头的MJPEG帧
+    VehicleSignalReader *m_vehicleReader;    ///< 车辆信号读取线程，未配置CAN帧源时为nullptr
+    VehicleSignalSnapshot m_vehicleSignals;  ///< 最近一次取走的车辆信号
+    QualityGovernor *m_governor;             ///< 自适应画质调节器，驾驶员摄像头不参与降级
+    DriverMonitor *m_driverMonitor;          ///< 驾驶员疲劳监测线程，分析驾驶员摄像头的画面
+    VehicleDetector *m_vehicleDetector;      ///< 车辆/行人检测线程，批量分析网格摄像头的画面
 };
 
 #endif // ADASDISPLAY_H
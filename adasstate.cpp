@@ -0,0 +1,116 @@
+/**
+ * @file adasstate.cpp
+ * @brief 状态面板数据模型的实现文件
+ */
+#include "adasstate.h"
+
+#include <QMetaObject>
+
+#include <cmath>
+
+namespace {
+
+// 疲劳度超过该值视为疲劳
+constexpr int kFatiguedLevel = 70;
+
+// 疲劳度超过该值视为轻度疲劳
+constexpr int kTiredLevel = 50;
+
+} // namespace
+
+/**
+ * @brief ADASState类的构造函数
+ * @param parent 父对象指针
+ */
+ADASState::ADASState(QObject *parent)
+    : QObject(parent)
+    , m_speed(0)
+    , m_alarmActive(false)
+    , m_fatigueLevel(20)
+    , m_driverCondition(DriverCondition::Alert)
+    , m_writes(0)
+    , m_changes(0)
+    , m_notifications(0)
+{
+}
+
+/**
+ * @brief 设置车速
+ * @param speed 车速（km/h）
+ */
+void ADASState::setSpeed(double speed)
+{
+    ++m_writes;
+    const int value = static_cast<int>(std::floor(qMax(0.0, speed)));
+    if (value == m_speed)
+        return;
+    m_speed = value;
+    markDirty(SpeedField);
+}
+
+/**
+ * @brief 设置报警状态
+ * @param active 是否激活
+ */
+void ADASState::setAlarmActive(bool active)
+{
+    ++m_writes;
+    if (active == m_alarmActive)
+        return;
+    m_alarmActive = active;
+    markDirty(AlarmField);
+}
+
+/**
+ * @brief 设置疲劳度
+ * @param level 疲劳度
+ */
+void ADASState::setFatigueLevel(int level)
+{
+    ++m_writes;
+    level = qBound(0, level, 100);
+    if (level == m_fatigueLevel)
+        return;
+    m_fatigueLevel = level;
+    markDirty(FatigueField);
+
+    DriverCondition condition = DriverCondition::Alert;
+    if (level > kFatiguedLevel) {
+        condition = DriverCondition::Fatigued;
+    } else if (level > kTiredLevel) {
+        condition = DriverCondition::Tired;
+    }
+    if (condition != m_driverCondition) {
+        m_driverCondition = condition;
+        markDirty(DriverConditionField);
+    }
+}
+
+/**
+ * @brief 记录一个字段的变化
+ * @param field 变化的字段
+ *
+ * 第一个变化到来时排队一次flush()，之后的变化只合并到m_dirty中
+ */
+void ADASState::markDirty(Field field)
+{
+    ++m_changes;
+    const bool scheduled = !!m_dirty;
+    m_dirty |= field;
+    if (!scheduled) {
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief 发出合并后的变化通知
+ */
+void ADASState::flush()
+{
+    const Fields fields = m_dirty;
+    m_dirty = Fields();
+    if (!fields)
+        return;
+    ++m_notifications;
+    emit changed(fields);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file adasstate.h
+ * @brief 状态面板数据模型的头文件
+ *
+ * 该文件定义了ADASState类，保存状态面板显示的车速、报警和驾驶员状态，
+ * 只有值真正变化时才通知界面更新对应的控件。
+ */
+#ifndef ADASSTATE_H
+#define ADASSTATE_H
+
+#include <QObject>
+
+/**
+ * @class ADASState
+ * @brief 状态面板数据模型
+ *
+ * 每个属性的setter先与当前值比较，相同时直接返回；不同时记录变化的字段。
+ * 同一轮事件循环中的所有变化合并为一次changed()，在回到事件循环后发出，
+ * 界面据此只更新变化字段对应的控件。仅在界面线程中使用
+ */
+class ADASState : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 状态字段
+     */
+    enum Field {
+        SpeedField = 0x1,               ///< 车速
+        AlarmField = 0x2,               ///< 报警状态
+        FatigueField = 0x4,             ///< 疲劳度
+        DriverConditionField = 0x8,     ///< 驾驶员状态
+        AllFields = 0xF                 ///< 所有字段
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    /**
+     * @brief 驾驶员状态，由疲劳度决定
+     */
+    enum class DriverCondition {
+        Alert,      ///< 状态良好
+        Tired,      ///< 轻度疲劳
+        Fatigued    ///< 疲劳
+    };
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit ADASState(QObject *parent = nullptr);
+
+    /**
+     * @brief 获取车速
+     * @return 车速（km/h，按显示精度取整）
+     */
+    int speed() const { return m_speed; }
+
+    /**
+     * @brief 设置车速
+     * @param speed 车速（km/h），按显示精度取整后比较，小数部分的变化不触发更新
+     */
+    void setSpeed(double speed);
+
+    /**
+     * @brief 报警是否激活
+     * @return 是否激活
+     */
+    bool alarmActive() const { return m_alarmActive; }
+
+    /**
+     * @brief 设置报警状态
+     * @param active 是否激活
+     */
+    void setAlarmActive(bool active);
+
+    /**
+     * @brief 获取疲劳度
+     * @return 疲劳度（0~100）
+     */
+    int fatigueLevel() const { return m_fatigueLevel; }
+
+    /**
+     * @brief 设置疲劳度，同时更新驾驶员状态
+     * @param level 疲劳度（0~100）
+     */
+    void setFatigueLevel(int level);
+
+    /**
+     * @brief 获取驾驶员状态
+     * @return 驾驶员状态
+     */
+    DriverCondition driverCondition() const { return m_driverCondition; }
+
+    /**
+     * @brief 获取setter的调用次数
+     * @return 调用次数
+     */
+    quint64 writes() const { return m_writes; }
+
+    /**
+     * @brief 获取字段实际变化的次数
+     * @return 次数，一次setter可能改变多个字段
+     */
+    quint64 changes() const { return m_changes; }
+
+    /**
+     * @brief 获取发出changed()的次数
+     * @return 次数
+     */
+    quint64 notifications() const { return m_notifications; }
+
+signals:
+    /**
+     * @brief 状态发生变化
+     * @param fields 自上一次通知以来变化的字段
+     */
+    void changed(ADASState::Fields fields);
+
+private slots:
+    /**
+     * @brief 发出合并后的变化通知
+     */
+    void flush();
+
+private:
+    /**
+     * @brief 记录一个字段的变化，必要时安排通知
+     * @param field 变化的字段
+     */
+    void markDirty(Field field);
+
+    int m_speed;                        ///< 车速（km/h）
+    bool m_alarmActive;                 ///< 报警状态
+    int m_fatigueLevel;                 ///< 疲劳度
+    DriverCondition m_driverCondition;  ///< 驾驶员状态
+    Fields m_dirty;                     ///< 尚未通知的变化字段
+    quint64 m_writes;                   ///< setter调用次数
+    quint64 m_changes;                  ///< 实际变化次数
+    quint64 m_notifications;            ///< 通知次数
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ADASState::Fields)
+
+#endif // ADASSTATE_H
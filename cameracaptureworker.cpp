@@ -0,0 +1,479 @@
+/**
+ * @file cameracaptureworker.cpp
+ * @brief 摄像头采集线程的实现文件
+ */
+#include "cameracaptureworker.h"
+#include "eventrecorder.h"
+#include "frameanalyzer.h"
+#include "framecopycounter.h"
+#include "frametiming.h"
+#include "mjpegdecoder.h"
+#include "stageprofiler.h"
+#include "startuptimeline.h"
+#include "workerpool.h"
+
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <iostream>
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// 单次取帧的最长等待时间，保证停止请求能及时得到响应
+constexpr int kGrabTimeoutMs = 200;
+
+// 超过该时间没有新帧视为信号不稳定
+constexpr qint64 kDegradedAfterUs = 1000000;
+
+// 超过该时间没有新帧时主动关闭设备重连，部分驱动停止出帧时不会报错
+constexpr qint64 kStallReconnectAfterUs = 5000000;
+
+// 连续重连失败达到该次数后视为信号丢失
+constexpr int kLostAfterAttempts = 5;
+
+// 降低采集分辨率时的最小尺寸
+constexpr int kMinCaptureWidth = 160;
+constexpr int kMinCaptureHeight = 90;
+
+/**
+ * @brief 缓冲区仍被界面线程借用时改用新缓冲区，避免覆盖正在显示的数据
+ * @param image 即将被写入的图像
+ *
+ * 引用计数由其他线程原子地增减，这里同样用原子操作读取（加0），避免数据竞争
+ */
+void detachIfBorrowed(cv::Mat& image)
+{
+    if (image.u && CV_XADD(&image.u->refcount, 0) > 1) {
+        image.release();
+        FrameCopyCounter::recordAllocation();
+    }
+}
+
+/**
+ * @brief 把原始数据解码为BGR图像
+ * @param frame 含原始数据的帧
+ * @param targetSize 显示目标尺寸
+ * @param out 输出图像
+ * @return 是否解码成功
+ */
+bool decodeRaw(const CameraFrame& frame, const QSize& targetSize, cv::Mat& out)
+{
+    // 每个线程池线程复用自己的解码上下文
+    thread_local MjpegDecoder decoder;
+
+    try {
+        if (frame.rawFormat == FOURCC_MJPG) {
+            return decoder.decode(frame.raw.data, frame.raw.total() * frame.raw.elemSize(),
+                                  cv::Size(targetSize.width(), targetSize.height()), out);
+        }
+        if (frame.rawFormat == FOURCC_YUYV) {
+            cv::cvtColor(frame.raw, out, cv::COLOR_YUV2BGR_YUYV);
+            return !out.empty();
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "解码异常: " << e.what() << std::endl;
+    }
+    return false;
+}
+
+} // namespace
+
+/**
+ * @class FrameDecodeTask
+ * @brief 在共享线程池中运行的解码任务
+ */
+class FrameDecodeTask : public QRunnable
+{
+public:
+    explicit FrameDecodeTask(CameraCaptureWorker *worker)
+        : m_worker(worker)
+    {
+    }
+
+    void run() override
+    {
+        m_worker->runDecodeLoop();
+    }
+
+private:
+    CameraCaptureWorker *m_worker;
+};
+
+/**
+ * @brief CameraCaptureWorker类的构造函数
+ * @param index 摄像头索引
+ * @param devicePath 摄像头设备路径或录像文件路径
+ * @param config 采集参数
+ * @param parent 父对象指针
+ */
+CameraCaptureWorker::CameraCaptureWorker(int index, const QString& devicePath,
+                                         const FrameSourceConfig& config, QObject *parent)
+    : QThread(parent)
+    , m_index(index)
+    , m_devicePath(devicePath)
+    , m_config(config)
+    , m_source(createFrameSource(devicePath, config))
+    , m_recorder(nullptr)
+    , m_active(false)
+    , m_state(static_cast<int>(CameraState::Connecting))
+    , m_lastFrameUs(0)
+    , m_sequence(1)
+    , m_firstFrameMarked(false)
+    , m_notifyPending(false)
+    , m_frameDivisor(1)
+    , m_captureDivisor(1)
+    , m_appliedCaptureDivisor(1)
+    , m_frameCounter(0)
+    , m_skippedFrames(0)
+    , m_decodeBusy(false)
+    , m_decodeStopping(false)
+{
+    qRegisterMetaType<CameraState>("CameraState");
+}
+
+/**
+ * @brief CameraCaptureWorker类的析构函数
+ */
+CameraCaptureWorker::~CameraCaptureWorker()
+{
+    stop();
+}
+
+/**
+ * @brief 首次打开并配置摄像头设备
+ * @return 是否打开成功
+ *
+ * 在采集线程中执行，打开失败时由run()转入后台重连
+ */
+bool CameraCaptureWorker::openDevice()
+{
+    if (!m_source->isPresent()) {
+        m_active = false;
+        std::cout << "摄像头" << m_index << "设备不存在，稍后重试" << std::endl;
+        return false;
+    }
+
+    m_active = m_source->open();
+    if (m_active) {
+        m_lastFrameUs = monotonicNowUs();
+        StartupTimeline::mark(QString("摄像头%1设备打开").arg(m_index));
+        std::cout << "摄像头" << m_index << "初始化成功" << std::endl;
+    } else {
+        std::cout << "摄像头" << m_index << "打开失败" << std::endl;
+    }
+    return m_active;
+}
+
+/**
+ * @brief 停止采集线程并释放摄像头
+ *
+ * 取帧最多阻塞kGrabTimeoutMs，因此停止请求能很快得到响应；
+ * 还会等待正在运行的解码任务结束，之后不再访问信箱
+ */
+void CameraCaptureWorker::stop()
+{
+    requestInterruption();
+    wait();
+    waitForDecodeIdle();
+
+    m_grabFrame.releaseRaw();
+    m_source->close();
+    m_active = false;
+}
+
+/**
+ * @brief 设置显示目标尺寸
+ * @param size 目标尺寸（设备像素）
+ */
+void CameraCaptureWorker::setTargetSize(const QSize& size)
+{
+    QMutexLocker locker(&m_decodeMutex);
+    m_targetSize = size;
+}
+
+/**
+ * @brief 取走最新一帧
+ * @return 有新帧时返回帧指针，否则返回nullptr
+ */
+const CameraFrame* CameraCaptureWorker::takeLatestFrame()
+{
+    // 先清除标志再取帧，取帧之后发布的帧一定会再次通知
+    m_notifyPending.store(false, std::memory_order_release);
+    if (!m_mailbox.fetch())
+        return nullptr;
+    return &m_mailbox.readSlot();
+}
+
+/**
+ * @brief 采集循环
+ *
+ * 压缩帧交给解码任务；帧源已解码的帧直接发布到信箱，界面线程来不及取走的旧帧直接被覆盖
+ */
+void CameraCaptureWorker::run()
+{
+    {
+        QMutexLocker locker(&m_decodeMutex);
+        m_decodeStopping = false;
+    }
+
+    // 设备在采集线程中打开，各摄像头互不等待
+    if (!m_active && !openDevice()) {
+        sleepInterruptible(m_backoff.nextDelayMs());
+    }
+
+    while (!isInterruptionRequested()) {
+        const int captureDivisor = m_captureDivisor.load(std::memory_order_relaxed);
+        if (captureDivisor != m_appliedCaptureDivisor) {
+            applyCaptureDivisor(captureDivisor);
+        }
+        if (!m_active && !reconnect())
+            continue;
+
+        detachIfBorrowed(m_grabFrame.image);
+        FrameSource::GrabResult result;
+        {
+            StageProfiler::Scope profile(StageProfiler::Stage::Capture);
+            result = m_source->grab(m_grabFrame, kGrabTimeoutMs);
+        }
+        if (result == FrameSource::GrabResult::Timeout) {
+            const qint64 stalledUs = monotonicNowUs() - m_lastFrameUs;
+            if (stalledUs > kStallReconnectAfterUs) {
+                std::cerr << "摄像头" << m_index << "长时间无帧，重新连接" << std::endl;
+                dropSource();
+            } else if (stalledUs > kDegradedAfterUs && state() == CameraState::Streaming) {
+                setState(CameraState::Degraded);
+            }
+            continue;
+        }
+
+        if (result == FrameSource::GrabResult::Error) {
+            std::cerr << "摄像头" << m_index << "读取失败" << std::endl;
+            dropSource();
+            continue;
+        }
+
+        m_lastFrameUs = monotonicNowUs();
+        m_backoff.reset();
+        setState(CameraState::Streaming);
+        if (!m_firstFrameMarked) {
+            m_firstFrameMarked = true;
+            StartupTimeline::mark(QString("摄像头%1首帧采集").arg(m_index));
+        }
+
+        m_grabFrame.captureTimeUs = monotonicNowUs();
+
+        // 压缩数据原样进入录像缓存，在交给解码任务之前拷贝；降低帧率时录像仍为全帧率
+        if (!m_grabFrame.raw.empty() && m_recorder) {
+            m_recorder->record(m_index, m_grabFrame);
+        }
+
+        const int frameDivisor = m_frameDivisor.load(std::memory_order_relaxed);
+        if (frameDivisor > 1 && ++m_frameCounter % static_cast<quint64>(frameDivisor) != 0) {
+            m_grabFrame.releaseRaw();
+            m_skippedFrames.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        m_grabFrame.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+
+        if (!m_grabFrame.raw.empty()) {
+            submitDecode(m_grabFrame);
+        } else if (!m_grabFrame.image.empty()) {
+            // 帧源已解码，交换缓冲区后直接发布
+            m_grabFrame.decodeTimeUs = m_grabFrame.captureTimeUs;
+            std::swap(m_mailbox.writeSlot(), m_grabFrame);
+            publishFrame();
+        }
+    }
+}
+
+/**
+ * @brief 把压缩帧交给解码任务
+ * @param frame 采集到的帧
+ *
+ * 被替换的旧压缩帧随之释放，其驱动缓冲区立即归还
+ */
+void CameraCaptureWorker::submitDecode(CameraFrame& frame)
+{
+    bool startTask = false;
+    {
+        QMutexLocker locker(&m_decodeMutex);
+        m_pendingDecode.raw = frame.raw;
+        m_pendingDecode.rawFormat = frame.rawFormat;
+        m_pendingDecode.buffer = std::move(frame.buffer);
+        m_pendingDecode.sequence = frame.sequence;
+        m_pendingDecode.captureTimeUs = frame.captureTimeUs;
+        m_pendingDecode.deviceTimestampUs = frame.deviceTimestampUs;
+        startTask = !m_decodeBusy;
+        m_decodeBusy = true;
+    }
+    frame.releaseRaw();
+
+    if (startTask) {
+        frameWorkerPool()->start(new FrameDecodeTask(this));
+    }
+}
+
+/**
+ * @brief 在线程池中循环解码待处理帧
+ *
+ * 同一摄像头同时只有一个解码任务，因此它是信箱唯一的生产者
+ */
+void CameraCaptureWorker::runDecodeLoop()
+{
+    for (;;) {
+        CameraFrame frame;
+        QSize targetSize;
+        {
+            QMutexLocker locker(&m_decodeMutex);
+            if (m_decodeStopping || m_pendingDecode.raw.empty()) {
+                m_pendingDecode.releaseRaw();
+                m_decodeBusy = false;
+                m_decodeIdle.wakeAll();
+                return;
+            }
+            std::swap(frame, m_pendingDecode);
+            targetSize = m_targetSize;
+        }
+
+        CameraFrame& slot = m_mailbox.writeSlot();
+        detachIfBorrowed(slot.image);
+        bool decoded = false;
+        {
+            StageProfiler::Scope profile(StageProfiler::Stage::Decode);
+            decoded = decodeRaw(frame, targetSize, slot.image);
+        }
+        // 解码完成后立即归还驱动缓冲区
+        frame.releaseRaw();
+
+        if (decoded) {
+            slot.sequence = frame.sequence;
+            slot.captureTimeUs = frame.captureTimeUs;
+            slot.deviceTimestampUs = frame.deviceTimestampUs;
+            slot.decodeTimeUs = monotonicNowUs();
+            publishFrame();
+        }
+    }
+}
+
+/**
+ * @brief 发布信箱中的新帧
+ *
+ * 界面线程取帧之前最多只有一个通知在事件队列中，帧率再高也不会堆积事件
+ */
+void CameraCaptureWorker::publishFrame()
+{
+    // 分析器在发布前取走自己的缩小副本，不借用信箱中的图像
+    for (FrameAnalyzer *analyzer : m_analyzers) {
+        analyzer->submit(m_mailbox.writeSlot());
+    }
+    m_mailbox.publish();
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        emit frameAvailable(m_index);
+    }
+}
+
+/**
+ * @brief 等待正在运行的解码任务结束
+ */
+void CameraCaptureWorker::waitForDecodeIdle()
+{
+    QMutexLocker locker(&m_decodeMutex);
+    m_decodeStopping = true;
+    m_pendingDecode.releaseRaw();
+    while (m_decodeBusy) {
+        m_decodeIdle.wait(&m_decodeMutex);
+    }
+}
+
+/**
+ * @brief 尝试重新打开摄像头
+ * @return 是否打开成功
+ *
+ * 在采集线程中执行，失败后按指数退避加随机抖动等待，等待期间可被停止请求打断。
+ * 退避次数在收到第一帧后才清零，因此反复掉线的摄像头也会逐渐放慢重连；
+ * 只在状态变化时输出日志，避免频繁掉线的摄像头刷屏
+ */
+bool CameraCaptureWorker::reconnect()
+{
+    if (m_source->isPresent() && m_source->open()) {
+        m_active = true;
+        m_lastFrameUs = monotonicNowUs();
+        StartupTimeline::mark(QString("摄像头%1设备打开").arg(m_index));
+        std::cout << "摄像头" << m_index << "重新初始化成功" << std::endl;
+        return true;
+    }
+
+    const int delayMs = m_backoff.nextDelayMs();
+    if (m_backoff.attempts() >= kLostAfterAttempts && state() != CameraState::Lost) {
+        std::cout << "摄像头" << m_index << "多次重连失败，继续在后台重试" << std::endl;
+        setState(CameraState::Lost);
+    }
+    sleepInterruptible(delayMs);
+    return false;
+}
+
+/**
+ * @brief 关闭帧源并等待退避时间，随后由run()重连
+ */
+void CameraCaptureWorker::dropSource()
+{
+    m_grabFrame.releaseRaw();
+    m_source->close();
+    m_active = false;
+    if (state() == CameraState::Streaming)
+        setState(CameraState::Degraded);
+    sleepInterruptible(m_backoff.nextDelayMs());
+}
+
+/**
+ * @brief 按新的采集分辨率倍数重建帧源
+ * @param divisor 倍数
+ *
+ * 已交出的帧仍持有旧帧源的缓冲区，可以安全地销毁旧帧源
+ */
+void CameraCaptureWorker::applyCaptureDivisor(int divisor)
+{
+    m_appliedCaptureDivisor = divisor;
+    // 回放重新打开会回到起始位置，不调整
+    if (m_source->isReplay())
+        return;
+
+    FrameSourceConfig config = m_config;
+    config.width = qMax(kMinCaptureWidth, m_config.width / divisor) & ~1;
+    config.height = qMax(kMinCaptureHeight, m_config.height / divisor) & ~1;
+
+    m_grabFrame.releaseRaw();
+    m_source->close();
+    m_source = createFrameSource(m_devicePath, config);
+    m_active = false;
+    std::cout << "摄像头" << m_index << "采集分辨率调整为" << config.width << "x" << config.height << std::endl;
+}
+
+/**
+ * @brief 更新连接状态
+ * @param state 新状态
+ */
+void CameraCaptureWorker::setState(CameraState state)
+{
+    const int previous = m_state.exchange(static_cast<int>(state), std::memory_order_relaxed);
+    if (previous != static_cast<int>(state)) {
+        emit stateChanged(m_index, state);
+    }
+}
+
+/**
+ * @brief 可被停止请求打断的等待
+ * @param ms 等待时间（毫秒）
+ */
+void CameraCaptureWorker::sleepInterruptible(int ms)
+{
+    constexpr int kSliceMs = 50;
+    while (ms > 0 && !isInterruptionRequested()) {
+        const int slice = qMin(ms, kSliceMs);
+        msleep(static_cast<unsigned long>(slice));
+        ms -= slice;
+    }
+}
@@ -0,0 +1,246 @@
+/**
+ * @file cameracaptureworker.h
+ * @brief 摄像头采集线程的头文件
+ *
+ * 该文件定义了CameraCaptureWorker类，每个摄像头在独立线程中从帧源取帧，
+ * 并把最新一帧发布到无锁信箱中，界面线程只负责取走最新帧。
+ */
+#ifndef CAMERACAPTUREWORKER_H
+#define CAMERACAPTUREWORKER_H
+
+#include <QThread>
+#include <QString>
+#include <QSize>
+#include <QMutex>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <memory>
+
+#include "cameraframe.h"
+#include "camerastate.h"
+#include "framemailbox.h"
+#include "framesource.h"
+#include "reconnectbackoff.h"
+
+class EventRecorder;
+class FrameAnalyzer;
+
+/**
+ * @class CameraCaptureWorker
+ * @brief 单个摄像头的采集线程
+ *
+ * 拥有一个FrameSource，设备的打开和配置也在采集线程中进行，多个摄像头并行打开，
+ * 不会阻塞界面显示。在run()中循环取帧。帧源给出的压缩数据交给共享线程池解码，
+ * 每个摄像头同时最多一个解码任务，解码来不及时只保留最新的压缩帧；
+ * 解码结果发布到FrameMailbox，并通过frameAvailable()通知界面线程，在界面线程取走之前不重复通知。
+ * 取帧失败或长时间无帧时在采集线程内部按指数退避重连，
+ * 状态变化通过stateChanged()排队通知界面线程，界面线程从不等待设备。
+ */
+class CameraCaptureWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param index 摄像头索引
+     * @param devicePath 摄像头设备路径或录像文件路径
+     * @param config 采集参数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    CameraCaptureWorker(int index, const QString& devicePath,
+                        const FrameSourceConfig& config = FrameSourceConfig(), QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，停止线程并释放摄像头
+     */
+    ~CameraCaptureWorker() override;
+
+    /**
+     * @brief 停止采集线程并释放摄像头
+     */
+    void stop();
+
+    /**
+     * @brief 取走最新一帧（仅界面线程调用）
+     * @return 有新帧时返回帧指针，否则返回nullptr；指针在下一次调用前有效
+     *
+     * 调用后再发布的帧会重新触发frameAvailable()
+     */
+    const CameraFrame* takeLatestFrame();
+
+    /**
+     * @brief 设置显示目标尺寸，解码时据此选择DCT缩放比例（线程安全）
+     * @param size 目标尺寸（设备像素）
+     */
+    void setTargetSize(const QSize& size);
+
+    /**
+     * @brief 设置事件录像器，采集到的MJPEG帧会交给它缓存（须在start()之前调用）
+     * @param recorder 事件录像器，生命周期须长于采集线程，可为nullptr
+     */
+    void setEventRecorder(EventRecorder *recorder) { m_recorder = recorder; }
+
+    /**
+     * @brief 添加帧分析器，每个解码后的帧都会提交给它（须在start()之前调用）
+     * @param analyzer 帧分析器，生命周期须长于采集线程
+     */
+    void addFrameAnalyzer(FrameAnalyzer *analyzer) { m_analyzers.append(analyzer); }
+
+    /**
+     * @brief 设置帧率降低倍数，每divisor帧只解码和显示一帧（线程安全）
+     * @param divisor 倍数，1表示不降低
+     *
+     * 跳过的帧不分配序号，不计为丢帧，仍然进入事件录像
+     */
+    void setFrameDivisor(int divisor) { m_frameDivisor.store(qMax(1, divisor), std::memory_order_relaxed); }
+
+    /**
+     * @brief 设置采集分辨率降低倍数（线程安全）
+     * @param divisor 倍数，1表示使用配置的分辨率
+     *
+     * 采集线程在下一次取帧前按新分辨率重新打开设备；录像回放不支持，忽略该设置
+     */
+    void setCaptureDivisor(int divisor) { m_captureDivisor.store(qMax(1, divisor), std::memory_order_relaxed); }
+
+    /**
+     * @brief 摄像头是否处于激活状态
+     * @return 是否激活
+     */
+    bool isActive() const { return m_active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取当前连接状态（线程安全）
+     * @return 连接状态
+     */
+    CameraState state() const { return static_cast<CameraState>(m_state.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief 获取摄像头索引
+     * @return 摄像头索引
+     */
+    int index() const { return m_index; }
+
+    /**
+     * @brief 获取已采集的帧数（线程安全）
+     * @return 帧数，包括未显示就被覆盖的帧
+     */
+    quint64 capturedFrames() const
+    {
+        return m_sequence.load(std::memory_order_relaxed) - 1 + m_skippedFrames.load(std::memory_order_relaxed);
+    }
+
+signals:
+    /**
+     * @brief 连接状态发生变化（在采集线程中发出，连接到界面对象时自动排队）
+     * @param index 摄像头索引
+     * @param state 新状态
+     */
+    void stateChanged(int index, CameraState state);
+
+    /**
+     * @brief 信箱中有新帧（在采集线程或线程池中发出，连接到界面对象时自动排队）
+     * @param index 摄像头索引
+     *
+     * 界面线程调用takeLatestFrame()之前，后续的新帧只覆盖信箱，不再发出该信号
+     */
+    void frameAvailable(int index);
+
+protected:
+    /**
+     * @brief 采集循环
+     */
+    void run() override;
+
+private:
+    friend class FrameDecodeTask;
+
+    /**
+     * @brief 首次打开并配置摄像头设备（在采集线程中调用）
+     * @return 是否打开成功
+     */
+    bool openDevice();
+
+    /**
+     * @brief 把压缩帧交给解码任务，已有待解码帧时替换之（仅采集线程调用）
+     * @param frame 采集到的帧，其原始数据被移走
+     */
+    void submitDecode(CameraFrame& frame);
+
+    /**
+     * @brief 在线程池中循环解码待处理帧，直到没有新帧
+     */
+    void runDecodeLoop();
+
+    /**
+     * @brief 等待正在运行的解码任务结束
+     */
+    void waitForDecodeIdle();
+
+    /**
+     * @brief 尝试重新打开摄像头，失败时按退避时间等待
+     * @return 是否打开成功
+     */
+    bool reconnect();
+
+    /**
+     * @brief 关闭帧源并等待退避时间，随后由run()重连
+     */
+    void dropSource();
+
+    /**
+     * @brief 按新的采集分辨率倍数重建帧源，随后由run()重新打开
+     * @param divisor 倍数
+     */
+    void applyCaptureDivisor(int divisor);
+
+    /**
+     * @brief 发布信箱中的新帧，尚未通知界面线程时发出frameAvailable()
+     */
+    void publishFrame();
+
+    /**
+     * @brief 更新连接状态，状态变化时发出stateChanged()
+     * @param state 新状态
+     */
+    void setState(CameraState state);
+
+    /**
+     * @brief 可被停止请求打断的等待
+     * @param ms 等待时间（毫秒）
+     */
+    void sleepInterruptible(int ms);
+
+    int m_index;                            ///< 摄像头索引
+    QString m_devicePath;                   ///< 摄像头设备路径
+    FrameSourceConfig m_config;             ///< 配置的采集参数
+    std::unique_ptr<FrameSource> m_source;  ///< 帧源（仅采集线程访问）
+    EventRecorder *m_recorder;              ///< 事件录像器，可为空
+    QVector<FrameAnalyzer*> m_analyzers;    ///< 帧分析器（驾驶员监测、车道线检测等）
+    CameraFrame m_grabFrame;                ///< 采集线程私有的取帧缓冲
+    FrameMailbox<CameraFrame> m_mailbox;    ///< 最新帧信箱
+    std::atomic<bool> m_active;             ///< 摄像头是否激活
+    std::atomic<int> m_state;               ///< 连接状态（CameraState）
+    ReconnectBackoff m_backoff;             ///< 重连退避（仅采集线程访问）
+    qint64 m_lastFrameUs;                   ///< 最近一次收到帧的时刻（仅采集线程访问）
+    std::atomic<quint64> m_sequence;        ///< 下一帧序号（仅采集线程写入）
+    bool m_firstFrameMarked;                ///< 是否已记录首帧采集时间（仅采集线程访问）
+    std::atomic<bool> m_notifyPending;      ///< 是否已发出frameAvailable()且界面线程尚未取帧
+    std::atomic<int> m_frameDivisor;        ///< 帧率降低倍数
+    std::atomic<int> m_captureDivisor;      ///< 请求的采集分辨率降低倍数
+    int m_appliedCaptureDivisor;            ///< 帧源当前使用的采集分辨率降低倍数（仅采集线程访问）
+    quint64 m_frameCounter;                 ///< 降低帧率用的帧计数（仅采集线程访问）
+    std::atomic<quint64> m_skippedFrames;   ///< 降低帧率跳过的帧数
+
+    // 解码阶段，以下字段由m_decodeMutex保护
+    QMutex m_decodeMutex;                   ///< 解码状态互斥锁
+    QWaitCondition m_decodeIdle;            ///< 解码任务结束通知
+    CameraFrame m_pendingDecode;            ///< 待解码的最新压缩帧
+    QSize m_targetSize;                     ///< 显示目标尺寸
+    bool m_decodeBusy;                      ///< 是否有解码任务在运行
+    bool m_decodeStopping;                  ///< 是否正在停止
+};
+
+#endif // CAMERACAPTUREWORKER_H
@@ -0,0 +1,240 @@
+/**
+ * @file cameracompositor.cpp
+ * @brief 多路摄像头画面合成器的实现文件
+ */
+#include "cameracompositor.h"
+#include "frametiming.h"
+
+#include <QGuiApplication>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QScreen>
+
+#include <cmath>
+
+namespace {
+
+// 无法获取显示器刷新率时使用的刷新周期
+constexpr qint64 kDefaultRefreshIntervalUs = 1000000 / 60;
+
+// 画面块间隙的颜色，与主窗口背景一致
+const QColor kGapColor(0x1a, 0x1a, 0x1a);
+
+/**
+ * @brief 计算网格的列数
+ * @param gridCount 网格中的摄像头数量
+ * @return 列数
+ */
+int gridColumns(int gridCount)
+{
+    return qMax(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(qMax(1, gridCount))))));
+}
+
+/**
+ * @brief 计算网格的行数
+ * @param gridCount 网格中的摄像头数量
+ * @return 行数
+ */
+int gridRows(int gridCount)
+{
+    const int columns = gridColumns(gridCount);
+    return qMax(1, (gridCount + columns - 1) / columns);
+}
+
+} // namespace
+
+/**
+ * @brief CameraCompositor类的构造函数
+ * @param gridCount 网格中的摄像头数量
+ * @param parent 父窗口指针
+ *
+ * 创建网格画面块和驾驶员摄像头画面块，刷新周期取自主显示器
+ */
+CameraCompositor::CameraCompositor(int gridCount, QWidget *parent)
+    : QWidget(parent)
+    , m_refreshIntervalUs(kDefaultRefreshIntervalUs)
+    , m_lastPresentUs(0)
+{
+    // 每次绘制都从后备缓冲区覆盖变化区域，不需要Qt预先擦除背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    for (int i = 0; i <= gridCount; ++i) {
+        VideoTile *tile = new VideoTile(this);
+        connect(tile, &VideoTile::updateRequested, this, &CameraCompositor::onTileUpdateRequested);
+        connect(tile, &VideoTile::regionUpdateRequested, this, &CameraCompositor::onTileRegionUpdateRequested);
+        m_tiles.append(tile);
+    }
+    m_dirty.assign(m_tiles.size(), QRegion());
+
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    if (screen && screen->refreshRate() > 1.0) {
+        m_refreshIntervalUs = static_cast<qint64>(1000000.0 / screen->refreshRate());
+    }
+
+    m_presentTimer.setSingleShot(true);
+    m_presentTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_presentTimer, &QTimer::timeout, this, &CameraCompositor::present);
+}
+
+/**
+ * @brief 计算网格画面块为指定尺寸时合成器的尺寸
+ * @param tileSize 网格画面块尺寸
+ * @param gridCount 网格中的摄像头数量
+ * @return 合成器尺寸
+ */
+QSize CameraCompositor::sizeForTile(const QSize& tileSize, int gridCount)
+{
+    const int columns = gridColumns(gridCount);
+    const int rows = gridRows(gridCount);
+    return QSize(columns * tileSize.width() + columns * kSpacing + kDriverColumnWidth,
+                 rows * tileSize.height() + (rows - 1) * kSpacing);
+}
+
+/**
+ * @brief 画面块请求重绘
+ * @param tile 画面块
+ */
+void CameraCompositor::onTileUpdateRequested(VideoTile *tile)
+{
+    const int index = m_tiles.indexOf(tile);
+    if (index >= 0) {
+        markDirty(index, tile->geometry());
+    }
+}
+
+/**
+ * @brief 画面块请求重绘一部分
+ * @param tile 画面块
+ * @param region 需要重绘的区域
+ */
+void CameraCompositor::onTileRegionUpdateRequested(VideoTile *tile, const QRegion& region)
+{
+    const int index = m_tiles.indexOf(tile);
+    if (index >= 0) {
+        markDirty(index, region.intersected(tile->geometry()));
+    }
+}
+
+/**
+ * @brief 记录画面块需要重新合成的区域
+ * @param index 画面块索引
+ * @param region 区域
+ *
+ * 只记录变化，距上一次提交不足一个刷新周期时等到下一个周期再提交
+ */
+void CameraCompositor::markDirty(int index, const QRegion& region)
+{
+    if (region.isEmpty())
+        return;
+
+    m_dirty[index] += region;
+    m_pendingRegion += region;
+    if (m_presentTimer.isActive())
+        return;
+
+    const qint64 waitUs = m_lastPresentUs + m_refreshIntervalUs - monotonicNowUs();
+    m_presentTimer.start(static_cast<int>(qMax<qint64>(0, waitUs) / 1000));
+}
+
+/**
+ * @brief 在刷新周期到来时提交所有变化区域
+ */
+void CameraCompositor::present()
+{
+    m_lastPresentUs = monotonicNowUs();
+    if (m_pendingRegion.isEmpty())
+        return;
+    update(m_pendingRegion);
+    m_pendingRegion = QRegion();
+}
+
+/**
+ * @brief 绘制事件处理
+ * @param event 绘制事件
+ *
+ * 先把有变化的画面块合成到后备缓冲区，再只把本次需要重绘的区域贴到窗口
+ */
+void CameraCompositor::paintEvent(QPaintEvent *event)
+{
+    compose();
+
+    QPainter painter(this);
+    const qreal ratio = m_backing.devicePixelRatio();
+    for (const QRect& rect : event->region()) {
+        const QRect source(rect.topLeft() * ratio, rect.size() * ratio);
+        painter.drawImage(rect.topLeft(), m_backing, source);
+    }
+}
+
+/**
+ * @brief 尺寸变化事件处理
+ * @param event 尺寸变化事件
+ *
+ * 后备缓冲区按设备像素重建，所有画面块在下一次绘制时重新合成
+ */
+void CameraCompositor::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+
+    const qreal ratio = devicePixelRatioF();
+    m_backing = QImage(size() * ratio, QImage::Format_RGB32);
+    m_backing.setDevicePixelRatio(ratio);
+    m_backing.fill(kGapColor);
+
+    layoutTiles();
+    for (int i = 0; i < m_tiles.size(); ++i) {
+        m_dirty[i] = m_tiles[i]->geometry();
+    }
+}
+
+/**
+ * @brief 按当前尺寸布局画面块
+ *
+ * 网格占据驾驶员摄像头左侧的全部空间，各列、各行等分，余数给最后一列和最后一行
+ */
+void CameraCompositor::layoutTiles()
+{
+    const qreal ratio = devicePixelRatioF();
+    const int gridWidth = qMax(0, width() - kDriverColumnWidth - kSpacing);
+    const int count = gridCount();
+    const int columns = gridColumns(count);
+    const int rows = gridRows(count);
+    const int cellWidth = qMax(0, (gridWidth - (columns - 1) * kSpacing) / columns);
+    const int cellHeight = qMax(0, (height() - (rows - 1) * kSpacing) / rows);
+
+    for (int i = 0; i < count; ++i) {
+        const int column = i % columns;
+        const int row = i / columns;
+        const int x = column * (cellWidth + kSpacing);
+        const int y = row * (cellHeight + kSpacing);
+        const int w = column == columns - 1 ? gridWidth - x : cellWidth;
+        const int h = row == rows - 1 ? height() - y : cellHeight;
+        m_tiles[i]->setGeometry(QRect(x, y, qMax(0, w), qMax(0, h)), ratio);
+    }
+    driverTile()->setGeometry(QRect(width() - kDriverColumnWidth, 0, kDriverColumnWidth, height()), ratio);
+}
+
+/**
+ * @brief 把有变化的画面块绘制到后备缓冲区
+ *
+ * 每个画面块只重绘记录的区域，区域覆盖整个画面块时画面块完整绘制
+ */
+void CameraCompositor::compose()
+{
+    if (m_backing.isNull())
+        return;
+
+    QPainter painter(&m_backing);
+    painter.setFont(font());
+    for (int i = 0; i < m_tiles.size(); ++i) {
+        if (m_dirty[i].isEmpty())
+            continue;
+        const QRegion region = m_dirty[i];
+        m_dirty[i] = QRegion();
+        painter.save();
+        painter.setClipRegion(region);
+        m_tiles[i]->paint(painter, region);
+        painter.restore();
+    }
+}
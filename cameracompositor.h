@@ -0,0 +1,139 @@
+/**
+ * @file cameracompositor.h
+ * @brief 多路摄像头画面合成器的头文件
+ *
+ * 该文件定义了CameraCompositor类，用一个控件显示摄像头网格和驾驶员摄像头，
+ * 取代每个摄像头一个控件、各自布局和重绘的做法。
+ */
+#ifndef CAMERACOMPOSITOR_H
+#define CAMERACOMPOSITOR_H
+
+#include <QImage>
+#include <QRegion>
+#include <QTimer>
+#include <QVector>
+#include <QWidget>
+
+#include <vector>
+
+#include "videotile.h"
+
+/**
+ * @class CameraCompositor
+ * @brief 多路摄像头画面合成器
+ *
+ * 整个摄像头区域只有一个后备缓冲区。画面块有新画面时只把该块重新绘制到后备缓冲区，
+ * 只有叠加层变化时只重绘该块中变化的区域；同一刷新周期内的所有更新合并为一次update()，
+ * 绘制时只把变化的区域贴到窗口上。
+ * 窗口被遮挡后重新显示时直接从后备缓冲区贴图，不重新合成画面块。
+ *
+ * 左侧为网格摄像头，行列数由数量决定（4个时为2x2）；右侧为固定宽度的驾驶员摄像头
+ */
+class CameraCompositor : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kSpacing = 2;              ///< 画面块之间的间距
+    static constexpr int kDriverColumnWidth = 450;  ///< 驾驶员摄像头的宽度
+
+    /**
+     * @brief 构造函数
+     * @param gridCount 网格中的摄像头数量
+     * @param parent 父窗口指针，默认为nullptr
+     */
+    explicit CameraCompositor(int gridCount, QWidget *parent = nullptr);
+
+    /**
+     * @brief 计算网格画面块为指定尺寸时合成器的尺寸
+     * @param tileSize 网格画面块尺寸
+     * @param gridCount 网格中的摄像头数量
+     * @return 合成器尺寸
+     */
+    static QSize sizeForTile(const QSize& tileSize, int gridCount);
+
+    /**
+     * @brief 获取网格中的摄像头数量
+     * @return 摄像头数量
+     */
+    int gridCount() const { return m_tiles.size() - 1; }
+
+    /**
+     * @brief 获取网格中的画面块
+     * @param index 网格索引
+     * @return 画面块指针
+     */
+    VideoTile* gridTile(int index) const { return m_tiles[index]; }
+
+    /**
+     * @brief 获取驾驶员摄像头的画面块
+     * @return 画面块指针
+     */
+    VideoTile* driverTile() const { return m_tiles.last(); }
+
+    /**
+     * @brief 获取所有画面块，网格在前，驾驶员摄像头在最后
+     * @return 画面块列表
+     */
+    const QVector<VideoTile*>& tiles() const { return m_tiles; }
+
+protected:
+    /**
+     * @brief 绘制事件处理，合成有变化的画面块并把变化区域贴到窗口
+     * @param event 绘制事件
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+    /**
+     * @brief 尺寸变化事件处理，重新布局并重建后备缓冲区
+     * @param event 尺寸变化事件
+     */
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    /**
+     * @brief 画面块请求重绘
+     * @param tile 画面块
+     */
+    void onTileUpdateRequested(VideoTile *tile);
+
+    /**
+     * @brief 画面块请求重绘一部分
+     * @param tile 画面块
+     * @param region 需要重绘的区域
+     */
+    void onTileRegionUpdateRequested(VideoTile *tile, const QRegion& region);
+
+    /**
+     * @brief 在刷新周期到来时提交所有变化区域
+     */
+    void present();
+
+private:
+    /**
+     * @brief 按当前尺寸布局画面块
+     */
+    void layoutTiles();
+
+    /**
+     * @brief 把有变化的画面块绘制到后备缓冲区
+     */
+    void compose();
+
+    /**
+     * @brief 记录画面块需要重新合成的区域，并安排在下一个刷新周期提交
+     * @param index 画面块索引
+     * @param region 区域（合成器的逻辑坐标）
+     */
+    void markDirty(int index, const QRegion& region);
+
+    QVector<VideoTile*> m_tiles;        ///< 画面块（由合成器拥有）
+    std::vector<QRegion> m_dirty;       ///< 各画面块需要重新合成的区域
+    QRegion m_pendingRegion;            ///< 尚未提交的变化区域
+    QImage m_backing;                   ///< 整个摄像头区域的后备缓冲区
+    QTimer m_presentTimer;              ///< 等待下一个刷新周期的定时器
+    qint64 m_refreshIntervalUs;         ///< 显示器刷新周期（微秒）
+    qint64 m_lastPresentUs;             ///< 上一次提交的时刻（单调时钟，微秒）
+};
+
+#endif // CAMERACOMPOSITOR_H
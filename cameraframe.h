@@ -0,0 +1,59 @@
+/**
+ * @file cameraframe.h
+ * @brief 摄像头帧数据结构的头文件
+ */
+#ifndef CAMERAFRAME_H
+#define CAMERAFRAME_H
+
+#include <QtGlobal>
+
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+/**
+ * @brief 由四个字符组成像素格式代码（与V4L2/OpenCV的FOURCC一致）
+ */
+constexpr quint32 makeFourcc(char a, char b, char c, char d)
+{
+    return static_cast<quint32>(static_cast<quint8>(a))
+        | (static_cast<quint32>(static_cast<quint8>(b)) << 8)
+        | (static_cast<quint32>(static_cast<quint8>(c)) << 16)
+        | (static_cast<quint32>(static_cast<quint8>(d)) << 24);
+}
+
+constexpr quint32 FOURCC_MJPG = makeFourcc('M', 'J', 'P', 'G');   ///< Motion-JPEG压缩格式
+constexpr quint32 FOURCC_YUYV = makeFourcc('Y', 'U', 'Y', 'V');   ///< YUV 4:2:2打包格式
+constexpr quint32 FOURCC_BGR3 = makeFourcc('B', 'G', 'R', '3');   ///< BGR888格式
+
+/**
+ * @struct CameraFrame
+ * @brief 采集线程与界面线程之间传递的一帧摄像头画面
+ *
+ * 帧源可以只提供未解码的原始数据（raw），由采集线程解码为image；
+ * raw可能直接指向驱动的内核缓冲区，buffer释放时缓冲区才归还驱动。
+ */
+struct CameraFrame
+{
+    cv::Mat image;                      ///< BGR图像数据
+    quint64 sequence = 0;               ///< 帧序号，从1开始递增
+    qint64 captureTimeUs = 0;           ///< 采集完成时刻（单调时钟，微秒）
+    qint64 decodeTimeUs = 0;            ///< 解码完成时刻（单调时钟，微秒）
+
+    cv::Mat raw;                        ///< 未解码的原始数据，为空表示image已就绪
+    quint32 rawFormat = 0;              ///< 原始数据的像素格式（FOURCC）
+    qint64 deviceTimestampUs = 0;       ///< 驱动给出的采集时间戳（单调时钟，微秒），0表示未知
+    std::shared_ptr<const void> buffer; ///< 原始数据所在缓冲区的持有者，释放时归还给帧源
+
+    /**
+     * @brief 释放原始数据及其缓冲区
+     */
+    void releaseRaw()
+    {
+        raw.release();
+        buffer.reset();
+        rawFormat = 0;
+    }
+};
+
+#endif // CAMERAFRAME_H
@@ -0,0 +1,100 @@
+/**
+ * @file camerapipeline.cpp
+ * @brief 单个摄像头处理流水线的实现文件
+ */
+#include "camerapipeline.h"
+#include "cameracaptureworker.h"
+#include "framecopycounter.h"
+#include "lanedetector.h"
+#include "matimage.h"
+#include "overlaylayer.h"
+#include "stageprofiler.h"
+#include "videotile.h"
+
+/**
+ * @brief CameraPipeline类的构造函数
+ * @param index 摄像头索引
+ * @param config 摄像头配置
+ * @param tile 画面块
+ *
+ * 解码尺寸跟随画面块，MJPEG可以直接在DCT阶段缩小；车道线检测结果发布到画面块叠加层的一个通道
+ */
+CameraPipeline::CameraPipeline(int index, const CameraConfig& config, VideoTile *tile)
+    : m_index(index)
+    , m_config(config)
+    , m_tile(tile)
+{
+    m_worker.reset(new CameraCaptureWorker(index, config.location, config.source));
+    m_worker->setTargetSize(tile->targetSize());
+    QObject::connect(tile, &VideoTile::targetSizeChanged,
+                     m_worker.get(), &CameraCaptureWorker::setTargetSize, Qt::DirectConnection);
+
+    if (config.laneDetection) {
+        m_laneDetector.reset(new LaneDetector);
+        m_laneDetector->setOverlayChannel(tile->overlay()->addChannel());
+        m_worker->addFrameAnalyzer(m_laneDetector.get());
+    }
+}
+
+/**
+ * @brief CameraPipeline类的析构函数
+ */
+CameraPipeline::~CameraPipeline()
+{
+    stop();
+}
+
+/**
+ * @brief 启动采集线程
+ * @return 是否启动了采集线程
+ */
+bool CameraPipeline::start()
+{
+    if (m_laneDetector) {
+        m_laneDetector->start();
+    }
+    m_worker->start();
+    return true;
+}
+
+/**
+ * @brief 停止采集线程并释放设备
+ */
+void CameraPipeline::stop()
+{
+    m_worker->stop();
+    if (m_laneDetector) {
+        m_laneDetector->stop();
+    }
+}
+
+/**
+ * @brief 把最新一帧交给画面块
+ * @return 是否有新帧
+ */
+bool CameraPipeline::present()
+{
+    StageProfiler::Scope profile(StageProfiler::Stage::Present);
+    const CameraFrame *frame = m_worker->takeLatestFrame();
+    if (!frame || frame->image.empty())
+        return false;
+
+    FrameTiming timing;
+    timing.sequence = frame->sequence;
+    // 驱动时间戳最接近曝光时刻，没有时使用采集完成时刻
+    timing.captureUs = frame->deviceTimestampUs > 0 ? frame->deviceTimestampUs : frame->captureTimeUs;
+    timing.decodeUs = frame->decodeTimeUs;
+
+    m_tile->setFrame(matToQImage(frame->image), timing);
+    FrameCopyCounter::recordFrame();
+    return true;
+}
+
+/**
+ * @brief 摄像头是否处于激活状态
+ * @return 是否激活
+ */
+bool CameraPipeline::isActive() const
+{
+    return m_worker->isActive();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file camerapipeline.h
+ * @brief 单个摄像头处理流水线的头文件
+ *
+ * 该文件定义了CameraPipeline类，把一个摄像头的配置、采集线程和画面块
+ * 组合在一起，主窗口只需遍历流水线列表，而不必为每个摄像头编写重复代码。
+ */
+#ifndef CAMERAPIPELINE_H
+#define CAMERAPIPELINE_H
+
+#include <memory>
+
+#include "cameraregistry.h"
+
+class CameraCaptureWorker;
+class LaneDetector;
+class VideoTile;
+
+/**
+ * @class CameraPipeline
+ * @brief 单个摄像头的采集、解码、显示流水线
+ *
+ * 采集在摄像头自己的线程中阻塞等待设备，解码和缩放都提交到共享的
+ * frameWorkerPool()，因此CPU开销随摄像头数量线性增长，线程数不随之增长。
+ * 界面线程只调用present()取走最新帧。配置了车道线检测的摄像头另有一个LaneDetector线程，
+ * 结果由检测线程直接发布到画面块的叠加层。
+ */
+class CameraPipeline
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param index 摄像头索引
+     * @param config 摄像头配置
+     * @param tile 显示该摄像头的画面块
+     */
+    CameraPipeline(int index, const CameraConfig& config, VideoTile *tile);
+
+    /**
+     * @brief 析构函数，停止采集
+     */
+    ~CameraPipeline();
+
+    CameraPipeline(const CameraPipeline&) = delete;
+    CameraPipeline& operator=(const CameraPipeline&) = delete;
+
+    /**
+     * @brief 启动采集线程
+     * @return 是否启动了采集线程
+     *
+     * 立即返回，设备在采集线程中打开，打开失败时由其在后台按退避策略重连
+     */
+    bool start();
+
+    /**
+     * @brief 停止采集线程并释放设备
+     */
+    void stop();
+
+    /**
+     * @brief 把最新一帧交给画面块（仅界面线程调用）
+     * @return 是否有新帧
+     */
+    bool present();
+
+    /**
+     * @brief 摄像头是否处于激活状态
+     * @return 是否激活
+     */
+    bool isActive() const;
+
+    /**
+     * @brief 获取摄像头索引
+     * @return 摄像头索引
+     */
+    int index() const { return m_index; }
+
+    /**
+     * @brief 获取摄像头配置
+     * @return 摄像头配置
+     */
+    const CameraConfig& config() const { return m_config; }
+
+    /**
+     * @brief 获取画面块
+     * @return 画面块指针
+     */
+    VideoTile* tile() const { return m_tile; }
+
+    /**
+     * @brief 获取采集线程
+     * @return 采集线程指针
+     */
+    CameraCaptureWorker* worker() const { return m_worker.get(); }
+
+    /**
+     * @brief 获取车道线检测线程
+     * @return 车道线检测线程指针，未启用车道线检测时为nullptr
+     */
+    LaneDetector* laneDetector() const { return m_laneDetector.get(); }
+
+private:
+    int m_index;                                    ///< 摄像头索引
+    CameraConfig m_config;                          ///< 摄像头配置
+    VideoTile *m_tile;                              ///< 画面块（由合成器拥有）
+    std::unique_ptr<CameraCaptureWorker> m_worker;  ///< 采集线程
+    std::unique_ptr<LaneDetector> m_laneDetector;   ///< 车道线检测线程（可为空）
+};
+
+#endif // CAMERAPIPELINE_H
@@ -0,0 +1,259 @@
+/**
+ * @file cameraregistry.cpp
+ * @brief 摄像头注册表的实现文件
+ */
+#include "cameraregistry.h"
+#include "sessionframesource.h"
+#include "sessionreader.h"
+
+#include <QFile>
+#include <QSettings>
+
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief 把四字符像素格式名转换为FOURCC
+ * @param name 像素格式名，如MJPG、YUYV
+ * @param fallback 名称无效时使用的格式
+ * @return FOURCC
+ */
+quint32 fourccFromName(const QString& name, quint32 fallback)
+{
+    const QByteArray bytes = name.trimmed().toLatin1();
+    if (bytes.size() != 4)
+        return fallback;
+    return makeFourcc(bytes[0], bytes[1], bytes[2], bytes[3]);
+}
+
+/**
+ * @brief 从QSettings的当前分组读取一个摄像头配置
+ * @param settings 已定位到该摄像头分组的QSettings
+ * @param defaultName 未配置名称时使用的名称
+ * @return 摄像头配置
+ */
+CameraConfig readCameraConfig(const QSettings& settings, const QString& defaultName)
+{
+    const FrameSourceConfig defaults;
+    CameraConfig config;
+    config.location = settings.value("location").toString();
+    config.name = settings.value("name", defaultName).toString();
+    config.source.width = settings.value("width", defaults.width).toInt();
+    config.source.height = settings.value("height", defaults.height).toInt();
+    config.source.fps = settings.value("fps", defaults.fps).toInt();
+    config.source.pixelFormat = fourccFromName(settings.value("format").toString(), defaults.pixelFormat);
+    config.source.bufferCount = settings.value("buffers", defaults.bufferCount).toInt();
+    config.source.realtime = settings.value("realtime", defaults.realtime).toBool();
+    config.source.speed = settings.value("speed", defaults.speed).toDouble();
+    config.source.loop = settings.value("loop", defaults.loop).toBool();
+    config.priority = settings.value("priority", 0).toInt();
+    config.laneDetection = settings.value("lanes", false).toBool();
+    config.objectDetection = settings.value("detect", true).toBool();
+    return config;
+}
+
+} // namespace
+
+/**
+ * @brief 默认配置
+ * @return 注册表
+ */
+CameraRegistry CameraRegistry::defaults()
+{
+    // 第四个画面位置用于演示车辆检测
+    CameraRegistry registry = fromLocations({"/dev/video0", "/dev/video2", "/dev/video4", "synthetic:vehicle"});
+    registry.m_cameras.last().source.height = 480;
+    registry.m_cameras.first().laneDetection = true;
+    return registry;
+}
+
+/**
+ * @brief 全部使用合成测试画面的注册表
+ * @param count 摄像头数量
+ * @param source 采集参数
+ * @return 注册表
+ */
+CameraRegistry CameraRegistry::synthetic(int count, const FrameSourceConfig& source)
+{
+    CameraRegistry registry;
+    for (int i = 0; i < count; ++i) {
+        CameraConfig config;
+        config.name = QString("合成%1").arg(i);
+        config.location = "synthetic:bars";
+        config.source = source;
+        registry.addCamera(config);
+    }
+    return registry;
+}
+
+/**
+ * @brief 设置是否对指定摄像头做车道线检测
+ * @param index 摄像头索引
+ * @param enabled 是否检测
+ */
+void CameraRegistry::setLaneDetection(int index, bool enabled)
+{
+    if (index < 0 || index >= m_cameras.size()) {
+        std::cerr << "车道线检测的摄像头索引无效: " << index << std::endl;
+        return;
+    }
+    m_cameras[index].laneDetection = enabled;
+}
+
+/**
+ * @brief 设置所有录像回放的速度
+ * @param speed 速度倍数，不大于0时尽可能快地回放
+ */
+void CameraRegistry::setReplaySpeed(double speed)
+{
+    auto apply = [speed](CameraConfig& config) {
+        config.source.realtime = speed > 0.0;
+        config.source.speed = speed > 0.0 ? speed : 1.0;
+    };
+    for (CameraConfig& config : m_cameras) {
+        apply(config);
+    }
+    apply(m_driverCamera);
+}
+
+/**
+ * @brief 设置所有录像回放的起始位置
+ * @param offsetUs 相对录像开始的时间（微秒）
+ */
+void CameraRegistry::setReplayStart(qint64 offsetUs)
+{
+    for (CameraConfig& config : m_cameras) {
+        config.source.startUs = offsetUs;
+    }
+    m_driverCamera.source.startUs = offsetUs;
+}
+
+/**
+ * @brief 设置所有录像回放共用的开始时刻
+ * @param clockStartUs 单调时钟时刻（微秒）
+ */
+void CameraRegistry::setReplayClock(qint64 clockStartUs)
+{
+    for (CameraConfig& config : m_cameras) {
+        config.source.clockStartUs = clockStartUs;
+    }
+    m_driverCamera.source.clockStartUs = clockStartUs;
+}
+
+/**
+ * @brief 驾驶员摄像头的默认配置
+ * @return 摄像头配置
+ */
+CameraConfig CameraRegistry::defaultDriverCamera()
+{
+    CameraConfig config;
+    config.name = "驾驶员";
+    config.location = "synthetic:driver";
+    config.source.height = 480;
+    return config;
+}
+
+/**
+ * @brief 使用给定的设备路径创建注册表
+ * @param locations 设备路径或录像文件路径列表
+ * @return 注册表
+ */
+CameraRegistry CameraRegistry::fromLocations(const QStringList& locations)
+{
+    CameraRegistry registry;
+    for (int i = 0; i < locations.size(); ++i) {
+        CameraConfig config;
+        config.name = QString("摄像头%1").arg(i);
+        config.location = locations[i];
+        registry.addCamera(config);
+    }
+    return registry;
+}
+
+/**
+ * @brief 从INI配置文件读取注册表
+ * @param path 配置文件路径
+ * @param ok 输出是否读取成功
+ * @return 注册表
+ */
+CameraRegistry CameraRegistry::fromSettings(const QString& path, bool *ok)
+{
+    CameraRegistry registry;
+    if (ok)
+        *ok = false;
+
+    if (!QFile::exists(path)) {
+        std::cerr << "摄像头配置文件不存在: " << path.toStdString() << std::endl;
+        return registry;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    const int size = settings.beginReadArray("cameras");
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+        const CameraConfig config = readCameraConfig(settings, QString("摄像头%1").arg(i));
+        if (config.location.isEmpty()) {
+            std::cerr << "摄像头配置第" << (i + 1) << "项缺少location，已忽略" << std::endl;
+            continue;
+        }
+        registry.addCamera(config);
+    }
+    settings.endArray();
+
+    if (settings.childGroups().contains("driver")) {
+        settings.beginGroup("driver");
+        const CameraConfig driver = readCameraConfig(settings, "驾驶员");
+        settings.endGroup();
+        if (!driver.location.isEmpty()) {
+            registry.setDriverCamera(driver);
+        }
+    }
+
+    if (ok)
+        *ok = registry.count() > 0;
+    return registry;
+}
+
+/**
+ * @brief 从事件录像的会话文件创建注册表
+ * @param path 会话文件路径
+ * @param ok 输出是否读取成功
+ * @return 注册表
+ *
+ * 这里只读取摄像头表，帧数据由各摄像头的SessionFrameSource各自映射
+ */
+CameraRegistry CameraRegistry::fromSession(const QString& path, bool *ok)
+{
+    CameraRegistry registry;
+    if (ok)
+        *ok = false;
+
+    SessionReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "无法打开会话文件: " << path.toStdString() << std::endl;
+        return registry;
+    }
+
+    const int count = reader.cameraCount();
+    for (int i = 0; i < count; ++i) {
+        if (reader.frameCount(i) == 0)
+            continue;
+
+        CameraConfig config;
+        config.name = reader.cameraName(i);
+        if (config.name.isEmpty()) {
+            config.name = QString("录像%1").arg(i);
+        }
+        config.location = SessionFrameSource::sessionLocation(path, i);
+        if (i == count - 1 && count > 1) {
+            registry.setDriverCamera(config);
+        } else {
+            registry.addCamera(config);
+        }
+    }
+
+    if (ok)
+        *ok = registry.count() > 0;
+    return registry;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file cameraregistry.h
+ * @brief 摄像头注册表的头文件
+ *
+ * 该文件定义了CameraConfig和CameraRegistry，摄像头的数量、名称、设备路径和
+ * 采集参数都来自配置，界面和采集代码只按索引遍历注册表。
+ */
+#ifndef CAMERAREGISTRY_H
+#define CAMERAREGISTRY_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "framesource.h"
+
+/**
+ * @struct CameraConfig
+ * @brief 单个摄像头的配置
+ */
+struct CameraConfig
+{
+    QString name;                       ///< 显示名称
+    QString location;                   ///< 设备路径、录像文件路径、"synthetic:<图案>"或"session:<文件>#<索引>"
+    FrameSourceConfig source;           ///< 采集参数
+    int priority = 0;                   ///< 负载过高时的保留优先级，越大越晚降低画质
+    bool laneDetection = false;         ///< 是否做车道线检测（前视摄像头）
+    bool objectDetection = true;        ///< 是否参与车辆/行人检测（驾驶员摄像头不参与）
+};
+
+/**
+ * @class CameraRegistry
+ * @brief 摄像头注册表
+ *
+ * 按配置顺序保存网格中的摄像头，索引即画面在网格中的位置；
+ * 驾驶员摄像头单独保存，显示在右侧
+ */
+class CameraRegistry
+{
+public:
+    /**
+     * @brief 默认配置：/dev/video0、2、4三个摄像头加一路车辆检测模拟画面，驾驶员摄像头为模拟画面，
+     *        /dev/video0为前视摄像头，做车道线检测
+     * @return 注册表
+     */
+    static CameraRegistry defaults();
+
+    /**
+     * @brief 全部使用合成测试画面的注册表，用于压力测试
+     * @param count 摄像头数量
+     * @param source 采集参数（分辨率、帧率）
+     * @return 注册表
+     */
+    static CameraRegistry synthetic(int count, const FrameSourceConfig& source);
+
+    /**
+     * @brief 使用给定的设备路径创建注册表
+     * @param locations 设备路径或录像文件路径列表
+     * @return 注册表
+     */
+    static CameraRegistry fromLocations(const QStringList& locations);
+
+    /**
+     * @brief 从INI配置文件读取注册表
+     * @param path 配置文件路径
+     * @param ok 输出是否读取成功，可为nullptr
+     * @return 注册表，读取失败时为空
+     *
+     * 格式为QSettings数组：
+     * @code
+     * [cameras]
+     * size=3
+     * 1\name=前视
+     * 1\location=/dev/video0
+     * 1\width=1280
+     * 1\height=720
+     * 1\fps=30
+     * 1\format=MJPG
+     * 1\priority=10
+     * 1\lanes=true
+     * 1\detect=true
+     * 2\location=/data/rear.mp4
+     * 3\location=synthetic:bars
+     *
+     * [driver]
+     * location=/dev/video8
+     * @endcode
+     */
+    static CameraRegistry fromSettings(const QString& path, bool *ok = nullptr);
+
+    /**
+     * @brief 从事件录像的会话文件创建注册表
+     * @param path 会话文件路径（.adss）
+     * @param ok 输出是否读取成功，可为nullptr
+     * @return 注册表，读取失败时为空
+     *
+     * 录像器按网格摄像头在前、驾驶员摄像头在最后的顺序写入，这里按同样的顺序还原；
+     * 没有录到帧的摄像头（非MJPEG格式）不加入网格，驾驶员摄像头没有帧时保持默认
+     */
+    static CameraRegistry fromSession(const QString& path, bool *ok = nullptr);
+
+    /**
+     * @brief 添加一个摄像头
+     * @param config 摄像头配置
+     */
+    void addCamera(const CameraConfig& config) { m_cameras.append(config); }
+
+    /**
+     * @brief 获取摄像头数量
+     * @return 摄像头数量
+     */
+    int count() const { return m_cameras.size(); }
+
+    /**
+     * @brief 获取指定摄像头的配置
+     * @param index 摄像头索引
+     * @return 摄像头配置
+     */
+    const CameraConfig& camera(int index) const { return m_cameras[index]; }
+
+    /**
+     * @brief 获取所有摄像头的配置
+     * @return 摄像头配置列表
+     */
+    const QVector<CameraConfig>& cameras() const { return m_cameras; }
+
+    /**
+     * @brief 获取驾驶员摄像头的配置
+     * @return 摄像头配置
+     */
+    const CameraConfig& driverCamera() const { return m_driverCamera; }
+
+    /**
+     * @brief 设置驾驶员摄像头
+     * @param config 摄像头配置
+     */
+    void setDriverCamera(const CameraConfig& config) { m_driverCamera = config; }
+
+    /**
+     * @brief 设置是否对指定摄像头做车道线检测
+     * @param index 摄像头索引，越界时忽略
+     * @param enabled 是否检测
+     */
+    void setLaneDetection(int index, bool enabled);
+
+    /**
+     * @brief 设置所有录像回放的速度
+     * @param speed 速度倍数，不大于0时不按帧率等待，尽可能快地回放
+     */
+    void setReplaySpeed(double speed);
+
+    /**
+     * @brief 设置所有录像回放的起始位置
+     * @param offsetUs 相对录像开始的时间（微秒）
+     */
+    void setReplayStart(qint64 offsetUs);
+
+    /**
+     * @brief 设置所有录像回放共用的开始时刻
+     * @param clockStartUs 起始位置对应的单调时钟时刻（微秒）
+     *
+     * 各摄像头以同一时刻为基准换算会话时间轴，先打开或重连的摄像头不会与其他摄像头错开
+     */
+    void setReplayClock(qint64 clockStartUs);
+
+private:
+    /**
+     * @brief 驾驶员摄像头的默认配置（模拟画面）
+     * @return 摄像头配置
+     */
+    static CameraConfig defaultDriverCamera();
+
+    QVector<CameraConfig> m_cameras;    ///< 按索引排列的摄像头配置
+    CameraConfig m_driverCamera = defaultDriverCamera();  ///< 驾驶员摄像头配置
+};
+
+#endif // CAMERAREGISTRY_H
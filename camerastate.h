@@ -0,0 +1,44 @@
+/**
+ * @file camerastate.h
+ * @brief 摄像头连接状态的头文件
+ */
+#ifndef CAMERASTATE_H
+#define CAMERASTATE_H
+
+#include <QMetaType>
+
+/**
+ * @brief 摄像头连接状态
+ *
+ * 状态只由采集线程改变，界面线程通过排队信号得知变化
+ */
+enum class CameraState {
+    Connecting,     ///< 正在首次打开设备，尚未收到帧
+    Streaming,      ///< 正常出帧
+    Degraded,       ///< 设备已打开但长时间没有新帧，或出错后正在重连
+    Lost            ///< 多次重连失败，继续以最大间隔重试
+};
+
+Q_DECLARE_METATYPE(CameraState)
+
+/**
+ * @brief 获取状态的显示名称
+ * @param state 摄像头状态
+ * @return 显示名称
+ */
+inline const char* cameraStateName(CameraState state)
+{
+    switch (state) {
+    case CameraState::Connecting:
+        return "连接中";
+    case CameraState::Streaming:
+        return "正常";
+    case CameraState::Degraded:
+        return "信号不稳定";
+    case CameraState::Lost:
+        return "信号丢失";
+    }
+    return "未知";
+}
+
+#endif // CAMERASTATE_H
@@ -0,0 +1,207 @@
+/**
+ * @file candumpreplaysource.cpp
+ * @brief candump日志回放CAN帧源的实现文件
+ */
+#include "candumpreplaysource.h"
+#include "frametiming.h"
+
+#include <QList>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// 落后日志节奏超过该时长（如被调试器暂停）时重新对齐，而不是连续追帧
+constexpr qint64 kResyncAfterUs = 1000000;
+
+/**
+ * @brief 解析"秒.微秒"格式的时间戳
+ * @param text 时间戳文本
+ * @param ok 输出是否解析成功
+ * @return 微秒
+ */
+qint64 parseTimestampUs(const QByteArray& text, bool *ok)
+{
+    const int dot = text.indexOf('.');
+    const QByteArray seconds = dot < 0 ? text : text.left(dot);
+    QByteArray fraction = dot < 0 ? QByteArray() : text.mid(dot + 1).left(6);
+    fraction = fraction.leftJustified(6, '0');
+
+    bool secondsOk = false;
+    bool fractionOk = false;
+    const qint64 value = seconds.toLongLong(&secondsOk) * 1000000 + fraction.toLongLong(&fractionOk);
+    *ok = secondsOk && fractionOk;
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief CandumpReplaySource类的构造函数
+ * @param path 日志文件路径
+ * @param config 帧源参数
+ */
+CandumpReplaySource::CandumpReplaySource(const QString& path, const CanSourceConfig& config)
+    : m_path(path)
+    , m_config(config)
+    , m_file(path)
+    , m_hasPending(false)
+    , m_logStartUs(0)
+    , m_playStartUs(0)
+{
+}
+
+/**
+ * @brief 打开日志文件
+ * @return 是否打开成功
+ */
+bool CandumpReplaySource::open()
+{
+    close();
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+    m_hasPending = false;
+    m_playStartUs = 0;
+    return true;
+}
+
+/**
+ * @brief 关闭日志文件
+ */
+void CandumpReplaySource::close()
+{
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_hasPending = false;
+}
+
+/**
+ * @brief 解析一行candump日志
+ * @param line 日志行，如"(1436509052.249713) vcan0 044#2A366C2BBA"
+ * @param frame 输出帧
+ * @return 是否为有效的经典CAN数据帧
+ */
+bool CandumpReplaySource::parseLine(const QByteArray& line, CanFrame& frame)
+{
+    const QByteArray trimmed = line.trimmed();
+    if (!trimmed.startsWith('('))
+        return false;
+    const int close = trimmed.indexOf(')');
+    if (close < 0)
+        return false;
+
+    bool ok = false;
+    frame.timeUs = parseTimestampUs(trimmed.mid(1, close - 1), &ok);
+    if (!ok)
+        return false;
+
+    // 接口名之后是帧，较新版本的candump还会在帧之后追加方向标记，忽略
+    const QList<QByteArray> fields = trimmed.mid(close + 1).simplified().split(' ');
+    if (fields.size() < 2)
+        return false;
+    const QByteArray& text = fields[1];
+    const int hash = text.indexOf('#');
+    if (hash < 0)
+        return false;
+
+    // "##"为CAN FD帧，"#R"为远程帧
+    const QByteArray idText = text.left(hash);
+    QByteArray dataText = text.mid(hash + 1);
+    if (dataText.startsWith('#') || dataText.startsWith('R'))
+        return false;
+
+    if (idText.size() != 3 && idText.size() != 8)
+        return false;
+    frame.id = idText.toUInt(&ok, 16);
+    if (!ok)
+        return false;
+    frame.extended = idText.size() == 8;
+
+    // 去掉数据之后的"_DLC"后缀和字节分隔符
+    const int underscore = dataText.indexOf('_');
+    if (underscore >= 0) {
+        dataText.truncate(underscore);
+    }
+    dataText.replace('.', QByteArray());
+    if (dataText.size() % 2 != 0 || dataText.size() > 16)
+        return false;
+
+    const QByteArray bytes = QByteArray::fromHex(dataText);
+    if (bytes.size() * 2 != dataText.size())
+        return false;
+    frame.length = static_cast<quint8>(bytes.size());
+    std::memset(frame.data, 0, sizeof(frame.data));
+    std::memcpy(frame.data, bytes.constData(), static_cast<size_t>(bytes.size()));
+    return true;
+}
+
+/**
+ * @brief 读取日志中的下一个有效帧
+ * @return 是否读取成功，到达结尾且不循环时返回false
+ */
+bool CandumpReplaySource::readNext()
+{
+    for (int rounds = 0; rounds < 2; ++rounds) {
+        while (!m_file.atEnd()) {
+            if (parseLine(m_file.readLine(), m_pending)) {
+                m_hasPending = true;
+                return true;
+            }
+        }
+        if (!m_config.loop)
+            return false;
+
+        // 回到日志开头，下一帧作为新一轮回放的起点
+        m_file.seek(0);
+        m_playStartUs = 0;
+    }
+    return false;
+}
+
+/**
+ * @brief 按日志节奏输出下一帧
+ * @param frame 输出帧
+ * @param timeoutMs 最长等待时间（毫秒）
+ * @return 读取结果
+ */
+CanFrameSource::ReadResult CandumpReplaySource::read(CanFrame& frame, int timeoutMs)
+{
+    if (!m_file.isOpen())
+        return ReadResult::Error;
+    if (!m_hasPending && !readNext())
+        return ReadResult::Error;
+
+    qint64 now = monotonicNowUs();
+    if (m_playStartUs == 0) {
+        m_logStartUs = m_pending.timeUs;
+        m_playStartUs = now;
+    }
+
+    if (m_config.realtime) {
+        const double speed = qMax(0.01, m_config.speed);
+        qint64 dueUs = m_playStartUs + static_cast<qint64>((m_pending.timeUs - m_logStartUs) / speed);
+        if (now - dueUs > kResyncAfterUs || m_pending.timeUs < m_logStartUs) {
+            m_logStartUs = m_pending.timeUs;
+            m_playStartUs = now;
+            dueUs = now;
+        }
+
+        const qint64 waitUs = dueUs - now;
+        if (waitUs > static_cast<qint64>(timeoutMs) * 1000) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+            return ReadResult::Timeout;
+        }
+        if (waitUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+            now = monotonicNowUs();
+        }
+    }
+
+    frame = m_pending;
+    frame.timeUs = now;
+    m_hasPending = false;
+    return ReadResult::Frame;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file candumpreplaysource.h
+ * @brief candump日志回放CAN帧源的头文件
+ */
+#ifndef CANDUMPREPLAYSOURCE_H
+#define CANDUMPREPLAYSOURCE_H
+
+#include <QFile>
+
+#include "canframesource.h"
+
+/**
+ * @class CandumpReplaySource
+ * @brief 回放candump -l记录的日志
+ *
+ * 日志每行格式为"(秒.微秒) 接口 ID#数据"，按日志中相邻帧的时间间隔（或尽可能快地）输出，
+ * 接收时刻换算为回放时的单调时钟。CAN FD帧、远程帧和无法解析的行被跳过
+ */
+class CandumpReplaySource : public CanFrameSource
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param path 日志文件路径
+     * @param config 帧源参数
+     */
+    CandumpReplaySource(const QString& path, const CanSourceConfig& config);
+
+    bool open() override;
+    void close() override;
+    ReadResult read(CanFrame& frame, int timeoutMs) override;
+    QString location() const override { return m_path; }
+
+    /**
+     * @brief 解析一行candump日志
+     * @param line 日志行
+     * @param frame 输出帧，timeUs为日志中的时刻（微秒）
+     * @return 是否为有效的经典CAN数据帧
+     */
+    static bool parseLine(const QByteArray& line, CanFrame& frame);
+
+private:
+    /**
+     * @brief 读取日志中的下一个有效帧到m_pending
+     * @return 是否读取成功
+     */
+    bool readNext();
+
+    QString m_path;             ///< 日志文件路径
+    CanSourceConfig m_config;   ///< 帧源参数
+    QFile m_file;               ///< 日志文件
+    CanFrame m_pending;         ///< 已读出、尚未到输出时刻的帧
+    bool m_hasPending;          ///< m_pending是否有效
+    qint64 m_logStartUs;        ///< 本轮回放第一帧在日志中的时刻（微秒）
+    qint64 m_playStartUs;       ///< 本轮回放开始的时刻（单调时钟，微秒）
+};
+
+#endif // CANDUMPREPLAYSOURCE_H
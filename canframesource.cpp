@@ -0,0 +1,38 @@
+/**
+ * @file canframesource.cpp
+ * @brief CAN帧源工厂函数的实现文件
+ */
+#include "canframesource.h"
+#include "candumpreplaysource.h"
+#ifdef ADAS_HAVE_SOCKETCAN
+#include "socketcanframesource.h"
+#endif
+
+#include <iostream>
+
+namespace {
+
+// SocketCAN接口位置的前缀
+const QString kSocketCanPrefix = QStringLiteral("can:");
+
+} // namespace
+
+/**
+ * @brief 根据位置创建合适的CAN帧源
+ * @param location "can:<接口名>"或candump日志文件路径
+ * @param config 帧源参数
+ * @return 帧源对象，不支持的位置返回nullptr
+ */
+std::unique_ptr<CanFrameSource> createCanFrameSource(const QString& location, const CanSourceConfig& config)
+{
+    if (location.startsWith(kSocketCanPrefix)) {
+#ifdef ADAS_HAVE_SOCKETCAN
+        return std::make_unique<SocketCanFrameSource>(location.mid(kSocketCanPrefix.size()));
+#else
+        std::cerr << "当前平台不支持SocketCAN: " << location.toStdString() << std::endl;
+        return nullptr;
+#endif
+    }
+
+    return std::make_unique<CandumpReplaySource>(location, config);
+}
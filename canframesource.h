@@ -0,0 +1,96 @@
+/**
+ * @file canframesource.h
+ * @brief CAN帧源抽象接口的头文件
+ *
+ * 该文件定义了CanFrame结构和CanFrameSource接口，车辆信号线程通过它读取CAN帧，
+ * 而不关心帧来自SocketCAN接口还是candump日志。
+ */
+#ifndef CANFRAMESOURCE_H
+#define CANFRAMESOURCE_H
+
+#include <QString>
+
+#include <memory>
+
+/**
+ * @struct CanFrame
+ * @brief 一帧经典CAN数据
+ */
+struct CanFrame
+{
+    quint32 id = 0;             ///< 帧ID（不含扩展帧标志）
+    bool extended = false;      ///< 是否为29位扩展帧
+    quint8 length = 0;          ///< 数据长度（0~8）
+    quint8 data[8] = {};        ///< 数据
+    qint64 timeUs = 0;          ///< 接收时刻（单调时钟，微秒）
+};
+
+/**
+ * @struct CanSourceConfig
+ * @brief CAN帧源参数
+ */
+struct CanSourceConfig
+{
+    bool realtime = true;       ///< 回放时是否按日志中的时间间隔输出
+    double speed = 1.0;         ///< 按时间间隔回放时的速度倍数
+    bool loop = true;           ///< 回放到结尾时是否从头开始
+};
+
+/**
+ * @class CanFrameSource
+ * @brief CAN帧源抽象接口
+ *
+ * 所有方法都只在车辆信号线程中调用
+ */
+class CanFrameSource
+{
+public:
+    /**
+     * @brief read()的结果
+     */
+    enum class ReadResult {
+        Frame,      ///< 成功读取一帧
+        Timeout,    ///< 等待超时，帧源仍然可用
+        Error       ///< 帧源出错，需要关闭后重新打开
+    };
+
+    virtual ~CanFrameSource() = default;
+
+    /**
+     * @brief 打开帧源
+     * @return 是否打开成功
+     */
+    virtual bool open() = 0;
+
+    /**
+     * @brief 关闭帧源
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief 等待并读取下一帧
+     * @param frame 输出帧
+     * @param timeoutMs 最长等待时间（毫秒）
+     * @return 读取结果
+     */
+    virtual ReadResult read(CanFrame& frame, int timeoutMs) = 0;
+
+    /**
+     * @brief 获取帧源的位置描述（接口名或日志文件路径）
+     * @return 位置描述
+     */
+    virtual QString location() const = 0;
+};
+
+/**
+ * @brief 根据位置创建合适的CAN帧源
+ * @param location "can:<接口名>"（如can:vcan0）或candump日志文件路径
+ * @param config 帧源参数
+ * @return 帧源对象（尚未打开），不支持的位置返回nullptr
+ *
+ * SocketCAN接口只在Linux下可用
+ */
+std::unique_ptr<CanFrameSource> createCanFrameSource(const QString& location,
+                                                     const CanSourceConfig& config = CanSourceConfig());
+
+#endif // CANFRAMESOURCE_H
@@ -0,0 +1,206 @@
+/**
+ * @file cansignaldecoder.cpp
+ * @brief 表驱动CAN信号解码器的实现文件
+ */
+#include "cansignaldecoder.h"
+
+#include <QFile>
+#include <QSettings>
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief 检查信号定义是否有效
+ * @param def 信号定义
+ * @return 是否有效
+ */
+bool isValidDef(const CanSignalDef& def)
+{
+    if (def.signal == VehicleSignal::Count || def.length < 1 || def.length > 64)
+        return false;
+    if (def.startBit < 0 || def.startBit > 63)
+        return false;
+    if (def.bigEndian) {
+        const int msbPosition = (7 - def.startBit / 8) * 8 + def.startBit % 8;
+        return msbPosition - def.length + 1 >= 0;
+    }
+    return def.startBit + def.length <= 64;
+}
+
+} // namespace
+
+/**
+ * @brief CanSignalDecoder类的构造函数
+ * @param table 信号表
+ *
+ * 无效的信号定义被忽略；其余按帧ID排序，同一ID的信号在表中连续存放
+ */
+CanSignalDecoder::CanSignalDecoder(const QVector<CanSignalDef>& table)
+{
+    for (const CanSignalDef& def : table) {
+        if (isValidDef(def)) {
+            m_table.append(def);
+        } else {
+            std::cerr << "无效的CAN信号定义: " << vehicleSignalKey(def.signal)
+                      << " ID 0x" << std::hex << def.canId << std::dec << std::endl;
+        }
+    }
+    std::stable_sort(m_table.begin(), m_table.end(), [](const CanSignalDef& a, const CanSignalDef& b) {
+        return a.canId < b.canId;
+    });
+
+    for (int i = 0; i < m_table.size(); ) {
+        int end = i + 1;
+        while (end < m_table.size() && m_table[end].canId == m_table[i].canId) {
+            ++end;
+        }
+        m_index.insert(m_table[i].canId, qMakePair(i, end));
+        i = end;
+    }
+}
+
+/**
+ * @brief 示例车型的信号表
+ * @return 信号表
+ */
+QVector<CanSignalDef> CanSignalDecoder::defaultTable()
+{
+    QVector<CanSignalDef> table;
+
+    CanSignalDef speed;
+    speed.signal = VehicleSignal::Speed;
+    speed.canId = 0x3E9;
+    speed.startBit = 7;
+    speed.length = 16;
+    speed.bigEndian = true;
+    speed.factor = 0.01;
+    table.append(speed);
+
+    CanSignalDef steering;
+    steering.signal = VehicleSignal::SteeringAngle;
+    steering.canId = 0x025;
+    steering.startBit = 3;
+    steering.length = 12;
+    steering.bigEndian = true;
+    steering.isSigned = true;
+    steering.factor = 1.5;
+    table.append(steering);
+
+    CanSignalDef gear;
+    gear.signal = VehicleSignal::Gear;
+    gear.canId = 0x3BC;
+    gear.startBit = 0;
+    gear.length = 4;
+    table.append(gear);
+
+    CanSignalDef turnSignal;
+    turnSignal.signal = VehicleSignal::TurnSignal;
+    turnSignal.canId = 0x614;
+    turnSignal.startBit = 0;
+    turnSignal.length = 2;
+    table.append(turnSignal);
+
+    CanSignalDef brake;
+    brake.signal = VehicleSignal::Brake;
+    brake.canId = 0x224;
+    brake.startBit = 5;
+    brake.length = 1;
+    table.append(brake);
+
+    return table;
+}
+
+/**
+ * @brief 从INI文件加载信号表
+ * @param path 配置文件路径
+ * @param ok 输出是否读取成功
+ * @return 信号表
+ */
+QVector<CanSignalDef> CanSignalDecoder::fromSettings(const QString& path, bool *ok)
+{
+    QVector<CanSignalDef> table;
+    if (ok)
+        *ok = false;
+
+    if (!QFile::exists(path)) {
+        std::cerr << "CAN信号表文件不存在: " << path.toStdString() << std::endl;
+        return table;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    const int size = settings.beginReadArray("signals");
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+
+        bool known = false;
+        bool idOk = false;
+        CanSignalDef def;
+        def.signal = vehicleSignalFromKey(settings.value("signal").toString(), &known);
+        // ID支持0x前缀的十六进制
+        def.canId = settings.value("id").toString().toUInt(&idOk, 0);
+        if (!known || !idOk) {
+            std::cerr << "CAN信号表第" << (i + 1) << "项的signal或id无效，已忽略" << std::endl;
+            continue;
+        }
+        def.startBit = settings.value("start", def.startBit).toInt();
+        def.length = settings.value("length", def.length).toInt();
+        def.bigEndian = settings.value("byteOrder", "intel").toString().compare("motorola", Qt::CaseInsensitive) == 0;
+        def.isSigned = settings.value("signed", def.isSigned).toBool();
+        def.factor = settings.value("factor", def.factor).toDouble();
+        def.offset = settings.value("offset", def.offset).toDouble();
+        table.append(def);
+    }
+    settings.endArray();
+
+    if (ok)
+        *ok = !table.isEmpty();
+    return table;
+}
+
+/**
+ * @brief 按信号定义从帧中提取物理值
+ * @param def 信号定义
+ * @param frame CAN帧
+ * @param value 输出物理值
+ * @return 帧长度是否足以包含该信号
+ *
+ * 8字节数据按字节序拼成一个64位整数后一次移位取出，不逐位循环
+ */
+bool CanSignalDecoder::extract(const CanSignalDef& def, const CanFrame& frame, double *value)
+{
+    quint64 word = 0;
+    int shift = 0;
+    int lastByte = 0;
+    if (def.bigEndian) {
+        for (int i = 0; i < 8; ++i) {
+            word = (word << 8) | frame.data[i];
+        }
+        const int msbPosition = (7 - def.startBit / 8) * 8 + def.startBit % 8;
+        shift = msbPosition - def.length + 1;
+        lastByte = 7 - shift / 8;
+    } else {
+        for (int i = 7; i >= 0; --i) {
+            word = (word << 8) | frame.data[i];
+        }
+        shift = def.startBit;
+        lastByte = (def.startBit + def.length - 1) / 8;
+    }
+    if (lastByte >= frame.length)
+        return false;
+
+    const quint64 mask = def.length == 64 ? ~quint64(0) : (quint64(1) << def.length) - 1;
+    const quint64 raw = (word >> shift) & mask;
+
+    double rawValue = static_cast<double>(raw);
+    if (def.isSigned && def.length < 64 && (raw >> (def.length - 1)) & 1) {
+        rawValue = static_cast<double>(static_cast<qint64>(raw | ~mask));
+    } else if (def.isSigned && def.length == 64) {
+        rawValue = static_cast<double>(static_cast<qint64>(raw));
+    }
+
+    *value = rawValue * def.factor + def.offset;
+    return true;
+}
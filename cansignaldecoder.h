@@ -0,0 +1,121 @@
+/**
+ * @file cansignaldecoder.h
+ * @brief 表驱动CAN信号解码器的头文件
+ *
+ * 该文件定义了CanSignalDecoder类，按DBC风格的信号表（ID、起始位、长度、字节序、
+ * 比例和偏移）从CAN帧中提取车辆信号，换车型只需要换信号表。
+ */
+#ifndef CANSIGNALDECODER_H
+#define CANSIGNALDECODER_H
+
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+#include "canframesource.h"
+#include "vehiclesignal.h"
+
+/**
+ * @struct CanSignalDef
+ * @brief 一个信号在CAN帧中的位置和换算方式
+ *
+ * 起始位的编号与DBC一致：Intel字节序为最低位的位置，Motorola字节序为最高位的位置，
+ * 第n字节的第m位（0为最低位）编号为n*8+m。物理值 = 原始值 * factor + offset
+ */
+struct CanSignalDef
+{
+    VehicleSignal signal = VehicleSignal::Count;    ///< 车辆信号
+    quint32 canId = 0;                              ///< 帧ID
+    int startBit = 0;                               ///< 起始位
+    int length = 8;                                 ///< 位长度（1~64）
+    bool bigEndian = false;                         ///< 是否为Motorola字节序
+    bool isSigned = false;                          ///< 是否为有符号数
+    double factor = 1.0;                            ///< 比例
+    double offset = 0.0;                            ///< 偏移
+};
+
+/**
+ * @class CanSignalDecoder
+ * @brief 表驱动CAN信号解码器
+ *
+ * 信号表按帧ID建立索引，每帧只查找一次哈希表，不关心的帧不做任何解析。
+ * 构造后只读，可在任意线程使用
+ */
+class CanSignalDecoder
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param table 信号表
+     */
+    explicit CanSignalDecoder(const QVector<CanSignalDef>& table = defaultTable());
+
+    /**
+     * @brief 示例车型的信号表
+     * @return 信号表
+     *
+     * 没有指定信号表文件时使用，实际车辆应通过fromSettings()加载对应车型的信号表
+     */
+    static QVector<CanSignalDef> defaultTable();
+
+    /**
+     * @brief 从INI文件加载信号表
+     * @param path 配置文件路径
+     * @param ok 输出是否读取成功
+     * @return 信号表，失败时为空
+     *
+     * 文件格式：
+     * @code
+     * [signals]
+     * size=1
+     * 1\signal=speed
+     * 1\id=0x3E9
+     * 1\start=7
+     * 1\length=16
+     * 1\byteOrder=motorola
+     * 1\signed=false
+     * 1\factor=0.01
+     * 1\offset=0
+     * @endcode
+     */
+    static QVector<CanSignalDef> fromSettings(const QString& path, bool *ok = nullptr);
+
+    /**
+     * @brief 解码一帧中的所有信号
+     * @param frame CAN帧
+     * @param callback 每解码出一个信号调用一次，参数为(VehicleSignal, double)
+     * @return 解码出的信号数量，不关心的帧返回0
+     */
+    template <typename Callback>
+    int decode(const CanFrame& frame, Callback&& callback) const
+    {
+        const auto it = m_index.constFind(frame.id);
+        if (it == m_index.constEnd())
+            return 0;
+
+        int decoded = 0;
+        for (int i = it->first; i < it->second; ++i) {
+            double value = 0.0;
+            if (extract(m_table[i], frame, &value)) {
+                callback(m_table[i].signal, value);
+                ++decoded;
+            }
+        }
+        return decoded;
+    }
+
+    /**
+     * @brief 按信号定义从帧中提取物理值
+     * @param def 信号定义
+     * @param frame CAN帧
+     * @param value 输出物理值
+     * @return 帧长度是否足以包含该信号
+     */
+    static bool extract(const CanSignalDef& def, const CanFrame& frame, double *value);
+
+private:
+    QVector<CanSignalDef> m_table;                  ///< 按帧ID排序的信号表
+    QHash<quint32, QPair<int, int>> m_index;        ///< 帧ID到信号表区间[first, second)的索引
+};
+
+#endif // CANSIGNALDECODER_H
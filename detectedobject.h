@@ -0,0 +1,65 @@
+/**
+ * @file detectedobject.h
+ * @brief 目标检测结果的头文件
+ *
+ * 该文件定义了ObjectClass和DetectedObject，是车辆/行人检测和跟踪的矢量结果，
+ * 由检测线程转换为叠加图元发布到画面块的叠加层，不写入画面像素。
+ */
+#ifndef DETECTEDOBJECT_H
+#define DETECTEDOBJECT_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 检测的目标类别
+ */
+enum class ObjectClass {
+    Person,         ///< 行人
+    Bicycle,        ///< 自行车
+    Car,            ///< 汽车
+    Motorcycle,     ///< 摩托车
+    Bus,            ///< 公交车
+    Truck           ///< 卡车
+};
+
+/**
+ * @brief 获取目标类别的显示名称
+ * @param objectClass 目标类别
+ * @return 名称
+ */
+inline QString objectClassName(ObjectClass objectClass)
+{
+    switch (objectClass) {
+    case ObjectClass::Person: return "行人";
+    case ObjectClass::Bicycle: return "自行车";
+    case ObjectClass::Car: return "汽车";
+    case ObjectClass::Motorcycle: return "摩托车";
+    case ObjectClass::Bus: return "公交车";
+    case ObjectClass::Truck: return "卡车";
+    }
+    return QString();
+}
+
+/**
+ * @struct DetectedObject
+ * @brief 一个被跟踪的目标
+ *
+ * 位置为相对画面宽高的比例（0~1），速度为每秒移动的比例，
+ * 两次推理之间由叠加层按速度外推到显示帧的采集时刻
+ */
+struct DetectedObject
+{
+    int trackId = -1;                       ///< 跟踪编号，未跟踪的检测结果为-1
+    ObjectClass objectClass = ObjectClass::Car; ///< 目标类别
+    float confidence = 0.0f;                ///< 置信度
+    QRectF box;                             ///< 目标框
+    QPointF velocity;                       ///< 目标框中心的速度
+    qint64 timeUs = 0;                      ///< box对应的采集时刻（单调时钟，微秒）
+};
+
+using DetectedObjects = QVector<DetectedObject>;    ///< 一个摄像头的全部目标
+
+#endif // DETECTEDOBJECT_H
@@ -0,0 +1,372 @@
+/**
+ * @file drivermonitor.cpp
+ * @brief 驾驶员疲劳监测线程的实现文件
+ */
+#include "drivermonitor.h"
+#include "frametiming.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+
+#include <iostream>
+#include <vector>
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// 等待新帧的最长时间，保证停止请求能及时得到响应
+constexpr int kWaitTimeoutMs = 200;
+
+// 没有人脸时完整检测的间隔（帧），驾驶员不在画面中时不必每帧都检测
+constexpr int kSearchInterval = 3;
+
+// 跟踪模板的宽度，模板匹配的开销与人脸在画面中的大小无关
+constexpr int kTemplateWidth = 24;
+
+// 模板匹配的最低相关系数，低于该值视为跟踪丢失
+constexpr double kTrackThreshold = 0.6;
+
+// 人脸级联的模型文件，以及按优先顺序排列的睁眼级联模型文件
+const char kFaceModel[] = "haarcascade_frontalface_default.xml";
+const char *const kEyeModels[] = {"haarcascade_eye_tree_eyeglasses.xml", "haarcascade_eye.xml"};
+
+/**
+ * @brief 把矩形向四周扩大
+ * @param rect 矩形
+ * @param fraction 每边扩大的比例（相对矩形宽高）
+ * @param bounds 裁剪范围
+ * @return 扩大并裁剪后的矩形
+ */
+cv::Rect expanded(const cv::Rect& rect, double fraction, const cv::Rect& bounds)
+{
+    const int dx = static_cast<int>(rect.width * fraction);
+    const int dy = static_cast<int>(rect.height * fraction);
+    return cv::Rect(rect.x - dx, rect.y - dy, rect.width + 2 * dx, rect.height + 2 * dy) & bounds;
+}
+
+} // namespace
+
+/**
+ * @brief DriverMonitor类的构造函数
+ * @param parent 父对象指针
+ */
+DriverMonitor::DriverMonitor(QObject *parent)
+    : QThread(parent)
+    , m_modelsLoaded(false)
+    , m_accepting(false)
+    , m_frameReady(false)
+    , m_trackScale(1.0)
+    , m_framesSinceDetect(kSearchInterval)
+    , m_lastEmitUs(0)
+    , m_detectInterval(kDefaultDetectInterval)
+    , m_processedFrames(0)
+    , m_detections(0)
+    , m_totalProcessUs(0)
+    , m_maxProcessUs(0)
+{
+    qRegisterMetaType<DriverEstimate>("DriverEstimate");
+}
+
+/**
+ * @brief DriverMonitor类的析构函数
+ */
+DriverMonitor::~DriverMonitor()
+{
+    stop();
+}
+
+/**
+ * @brief 模型的默认查找目录
+ * @return 目录列表
+ */
+QStringList DriverMonitor::defaultModelDirectories()
+{
+    return {
+        QCoreApplication::applicationDirPath() + "/models",
+        "/usr/share/opencv4/haarcascades",
+        "/usr/local/share/opencv4/haarcascades",
+        "/usr/share/opencv/haarcascades",
+        "/usr/local/share/opencv/haarcascades",
+    };
+}
+
+/**
+ * @brief 加载人脸和眼睛的级联模型
+ * @param directory 模型目录
+ * @return 是否加载成功
+ */
+bool DriverMonitor::loadModels(const QString& directory)
+{
+    m_modelsLoaded = false;
+    const QStringList directories = directory.isEmpty() ? defaultModelDirectories() : QStringList{directory};
+    for (const QString& path : directories) {
+        const QDir dir(path);
+        if (!QFile::exists(dir.filePath(kFaceModel)))
+            continue;
+
+        try {
+            if (!m_faceCascade.load(dir.filePath(kFaceModel).toStdString()))
+                continue;
+            for (const char *eyeModel : kEyeModels) {
+                if (QFile::exists(dir.filePath(eyeModel)) && m_eyeCascade.load(dir.filePath(eyeModel).toStdString())) {
+                    m_modelsLoaded = true;
+                    std::cout << "驾驶员监测模型: " << path.toStdString() << std::endl;
+                    return true;
+                }
+            }
+        } catch (const cv::Exception& e) {
+            std::cerr << "加载驾驶员监测模型失败: " << e.what() << std::endl;
+        }
+    }
+
+    std::cerr << "未找到人脸/眼睛级联模型，驾驶员疲劳检测未启用" << std::endl;
+    return false;
+}
+
+/**
+ * @brief 提交一帧画面
+ * @param frame 已解码的帧
+ *
+ * 解码结果通常已按显示尺寸缩小，这里的缩放和颜色转换只处理几十万像素
+ */
+void DriverMonitor::submit(const CameraFrame& frame)
+{
+    if (!m_accepting.load(std::memory_order_acquire) || frame.image.empty())
+        return;
+
+    AnalysisFrame& slot = m_mailbox.writeSlot();
+    try {
+        const cv::Mat *source = &frame.image;
+        if (frame.image.cols > kAnalysisWidth) {
+            const int height = qMax(1, frame.image.rows * kAnalysisWidth / frame.image.cols);
+            cv::resize(frame.image, slot.scaled, cv::Size(kAnalysisWidth, height), 0, 0, cv::INTER_AREA);
+            source = &slot.scaled;
+        }
+        if (source->channels() == 3) {
+            cv::cvtColor(*source, slot.gray, cv::COLOR_BGR2GRAY);
+        } else {
+            source->copyTo(slot.gray);
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "驾驶员监测帧转换异常: " << e.what() << std::endl;
+        return;
+    }
+    slot.captureTimeUs = frame.captureTimeUs;
+    m_mailbox.publish();
+
+    QMutexLocker locker(&m_wakeMutex);
+    m_frameReady = true;
+    m_wake.wakeOne();
+}
+
+/**
+ * @brief 停止线程
+ */
+void DriverMonitor::stop()
+{
+    requestInterruption();
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        m_wake.wakeAll();
+    }
+    wait();
+}
+
+/**
+ * @brief 获取平均每帧处理耗时
+ * @return 毫秒
+ */
+double DriverMonitor::meanProcessMs() const
+{
+    const quint64 frames = processedFrames();
+    return frames > 0 ? m_totalProcessUs.load(std::memory_order_relaxed) / 1000.0 / frames : 0.0;
+}
+
+/**
+ * @brief 线程主函数
+ *
+ * 每次启动都重新开始估计，停止期间的画面不计入
+ */
+void DriverMonitor::run()
+{
+    if (!m_modelsLoaded)
+        return;
+
+    m_estimator.reset();
+    m_face = cv::Rect();
+    m_framesSinceDetect = kSearchInterval;
+    m_lastEmitUs = 0;
+    m_accepting.store(true, std::memory_order_release);
+
+    while (!isInterruptionRequested()) {
+        {
+            QMutexLocker locker(&m_wakeMutex);
+            if (!m_frameReady) {
+                m_wake.wait(&m_wakeMutex, kWaitTimeoutMs);
+            }
+            if (!m_frameReady)
+                continue;
+            m_frameReady = false;
+        }
+        if (!m_mailbox.fetch())
+            continue;
+
+        const AnalysisFrame& frame = m_mailbox.readSlot();
+        const DriverEstimate estimate = processFrame(frame.gray, frame.captureTimeUs);
+        if (frame.captureTimeUs - m_lastEmitUs >= kEmitIntervalUs) {
+            m_lastEmitUs = frame.captureTimeUs;
+            emit estimateChanged(estimate);
+        }
+    }
+
+    m_accepting.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief 分析一帧灰度图并更新估计
+ * @param gray 灰度图
+ * @param timeUs 采集时刻
+ * @return 当前估计结果
+ *
+ * 每帧最多运行一次完整检测：跟踪成功时直到检测间隔用完才重新检测，跟踪丢失时立即检测
+ */
+DriverEstimate DriverMonitor::processFrame(const cv::Mat& gray, qint64 timeUs)
+{
+    const qint64 startUs = monotonicNowUs();
+
+    bool faceVisible = false;
+    bool closed = false;
+    try {
+        cv::equalizeHist(gray, m_equalized);
+
+        ++m_framesSinceDetect;
+        const int interval = m_detectInterval.load(std::memory_order_relaxed);
+        if (!m_face.empty() && m_framesSinceDetect < interval) {
+            faceVisible = trackFace(m_equalized);
+        }
+        if (!faceVisible && (!m_face.empty() || m_framesSinceDetect >= kSearchInterval)) {
+            m_framesSinceDetect = 0;
+            m_detections.fetch_add(1, std::memory_order_relaxed);
+            faceVisible = detectFace(m_equalized);
+        }
+        if (faceVisible) {
+            closed = eyesClosed(m_equalized);
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "驾驶员监测异常: " << e.what() << std::endl;
+        m_face = cv::Rect();
+        faceVisible = false;
+    }
+
+    m_estimator.addSample(timeUs, faceVisible, closed);
+
+    const qint64 elapsedUs = monotonicNowUs() - startUs;
+    m_processedFrames.fetch_add(1, std::memory_order_relaxed);
+    m_totalProcessUs.fetch_add(elapsedUs, std::memory_order_relaxed);
+    qint64 maxUs = m_maxProcessUs.load(std::memory_order_relaxed);
+    while (elapsedUs > maxUs && !m_maxProcessUs.compare_exchange_weak(maxUs, elapsedUs, std::memory_order_relaxed)) {
+    }
+
+    return m_estimator.estimate();
+}
+
+/**
+ * @brief 用级联检测人脸
+ * @param gray 灰度图
+ * @return 是否检测到
+ *
+ * 已有人脸位置时只搜索其周围一个人脸大小的范围，找不到时下一次再搜索整帧
+ */
+bool DriverMonitor::detectFace(const cv::Mat& gray)
+{
+    const cv::Rect bounds(0, 0, gray.cols, gray.rows);
+    const cv::Rect search = m_face.empty() ? bounds : expanded(m_face, 1.0, bounds);
+    const int minSide = qMax(24, gray.cols / 8);
+
+    std::vector<cv::Rect> faces;
+    m_faceCascade.detectMultiScale(gray(search), faces, 1.15, 3, 0, cv::Size(minSide, minSide));
+
+    // 驾驶员是画面中最大的人脸
+    cv::Rect best;
+    for (const cv::Rect& face : faces) {
+        if (face.area() > best.area()) {
+            best = face;
+        }
+    }
+    if (best.empty()) {
+        m_face = cv::Rect();
+        return false;
+    }
+
+    m_face = cv::Rect(best.x + search.x, best.y + search.y, best.width, best.height);
+    updateTemplate(gray);
+    return true;
+}
+
+/**
+ * @brief 从当前人脸区域更新跟踪模板
+ * @param gray 灰度图
+ */
+void DriverMonitor::updateTemplate(const cv::Mat& gray)
+{
+    m_trackScale = static_cast<double>(kTemplateWidth) / m_face.width;
+    const int height = qMax(1, qRound(m_face.height * m_trackScale));
+    cv::resize(gray(m_face), m_faceTemplate, cv::Size(kTemplateWidth, height), 0, 0, cv::INTER_AREA);
+}
+
+/**
+ * @brief 在上一次人脸位置附近跟踪人脸
+ * @param gray 灰度图
+ * @return 是否跟踪成功
+ *
+ * 搜索范围为人脸四周各半个人脸大小，缩小到模板的比例后做归一化相关匹配；人脸大小保持不变，
+ * 由下一次完整检测修正
+ */
+bool DriverMonitor::trackFace(const cv::Mat& gray)
+{
+    const cv::Rect bounds(0, 0, gray.cols, gray.rows);
+    const cv::Rect search = expanded(m_face, 0.5, bounds);
+    const cv::Size scaledSize(qRound(search.width * m_trackScale), qRound(search.height * m_trackScale));
+    if (scaledSize.width < m_faceTemplate.cols || scaledSize.height < m_faceTemplate.rows)
+        return false;
+
+    cv::resize(gray(search), m_searchScaled, scaledSize, 0, 0, cv::INTER_AREA);
+    cv::matchTemplate(m_searchScaled, m_faceTemplate, m_matchResult, cv::TM_CCOEFF_NORMED);
+
+    double score = 0.0;
+    cv::Point location;
+    cv::minMaxLoc(m_matchResult, nullptr, &score, nullptr, &location);
+    if (score < kTrackThreshold)
+        return false;
+
+    const cv::Rect moved(search.x + qRound(location.x / m_trackScale), search.y + qRound(location.y / m_trackScale),
+                         m_face.width, m_face.height);
+    m_face = moved & bounds;
+    // 人脸一半以上移出画面时视为丢失
+    return m_face.area() * 2 >= moved.area();
+}
+
+/**
+ * @brief 判断眼睛是否闭合
+ * @param gray 灰度图
+ * @return 眼部区域中没有检测到睁眼时为true
+ *
+ * 眼部区域取人脸框高度的20%~55%，睁眼级联对闭眼几乎没有响应，因此可以直接作为睁闭分类器
+ */
+bool DriverMonitor::eyesClosed(const cv::Mat& gray)
+{
+    const cv::Rect bounds(0, 0, gray.cols, gray.rows);
+    const cv::Rect band = cv::Rect(m_face.x + m_face.width / 10, m_face.y + m_face.height / 5,
+                                   m_face.width * 8 / 10, m_face.height * 35 / 100) & bounds;
+    const int minEye = qMax(8, m_face.width / 8);
+    const int maxEye = qMax(minEye + 1, m_face.width / 2);
+    if (band.width < minEye || band.height < minEye)
+        return false;
+
+    std::vector<cv::Rect> eyes;
+    m_eyeCascade.detectMultiScale(gray(band), eyes, 1.1, 3, 0, cv::Size(minEye, minEye), cv::Size(maxEye, maxEye));
+    return eyes.empty();
+}
@@ -0,0 +1,208 @@
+/**
+ * @file drivermonitor.h
+ * @brief 驾驶员疲劳监测线程的头文件
+ *
+ * 该文件定义了DriverMonitor类，在独立线程中分析驾驶员摄像头的画面：
+ * 人脸检测、人脸区域跟踪、眼睛睁闭分类，结果交给PerclosEstimator估计疲劳度。
+ */
+#ifndef DRIVERMONITOR_H
+#define DRIVERMONITOR_H
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+
+#include <opencv2/core.hpp>
+#include <opencv2/objdetect.hpp>
+
+#include "cameraframe.h"
+#include "frameanalyzer.h"
+#include "framemailbox.h"
+#include "perclosestimator.h"
+
+/**
+ * @class DriverMonitor
+ * @brief 驾驶员疲劳监测线程
+ *
+ * 驾驶员摄像头的解码线程通过submit()把每帧缩小为灰度图放入信箱，监测线程只处理最新一帧，
+ * 来不及处理的帧被覆盖，不会拖慢采集和显示。
+ * 完整的人脸检测（Haar级联）每隔若干帧或跟踪丢失时才运行一次，其余帧在上一次人脸位置附近
+ * 做模板匹配跟踪；眼睛睁闭由睁眼级联在人脸上部的眼部区域中判断，检测到睁眼即为睁眼。
+ * 全部处理只使用OpenCV的CPU实现，处理耗时单独统计。
+ * 估计结果最多每kEmitIntervalUs通过estimateChanged()发出一次
+ */
+class DriverMonitor : public QThread, public FrameAnalyzer
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit DriverMonitor(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，停止线程
+     */
+    ~DriverMonitor() override;
+
+    /**
+     * @brief 加载人脸和眼睛的级联模型（须在start()之前或stop()之后调用）
+     * @param directory 模型目录，为空时依次查找OpenCV的常见安装目录
+     * @return 是否加载成功
+     */
+    bool loadModels(const QString& directory = QString());
+
+    /**
+     * @brief 模型是否已加载
+     * @return 是否已加载
+     */
+    bool hasModels() const { return m_modelsLoaded; }
+
+    /**
+     * @brief 设置完整人脸检测的间隔（线程安全）
+     * @param frames 帧数，1表示每帧都检测
+     */
+    void setDetectInterval(int frames) { m_detectInterval.store(qMax(1, frames), std::memory_order_relaxed); }
+
+    /**
+     * @brief 提交一帧画面（由驾驶员摄像头的解码线程调用）
+     * @param frame 已解码的帧
+     *
+     * 在调用线程中缩小并转换为灰度图，监测线程未运行时直接返回
+     */
+    void submit(const CameraFrame& frame) override;
+
+    /**
+     * @brief 停止线程
+     */
+    void stop();
+
+    /**
+     * @brief 分析一帧灰度图并更新估计（仅监测线程或线程未运行时调用）
+     * @param gray 灰度图，宽度不超过kAnalysisWidth
+     * @param timeUs 采集时刻（单调时钟，微秒）
+     * @return 当前估计结果
+     */
+    DriverEstimate processFrame(const cv::Mat& gray, qint64 timeUs);
+
+    /**
+     * @brief 获取已处理的帧数（线程安全）
+     * @return 帧数
+     */
+    quint64 processedFrames() const { return m_processedFrames.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取完整人脸检测的次数（线程安全）
+     * @return 次数
+     */
+    quint64 detections() const { return m_detections.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取平均每帧处理耗时（线程安全）
+     * @return 毫秒
+     */
+    double meanProcessMs() const;
+
+    /**
+     * @brief 获取单帧最长处理耗时（线程安全）
+     * @return 毫秒
+     */
+    double maxProcessMs() const { return m_maxProcessUs.load(std::memory_order_relaxed) / 1000.0; }
+
+    static constexpr int kAnalysisWidth = 320;          ///< 分析用灰度图的宽度
+    static constexpr int kDefaultDetectInterval = 10;   ///< 默认的完整检测间隔（帧）
+    static constexpr qint64 kEmitIntervalUs = 500000;   ///< 估计结果的最短发出间隔
+
+signals:
+    /**
+     * @brief 估计结果更新
+     * @param estimate 估计结果
+     */
+    void estimateChanged(const DriverEstimate& estimate);
+
+protected:
+    /**
+     * @brief 线程主函数，等待并处理最新一帧
+     */
+    void run() override;
+
+private:
+    /**
+     * @struct AnalysisFrame
+     * @brief 信箱中的一帧分析用画面
+     */
+    struct AnalysisFrame
+    {
+        cv::Mat scaled;             ///< 缩小后的彩色图（中间结果，复用缓冲区）
+        cv::Mat gray;               ///< 灰度图
+        qint64 captureTimeUs = 0;   ///< 采集时刻
+    };
+
+    /**
+     * @brief 用级联检测人脸，有上一次的人脸位置时只在其附近检测
+     * @param gray 灰度图
+     * @return 是否检测到
+     */
+    bool detectFace(const cv::Mat& gray);
+
+    /**
+     * @brief 在上一次人脸位置附近跟踪人脸
+     * @param gray 灰度图
+     * @return 是否跟踪成功
+     */
+    bool trackFace(const cv::Mat& gray);
+
+    /**
+     * @brief 判断眼睛是否闭合
+     * @param gray 灰度图
+     * @return 眼部区域中没有检测到睁眼时为true
+     */
+    bool eyesClosed(const cv::Mat& gray);
+
+    /**
+     * @brief 从当前人脸区域更新跟踪模板
+     * @param gray 灰度图
+     */
+    void updateTemplate(const cv::Mat& gray);
+
+    /**
+     * @brief 模型的默认查找目录
+     * @return 目录列表
+     */
+    static QStringList defaultModelDirectories();
+
+    cv::CascadeClassifier m_faceCascade;    ///< 人脸级联
+    cv::CascadeClassifier m_eyeCascade;     ///< 睁眼级联
+    bool m_modelsLoaded;                    ///< 模型是否已加载
+
+    FrameMailbox<AnalysisFrame> m_mailbox;  ///< 最新帧信箱
+    std::atomic<bool> m_accepting;          ///< 线程是否在运行并接收新帧
+    QMutex m_wakeMutex;                     ///< 唤醒互斥锁
+    QWaitCondition m_wake;                  ///< 新帧通知
+    bool m_frameReady;                      ///< 是否有未处理的新帧（受m_wakeMutex保护）
+
+    // 以下仅监测线程访问
+    cv::Rect m_face;                        ///< 当前人脸区域，空表示未找到
+    cv::Mat m_faceTemplate;                 ///< 跟踪模板，宽度为kTemplateWidth
+    double m_trackScale;                    ///< 跟踪模板相对原图的缩放比例
+    cv::Mat m_equalized;                    ///< 直方图均衡后的灰度图（复用缓冲区）
+    cv::Mat m_searchScaled;                 ///< 缩放后的跟踪搜索区域（复用缓冲区）
+    cv::Mat m_matchResult;                  ///< 模板匹配结果（复用缓冲区）
+    int m_framesSinceDetect;                ///< 距上一次完整检测的帧数
+    PerclosEstimator m_estimator;           ///< PERCLOS估计
+    qint64 m_lastEmitUs;                    ///< 上一次发出估计结果的时刻
+
+    std::atomic<int> m_detectInterval;      ///< 完整检测间隔（帧）
+    std::atomic<quint64> m_processedFrames; ///< 已处理的帧数
+    std::atomic<quint64> m_detections;      ///< 完整检测次数
+    std::atomic<qint64> m_totalProcessUs;   ///< 处理耗时总和
+    std::atomic<qint64> m_maxProcessUs;     ///< 单帧最长处理耗时
+};
+
+#endif // DRIVERMONITOR_H
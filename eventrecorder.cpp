@@ -0,0 +1,336 @@
+/**
+ * @file eventrecorder.cpp
+ * @brief 报警事件录像器的实现文件
+ */
+#include "eventrecorder.h"
+#include "frametiming.h"
+#include "sessionwriter.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// 每个摄像头环形缓存的字节上限，防止高码率摄像头占满内存
+constexpr qint64 kMaxRingBytes = 256LL * 1024 * 1024;
+
+// 写入队列中事件后新帧的字节上限，超过时丢弃新帧
+constexpr qint64 kMaxQueuedBytes = 128LL * 1024 * 1024;
+
+// 录像结束时刻过后再等待多久，仍未送来新帧的摄像头由写入线程结束
+constexpr qint64 kEndGraceUs = 2000000;
+
+// 写入线程空闲时检查是否有摄像头需要结束的间隔
+constexpr unsigned long kEndCheckIntervalMs = 500;
+
+} // namespace
+
+/**
+ * @brief EventRecorder类的构造函数
+ * @param cameraNames 各摄像头的名称
+ * @param preEventUs 事件前缓存时长
+ * @param postEventUs 事件后录像时长
+ * @param parent 父对象指针
+ */
+EventRecorder::EventRecorder(const QStringList& cameraNames, qint64 preEventUs, qint64 postEventUs,
+                             QObject *parent)
+    : QThread(parent)
+    , m_cameraNames(cameraNames)
+    , m_preEventUs(preEventUs)
+    , m_postEventUs(postEventUs)
+    , m_recordUntilUs(0)
+    , m_droppedFrames(0)
+    , m_queuedBytes(0)
+    , m_directory("recordings")
+    , m_stopping(false)
+{
+    for (int i = 0; i < cameraNames.size(); ++i) {
+        m_rings.push_back(std::make_unique<CameraRing>());
+    }
+}
+
+/**
+ * @brief EventRecorder类的析构函数
+ */
+EventRecorder::~EventRecorder()
+{
+    stop();
+}
+
+/**
+ * @brief 设置录像保存目录
+ * @param directory 目录路径
+ */
+void EventRecorder::setDirectory(const QString& directory)
+{
+    QMutexLocker locker(&m_queueMutex);
+    m_directory = directory;
+}
+
+/**
+ * @brief 记录一帧采集到的帧
+ * @param camera 摄像头索引
+ * @param frame 采集到的帧
+ *
+ * 只拷贝一次压缩数据；写入队列与缓存共享同一份数据
+ */
+void EventRecorder::record(int camera, const CameraFrame& frame)
+{
+    if (camera < 0 || camera >= static_cast<int>(m_rings.size()))
+        return;
+    if (frame.raw.empty() || frame.rawFormat != FOURCC_MJPG)
+        return;
+
+    const BufferedFrame buffered{frame.captureTimeUs,
+                                 QByteArray(reinterpret_cast<const char*>(frame.raw.data),
+                                            static_cast<int>(frame.raw.total() * frame.raw.elemSize()))};
+
+    CameraRing& ring = *m_rings[camera];
+    QMutexLocker locker(&ring.mutex);
+    ring.frames.push_back(buffered);
+    ring.bytes += buffered.data.size();
+    while (ring.frames.size() > 1
+           && (buffered.timeUs - ring.frames.front().timeUs > m_preEventUs || ring.bytes > kMaxRingBytes)) {
+        ring.bytes -= ring.frames.front().data.size();
+        ring.frames.pop_front();
+    }
+
+    if (ring.event.isEmpty())
+        return;
+
+    if (buffered.timeUs <= m_recordUntilUs.load(std::memory_order_relaxed)) {
+        ring.lastEvent = ring.event;
+        ring.lastQueuedUs = buffered.timeUs;
+        enqueue(WriteJob{camera, ring.event, buffered.timeUs, buffered.data}, true);
+    } else {
+        // 事件录像时间已到，通知写入线程该摄像头已结束
+        enqueue(WriteJob{camera, ring.event, buffered.timeUs, QByteArray()}, false);
+        ring.event.clear();
+    }
+}
+
+/**
+ * @brief 触发一次事件录像
+ *
+ * 上一个事件仍在录像时沿用其事件名，所有摄像头始终写入同一个事件，不会在两个文件之间交替。
+ * 未在录像的摄像头把缓存中的帧排入写入队列，已为本事件排过的帧不再重复，
+ * 之后的帧由record()继续排入；仍在录像旧事件的摄像头先结束旧事件
+ */
+void EventRecorder::trigger()
+{
+    const qint64 nowUs = monotonicNowUs();
+    const bool joining = !m_activeEvent.isEmpty() && nowUs <= m_recordUntilUs.load(std::memory_order_relaxed);
+    if (!joining) {
+        m_activeEvent = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss_zzz");
+    }
+    m_recordUntilUs.store(nowUs + m_postEventUs, std::memory_order_relaxed);
+    if (!isRunning()) {
+        start(QThread::LowPriority);
+    }
+
+    const QString& event = m_activeEvent;
+    for (int camera = 0; camera < static_cast<int>(m_rings.size()); ++camera) {
+        CameraRing& ring = *m_rings[camera];
+        QMutexLocker locker(&ring.mutex);
+        if (ring.event == event)
+            continue;
+        if (!ring.event.isEmpty()) {
+            enqueue(WriteJob{camera, ring.event, ring.lastQueuedUs, QByteArray()}, false);
+            ring.event.clear();
+        }
+        if (ring.frames.empty())
+            continue;
+
+        ring.event = event;
+        for (const BufferedFrame& buffered : ring.frames) {
+            if (ring.lastEvent == event && buffered.timeUs <= ring.lastQueuedUs)
+                continue;
+            enqueue(WriteJob{camera, event, buffered.timeUs, buffered.data}, false);
+        }
+        ring.lastEvent = event;
+        ring.lastQueuedUs = qMax(ring.lastQueuedUs, ring.frames.back().timeUs);
+    }
+    std::cout << (joining ? "事件录像延长: " : "事件录像开始: ") << event.toStdString() << std::endl;
+}
+
+/**
+ * @brief 写完已排队的数据并停止线程
+ */
+void EventRecorder::stop()
+{
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_stopping = true;
+        m_queueReady.wakeAll();
+    }
+    wait();
+}
+
+/**
+ * @brief 把一项加入写入队列
+ * @param job 写入项
+ * @param droppable 是否可以丢弃
+ *
+ * 事件前缓存的数据已经在内存中，总是排入；事件后的新帧在队列过长时丢弃
+ */
+void EventRecorder::enqueue(WriteJob job, bool droppable)
+{
+    QMutexLocker locker(&m_queueMutex);
+    if (droppable) {
+        if (m_queuedBytes + job.data.size() > kMaxQueuedBytes) {
+            m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_queuedBytes += job.data.size();
+        job.counted = true;
+    }
+    m_queue.push_back(std::move(job));
+    m_queueReady.wakeOne();
+}
+
+/**
+ * @brief 写入线程主循环
+ *
+ * 等待新数据时带超时，定期结束断开或停滞的摄像头，事件文件不会因等不到新帧而一直无法打开。
+ * 停止时先写完队列中的数据，再关闭所有文件
+ */
+void EventRecorder::run()
+{
+    qint64 nextEndCheckUs = 0;
+    for (;;) {
+        WriteJob job;
+        bool haveJob = false;
+        {
+            QMutexLocker locker(&m_queueMutex);
+            if (m_queue.empty() && !m_stopping) {
+                m_queueReady.wait(&m_queueMutex, kEndCheckIntervalMs);
+            }
+            if (m_queue.empty() && m_stopping)
+                break;
+            if (!m_queue.empty()) {
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+                if (job.counted) {
+                    m_queuedBytes -= job.data.size();
+                }
+                haveJob = true;
+            }
+        }
+        if (haveJob) {
+            process(job);
+        }
+
+        const qint64 nowUs = monotonicNowUs();
+        if (nowUs >= nextEndCheckUs) {
+            endExpiredCameras(nowUs);
+            nextEndCheckUs = nowUs + static_cast<qint64>(kEndCheckIntervalMs) * 1000;
+        }
+    }
+
+    while (!m_sessions.empty()) {
+        finishSession(m_sessions.begin()->first);
+    }
+}
+
+/**
+ * @brief 结束录像时间已过却仍未送来新帧的摄像头
+ * @param nowUs 当前时刻（单调时钟，微秒）
+ *
+ * 摄像头通常在送来录像结束时刻之后的第一帧时自行结束；断开或停滞的摄像头不再送帧，
+ * 宽限期过后由这里代为排入结束标记，该事件的所有摄像头结束后文件即被写完关闭。
+ * 与record()相同，先持有缓存锁再排队
+ */
+void EventRecorder::endExpiredCameras(qint64 nowUs)
+{
+    for (int camera = 0; camera < static_cast<int>(m_rings.size()); ++camera) {
+        CameraRing& ring = *m_rings[camera];
+        QMutexLocker locker(&ring.mutex);
+        if (ring.event.isEmpty() || nowUs <= m_recordUntilUs.load(std::memory_order_relaxed) + kEndGraceUs)
+            continue;
+        enqueue(WriteJob{camera, ring.event, ring.lastQueuedUs, QByteArray()}, false);
+        ring.event.clear();
+    }
+}
+
+/**
+ * @brief 在写入线程中处理一项
+ * @param job 写入项
+ *
+ * 每个事件有自己的会话文件，该事件的所有摄像头都结束后关闭文件；
+ * 新旧两个事件的数据在队列中交错时分别写入各自的文件
+ */
+void EventRecorder::process(const WriteJob& job)
+{
+    if (job.data.isEmpty()) {
+        const auto it = m_sessions.find(job.event);
+        if (it == m_sessions.end())
+            return;
+        it->second.cameras[job.camera] = false;
+        if (std::find(it->second.cameras.begin(), it->second.cameras.end(), true) == it->second.cameras.end()) {
+            finishSession(job.event);
+        }
+        return;
+    }
+
+    auto it = m_sessions.find(job.event);
+    EventSession& session = it != m_sessions.end() ? it->second : openSession(job.event);
+    if (session.writer->isOpen()) {
+        session.cameras[job.camera] = true;
+        session.writer->addFrame(job.camera, job.timeUs, job.data, FOURCC_MJPG);
+    }
+}
+
+/**
+ * @brief 打开事件的会话文件
+ * @param event 事件名
+ * @return 会话
+ */
+EventRecorder::EventSession& EventRecorder::openSession(const QString& event)
+{
+    QString directory;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        directory = m_directory;
+    }
+    QDir().mkpath(directory);
+
+    QString path = QDir(directory).filePath(QString("event_%1.adss").arg(event));
+    for (int suffix = 2; QFileInfo::exists(path); ++suffix) {
+        path = QDir(directory).filePath(QString("event_%1_%2.adss").arg(event).arg(suffix));
+    }
+
+    EventSession& session = m_sessions[event];
+    session.writer = std::make_unique<SessionWriter>();
+    session.cameras.assign(m_cameraNames.size(), false);
+    // 打开失败时仍保留会话，丢弃本次事件的后续数据
+    if (!session.writer->open(path, m_cameraNames)) {
+        std::cerr << "无法创建录像文件: " << path.toStdString() << std::endl;
+    }
+    return session;
+}
+
+/**
+ * @brief 写完并关闭一个事件的会话文件
+ * @param event 事件名
+ */
+void EventRecorder::finishSession(const QString& event)
+{
+    const auto it = m_sessions.find(event);
+    if (it == m_sessions.end())
+        return;
+
+    SessionWriter& writer = *it->second.writer;
+    if (writer.isOpen()) {
+        const quint64 frames = writer.frameCount();
+        if (writer.finish()) {
+            std::cout << "事件录像已保存: " << writer.fileName().toStdString()
+                      << "（" << frames << "帧）" << std::endl;
+        }
+    }
+    m_sessions.erase(it);
+}
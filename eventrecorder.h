@@ -0,0 +1,200 @@
+/**
+ * @file eventrecorder.h
+ * @brief 报警事件录像器的头文件
+ *
+ * 该文件定义了EventRecorder类，它在内存中为每个摄像头保留最近一段时间的
+ * MJPEG压缩帧，报警时把事件前的缓存和事件后的帧原样写入会话文件，不重新编码。
+ */
+#ifndef EVENTRECORDER_H
+#define EVENTRECORDER_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "cameraframe.h"
+
+class SessionWriter;
+
+/**
+ * @class EventRecorder
+ * @brief 带事件前缓存的MJPEG直通录像器
+ *
+ * 采集线程调用record()把压缩帧拷贝进各自的环形缓存，只持有很短的锁；
+ * 界面线程调用trigger()开始一次事件录像，所有摄像头写入同一个会话文件（见sessionformat.h），
+ * 录像进行中的再次触发加入当前事件并延长录像时间。
+ * 所有磁盘写入都在录像器自己的线程中由SessionWriter按64KB对齐的批次进行，
+ * 写入跟不上时丢弃事件后的新帧并计数，采集和显示从不等待磁盘。
+ * 录像结束后仍未送来新帧（断开或停滞）的摄像头由写入线程在宽限期后结束，文件及时写完。
+ * 只有帧源给出MJPEG压缩数据的摄像头会被录像。
+ */
+class EventRecorder : public QThread
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param cameraNames 各摄像头的名称（含驾驶员摄像头），写入会话文件
+     * @param preEventUs 事件前缓存时长（微秒），默认30秒
+     * @param postEventUs 事件后录像时长（微秒），默认10秒
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit EventRecorder(const QStringList& cameraNames, qint64 preEventUs = 30000000, qint64 postEventUs = 10000000,
+                           QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，写完已排队的数据后停止线程
+     */
+    ~EventRecorder() override;
+
+    /**
+     * @brief 设置录像保存目录（线程安全）
+     * @param directory 目录路径，不存在时在第一次写入时创建
+     */
+    void setDirectory(const QString& directory);
+
+    /**
+     * @brief 记录一帧采集到的帧（仅采集线程调用，不会等待磁盘）
+     * @param camera 摄像头索引
+     * @param frame 采集到的帧，只处理MJPEG压缩数据
+     */
+    void record(int camera, const CameraFrame& frame);
+
+    /**
+     * @brief 触发一次事件录像（仅界面线程调用）
+     *
+     * 事件录像进行中再次触发时加入当前事件：延长录像时间，已结束或尚未加入的摄像头
+     * 以当前事件名补排缓存中尚未写过的帧
+     */
+    void trigger();
+
+    /**
+     * @brief 写完已排队的数据并停止线程
+     */
+    void stop();
+
+    /**
+     * @brief 写入跟不上而丢弃的帧数
+     * @return 帧数
+     */
+    quint64 droppedFrames() const { return m_droppedFrames.load(std::memory_order_relaxed); }
+
+protected:
+    /**
+     * @brief 写入线程主循环
+     */
+    void run() override;
+
+private:
+    /**
+     * @struct BufferedFrame
+     * @brief 环形缓存中的一帧
+     */
+    struct BufferedFrame
+    {
+        qint64 timeUs;          ///< 采集时刻（单调时钟，微秒）
+        QByteArray data;        ///< JPEG数据，与写入队列隐式共享
+    };
+
+    /**
+     * @struct CameraRing
+     * @brief 单个摄像头的事件前缓存
+     */
+    struct CameraRing
+    {
+        QMutex mutex;                           ///< 保护以下字段
+        std::deque<BufferedFrame> frames;       ///< 按时间排列的缓存帧
+        qint64 bytes = 0;                       ///< 缓存的总字节数
+        QString event;                          ///< 正在录像的事件名，为空表示未在录像
+        QString lastEvent;                      ///< 最近一次排入写入队列的事件名
+        qint64 lastQueuedUs = 0;                ///< 最近一次排入写入队列的帧的采集时刻
+    };
+
+    /**
+     * @struct EventSession
+     * @brief 一个事件正在写的会话文件
+     */
+    struct EventSession
+    {
+        std::unique_ptr<SessionWriter> writer;  ///< 会话文件
+        std::vector<bool> cameras;              ///< 尚未结束录像的摄像头
+    };
+
+    /**
+     * @struct WriteJob
+     * @brief 写入队列中的一项
+     */
+    struct WriteJob
+    {
+        int camera = 0;         ///< 摄像头索引
+        QString event;          ///< 事件名
+        qint64 timeUs = 0;      ///< 采集时刻
+        QByteArray data;        ///< JPEG数据，为空表示该摄像头的事件录像结束
+        bool counted = false;   ///< 是否计入了队列字节数
+    };
+
+    /**
+     * @brief 把一项加入写入队列
+     * @param job 写入项
+     * @param droppable 队列超过上限时是否可以丢弃
+     */
+    void enqueue(WriteJob job, bool droppable);
+
+    /**
+     * @brief 结束录像时间已过却仍未送来新帧的摄像头（仅写入线程调用）
+     * @param nowUs 当前时刻（单调时钟，微秒）
+     */
+    void endExpiredCameras(qint64 nowUs);
+
+    /**
+     * @brief 在写入线程中处理一项
+     * @param job 写入项
+     */
+    void process(const WriteJob& job);
+
+    /**
+     * @brief 打开事件的会话文件
+     * @param event 事件名
+     * @return 会话，打开失败时writer未打开，丢弃该事件的后续数据
+     *
+     * 同名文件已存在（同一事件的文件已关闭后又有数据到来）时加序号另存，从不覆盖已写的录像
+     */
+    EventSession& openSession(const QString& event);
+
+    /**
+     * @brief 写完并关闭一个事件的会话文件
+     * @param event 事件名
+     */
+    void finishSession(const QString& event);
+
+    QStringList m_cameraNames;                          ///< 摄像头名称
+    qint64 m_preEventUs;                                ///< 事件前缓存时长
+    qint64 m_postEventUs;                               ///< 事件后录像时长
+    std::vector<std::unique_ptr<CameraRing>> m_rings;   ///< 各摄像头的缓存
+    std::atomic<qint64> m_recordUntilUs;                ///< 事件录像的结束时刻
+    std::atomic<quint64> m_droppedFrames;               ///< 丢弃的帧数
+    QString m_activeEvent;                              ///< 最近一次触发的事件名（仅界面线程访问）
+
+    // 写入队列，以下字段由m_queueMutex保护
+    QMutex m_queueMutex;                                ///< 写入队列互斥锁
+    QWaitCondition m_queueReady;                        ///< 新数据通知
+    std::deque<WriteJob> m_queue;                       ///< 待写入的数据
+    qint64 m_queuedBytes;                               ///< 事件后新帧占用的字节数
+    QString m_directory;                                ///< 录像保存目录
+    bool m_stopping;                                    ///< 是否正在停止
+
+    // 以下字段仅写入线程访问
+    std::map<QString, EventSession> m_sessions;         ///< 各事件正在写的会话文件
+};
+
+#endif // EVENTRECORDER_H
@@ -0,0 +1,154 @@
+/**
+ * @file fatiguemeter.cpp
+ * @brief 疲劳度表控件的实现文件
+ */
+#include "fatiguemeter.h"
+#include "styles.h"
+
+#include <QPainter>
+
+#include <cmath>
+
+namespace {
+
+// 段数
+constexpr int kSegmentCount = 20;
+
+// 段间距
+constexpr int kSegmentGap = 2;
+
+// 控件四周的留白
+constexpr int kMargin = 3;
+
+// 右侧百分比文字区域的宽度（按"100%"估算的字符数）
+constexpr int kTextChars = 5;
+
+} // namespace
+
+/**
+ * @brief FatigueMeter类的构造函数
+ * @param parent 父窗口指针
+ */
+FatigueMeter::FatigueMeter(QWidget *parent)
+    : GaugeWidget(parent)
+{
+    m_valueText.setTextFormat(Qt::PlainText);
+    setRange(0, 100);
+    setMinimumHeight(16);
+}
+
+/**
+ * @brief 推荐尺寸
+ * @return 尺寸
+ */
+QSize FatigueMeter::sizeHint() const
+{
+    return QSize(160, 22);
+}
+
+/**
+ * @brief 值对应的点亮段数
+ * @param value 值
+ * @return 段数，向上取整，非零的值至少点亮一段
+ */
+int FatigueMeter::litSegments(int value) const
+{
+    return static_cast<int>(std::ceil(fraction(value) * kSegmentCount - 1e-9));
+}
+
+/**
+ * @brief 段的颜色
+ * @param index 段索引
+ * @return 前50%为正常色，50%~70%为注意色，其余为警告色，与DriverCondition的阈值一致
+ */
+QColor FatigueMeter::segmentColor(int index) const
+{
+    const double upper = static_cast<double>(index + 1) / kSegmentCount;
+    if (upper <= 0.5)
+        return STATUS_OK_COLOR;
+    if (upper <= 0.7)
+        return STATUS_WARNING_COLOR;
+    return STATUS_DANGER_COLOR;
+}
+
+/**
+ * @brief 按新尺寸计算各段和文字区域的位置
+ */
+void FatigueMeter::layoutChanged()
+{
+    const QRect area = rect().adjusted(kMargin, kMargin, -kMargin, -kMargin);
+    const int textWidth = fontMetrics().averageCharWidth() * kTextChars;
+    m_textRect = QRect(area.right() - textWidth + 1, area.top(), textWidth, area.height());
+
+    const int barWidth = qMax(kSegmentCount, area.width() - textWidth - kSegmentGap);
+    m_segments.clear();
+    m_segments.reserve(kSegmentCount);
+    for (int i = 0; i < kSegmentCount; ++i) {
+        const int left = area.left() + barWidth * i / kSegmentCount;
+        const int right = area.left() + barWidth * (i + 1) / kSegmentCount - kSegmentGap;
+        m_segments.append(QRect(QPoint(left, area.top()), QPoint(qMax(left, right), area.bottom())));
+    }
+
+    valueChanged();
+}
+
+/**
+ * @brief 值变化时重新排版百分比文字
+ */
+void FatigueMeter::valueChanged()
+{
+    m_valueText.setText(QString("%1%").arg(value()));
+    m_valueText.prepare(QTransform(), font());
+}
+
+/**
+ * @brief 绘制全部未点亮的段
+ * @param painter 缓存位图的绘制器
+ */
+void FatigueMeter::paintBackground(QPainter& painter)
+{
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(GAUGE_TRACK_COLOR);
+    for (const QRect& segment : m_segments) {
+        painter.drawRect(segment);
+    }
+}
+
+/**
+ * @brief 绘制点亮的段和百分比文字
+ * @param painter 控件的绘制器
+ */
+void FatigueMeter::paintValue(QPainter& painter)
+{
+    // 段和文字都是轴对齐的，不需要抗锯齿
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setPen(Qt::NoPen);
+    const int lit = qMin(litSegments(value()), static_cast<int>(m_segments.size()));
+    for (int i = 0; i < lit; ++i) {
+        painter.fillRect(m_segments[i], segmentColor(i));
+    }
+
+    const QSizeF size = m_valueText.size();
+    painter.setPen(TEXT_COLOR);
+    painter.drawStaticText(QPointF(m_textRect.right() - size.width(),
+                                   m_textRect.center().y() - size.height() / 2.0), m_valueText);
+}
+
+/**
+ * @brief 计算值变化时需要重绘的区域
+ * @param oldValue 旧值
+ * @param newValue 新值
+ * @return 点亮状态发生变化的段加上文字区域
+ */
+QRegion FatigueMeter::changedRegion(int oldValue, int newValue) const
+{
+    QRegion region(m_textRect);
+    const int oldLit = litSegments(oldValue);
+    const int newLit = litSegments(newValue);
+    const int from = qMax(0, qMin(oldLit, newLit));
+    const int to = qMin(static_cast<int>(m_segments.size()), qMax(oldLit, newLit));
+    for (int i = from; i < to; ++i) {
+        region += m_segments[i];
+    }
+    return region;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file fatiguemeter.h
+ * @brief 疲劳度表控件的头文件
+ */
+#ifndef FATIGUEMETER_H
+#define FATIGUEMETER_H
+
+#include <QStaticText>
+#include <QVector>
+
+#include "gaugewidget.h"
+
+/**
+ * @class FatigueMeter
+ * @brief 分段式疲劳度表
+ *
+ * 由若干段组成，按所在位置分别为正常、注意和警告颜色。
+ * 底图缓存全部未点亮的段；值变化时只重绘点亮数量发生变化的段和右侧的百分比文字
+ */
+class FatigueMeter : public GaugeWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父窗口指针，默认为nullptr
+     */
+    explicit FatigueMeter(QWidget *parent = nullptr);
+
+    /**
+     * @brief 推荐尺寸
+     * @return 尺寸
+     */
+    QSize sizeHint() const override;
+
+protected:
+    void paintBackground(QPainter& painter) override;
+    void paintValue(QPainter& painter) override;
+    QRegion changedRegion(int oldValue, int newValue) const override;
+    void valueChanged() override;
+    void layoutChanged() override;
+
+private:
+    /**
+     * @brief 值对应的点亮段数
+     * @param value 值
+     * @return 段数
+     */
+    int litSegments(int value) const;
+
+    /**
+     * @brief 段的颜色
+     * @param index 段索引
+     * @return 颜色
+     */
+    QColor segmentColor(int index) const;
+
+    QVector<QRect> m_segments;  ///< 各段的位置
+    QRect m_textRect;           ///< 百分比文字区域
+    QStaticText m_valueText;    ///< 当前百分比文字
+};
+
+#endif // FATIGUEMETER_H
@@ -0,0 +1,32 @@
+/**
+ * @file frameanalyzer.h
+ * @brief 帧分析器接口的头文件
+ *
+ * 该文件定义了FrameAnalyzer接口，驾驶员监测、车道线检测等分析模块通过它
+ * 从采集线程接收解码后的帧，采集线程不需要知道具体的分析模块。
+ */
+#ifndef FRAMEANALYZER_H
+#define FRAMEANALYZER_H
+
+#include "cameraframe.h"
+
+/**
+ * @class FrameAnalyzer
+ * @brief 帧分析器接口
+ *
+ * submit()在解码线程中、帧发布到信箱之前调用，实现应只取走自己需要的缩小副本后立即返回，
+ * 分析本身在分析器自己的线程中进行
+ */
+class FrameAnalyzer
+{
+public:
+    virtual ~FrameAnalyzer() = default;
+
+    /**
+     * @brief 提交一帧解码后的画面
+     * @param frame 已解码的帧，调用返回后不得再访问
+     */
+    virtual void submit(const CameraFrame& frame) = 0;
+};
+
+#endif // FRAMEANALYZER_H
@@ -0,0 +1,66 @@
+/**
+ * @file framecopycounter.cpp
+ * @brief 帧数据分配与拷贝计数器的实现文件
+ */
+#include "framecopycounter.h"
+
+#include <atomic>
+
+namespace {
+// 计数只用于统计，使用relaxed顺序即可
+std::atomic<quint64> g_frames{0};
+std::atomic<quint64> g_allocations{0};
+std::atomic<quint64> g_pixelPasses{0};
+std::atomic<quint64> g_bytesTouched{0};
+}
+
+/**
+ * @brief 记录一帧已送往显示
+ */
+void FrameCopyCounter::recordFrame()
+{
+    g_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 记录一次整帧缓冲区分配
+ */
+void FrameCopyCounter::recordAllocation()
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 记录一次整帧像素遍历
+ * @param bytes 遍历的字节数
+ */
+void FrameCopyCounter::recordPixelPass(qint64 bytes)
+{
+    g_pixelPasses.fetch_add(1, std::memory_order_relaxed);
+    g_bytesTouched.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed);
+}
+
+/**
+ * @brief 获取当前计数
+ * @return 计数器快照
+ */
+FrameCopyCounter::Snapshot FrameCopyCounter::snapshot()
+{
+    Snapshot result;
+    result.frames = g_frames.load(std::memory_order_relaxed);
+    result.allocations = g_allocations.load(std::memory_order_relaxed);
+    result.pixelPasses = g_pixelPasses.load(std::memory_order_relaxed);
+    result.bytesTouched = g_bytesTouched.load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief 清零所有计数
+ */
+void FrameCopyCounter::reset()
+{
+    g_frames.store(0, std::memory_order_relaxed);
+    g_allocations.store(0, std::memory_order_relaxed);
+    g_pixelPasses.store(0, std::memory_order_relaxed);
+    g_bytesTouched.store(0, std::memory_order_relaxed);
+}
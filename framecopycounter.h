@@ -0,0 +1,74 @@
+/**
+ * @file framecopycounter.h
+ * @brief 帧数据分配与拷贝计数器的头文件
+ *
+ * 该文件定义了FrameCopyCounter类，用于统计显示路径上每帧发生的
+ * 内存分配次数和整帧像素遍历（拷贝/转换）次数，验证零拷贝优化效果。
+ */
+#ifndef FRAMECOPYCOUNTER_H
+#define FRAMECOPYCOUNTER_H
+
+#include <QtGlobal>
+
+/**
+ * @class FrameCopyCounter
+ * @brief 全局的帧分配/拷贝计数器
+ *
+ * 所有接口均为静态且线程安全，采集线程和界面线程都可以直接调用。
+ */
+class FrameCopyCounter
+{
+public:
+    /**
+     * @struct Snapshot
+     * @brief 计数器快照
+     */
+    struct Snapshot
+    {
+        quint64 frames = 0;         ///< 已显示的帧数
+        quint64 allocations = 0;    ///< 整帧缓冲区分配次数
+        quint64 pixelPasses = 0;    ///< 整帧像素遍历次数
+        quint64 bytesTouched = 0;   ///< 像素遍历涉及的字节数
+
+        /**
+         * @brief 每帧平均像素遍历次数
+         * @return 平均次数，没有帧时返回0
+         */
+        double passesPerFrame() const { return frames ? double(pixelPasses) / frames : 0.0; }
+
+        /**
+         * @brief 每帧平均分配次数
+         * @return 平均次数，没有帧时返回0
+         */
+        double allocationsPerFrame() const { return frames ? double(allocations) / frames : 0.0; }
+    };
+
+    /**
+     * @brief 记录一帧已送往显示
+     */
+    static void recordFrame();
+
+    /**
+     * @brief 记录一次整帧缓冲区分配
+     */
+    static void recordAllocation();
+
+    /**
+     * @brief 记录一次整帧像素遍历
+     * @param bytes 遍历的字节数
+     */
+    static void recordPixelPass(qint64 bytes);
+
+    /**
+     * @brief 获取当前计数
+     * @return 计数器快照
+     */
+    static Snapshot snapshot();
+
+    /**
+     * @brief 清零所有计数
+     */
+    static void reset();
+};
+
+#endif // FRAMECOPYCOUNTER_H
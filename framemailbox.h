@@ -0,0 +1,87 @@
+/**
+ * @file framemailbox.h
+ * @brief 无锁"最新帧优先"信箱的头文件
+ *
+ * 该文件定义了FrameMailbox模板类，它是一个单生产者/单消费者的三缓冲区，
+ * 采集线程不断发布新帧，界面线程只取走最新的一帧，旧帧被直接覆盖。
+ */
+#ifndef FRAMEMAILBOX_H
+#define FRAMEMAILBOX_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class FrameMailbox
+ * @brief 单生产者/单消费者的无锁三缓冲信箱
+ *
+ * 三个槽位分别归生产者、消费者私有，以及一个用于交换的中间槽位。
+ * 生产者写完自己的槽位后调用publish()与中间槽位交换；消费者调用fetch()
+ * 在有新帧时与中间槽位交换。双方都不会阻塞，也不会看到写了一半的数据。
+ */
+template <typename T>
+class FrameMailbox
+{
+public:
+    FrameMailbox()
+        : m_middle(1)
+        , m_writeIndex(0)
+        , m_readIndex(2)
+    {
+    }
+
+    FrameMailbox(const FrameMailbox&) = delete;
+    FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+    /**
+     * @brief 获取生产者私有的写入槽位（仅生产者线程调用）
+     * @return 写入槽位引用
+     */
+    T& writeSlot() { return m_slots[m_writeIndex]; }
+
+    /**
+     * @brief 发布写入槽位中的内容（仅生产者线程调用）
+     *
+     * 与中间槽位交换，若消费者尚未取走上一帧则上一帧被丢弃
+     * @return 是否覆盖了一帧尚未被取走的旧帧
+     */
+    bool publish()
+    {
+        const std::uint8_t previous = m_middle.exchange(
+            static_cast<std::uint8_t>(m_writeIndex | kFreshBit), std::memory_order_acq_rel);
+        m_writeIndex = previous & kIndexMask;
+        return (previous & kFreshBit) != 0;
+    }
+
+    /**
+     * @brief 取走最新发布的内容（仅消费者线程调用）
+     * @return 是否有新内容，为true时readSlot()指向新内容
+     */
+    bool fetch()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & kFreshBit) == 0)
+            return false;
+
+        const std::uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief 获取消费者私有的读取槽位（仅消费者线程调用）
+     * @return 读取槽位引用，在下一次fetch()成功前保持不变
+     */
+    T& readSlot() { return m_slots[m_readIndex]; }
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x03;
+    static constexpr std::uint8_t kFreshBit = 0x04;
+
+    std::array<T, 3> m_slots;             ///< 三个缓冲槽位
+    std::atomic<std::uint8_t> m_middle;   ///< 中间槽位索引及"新帧"标志
+    std::uint8_t m_writeIndex;            ///< 生产者槽位索引
+    std::uint8_t m_readIndex;             ///< 消费者槽位索引
+};
+
+#endif // FRAMEMAILBOX_H
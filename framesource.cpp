@@ -0,0 +1,53 @@
+/**
+ * @file framesource.cpp
+ * @brief 帧源工厂函数的实现文件
+ */
+#include "framesource.h"
+#include "opencvframesource.h"
+#include "replayframesource.h"
+#include "sessionframesource.h"
+#include "syntheticframesource.h"
+#ifdef ADAS_HAVE_V4L2
+#include "v4l2framesource.h"
+#endif
+
+#include <QFile>
+#include <QFileInfo>
+
+/**
+ * @brief 设备或文件当前是否存在
+ * @return 是否存在
+ */
+bool FrameSource::isPresent() const
+{
+    return QFile::exists(location());
+}
+
+/**
+ * @brief 根据位置创建合适的帧源
+ * @param location 设备路径或录像文件路径
+ * @param config 采集参数
+ * @return 帧源对象
+ */
+std::unique_ptr<FrameSource> createFrameSource(const QString& location, const FrameSourceConfig& config)
+{
+    if (SyntheticFrameSource::isSyntheticLocation(location)) {
+        return std::make_unique<SyntheticFrameSource>(location, config);
+    }
+    if (SessionFrameSource::isSessionLocation(location)) {
+        return std::make_unique<SessionFrameSource>(location, config);
+    }
+
+    const QFileInfo info(location);
+    if (info.isFile()) {
+        return std::make_unique<ReplayFrameSource>(location, config);
+    }
+
+#ifdef ADAS_HAVE_V4L2
+    if (location.startsWith("/dev/video")) {
+        return std::make_unique<V4l2FrameSource>(location, config);
+    }
+#endif
+
+    return std::make_unique<OpenCvFrameSource>(location, config);
+}
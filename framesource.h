@@ -0,0 +1,112 @@
+/**
+ * @file framesource.h
+ * @brief 帧源抽象接口的头文件
+ *
+ * 该文件定义了FrameSource接口，采集线程通过它获取帧，而不关心帧来自
+ * V4L2摄像头、OpenCV还是录像文件。
+ */
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+
+#include <QString>
+
+#include <memory>
+
+#include "cameraframe.h"
+
+/**
+ * @struct FrameSourceConfig
+ * @brief 帧源的采集参数
+ */
+struct FrameSourceConfig
+{
+    int width = 640;                    ///< 期望的采集宽度
+    int height = 360;                   ///< 期望的采集高度
+    int fps = 30;                       ///< 期望的帧率
+    quint32 pixelFormat = FOURCC_MJPG;  ///< 期望的像素格式
+    int bufferCount = 4;                ///< 驱动缓冲区数量（V4L2）
+    bool realtime = true;               ///< 回放时是否按原始帧率播放
+    double speed = 1.0;                 ///< 按原始帧率回放时的速度倍数
+    qint64 startUs = 0;                 ///< 回放起始位置（相对录像开始，微秒）
+    qint64 clockStartUs = 0;            ///< 各路回放共用的开始时刻（单调时钟，微秒），为0时以打开时刻为准
+    bool loop = true;                   ///< 回放到结尾时是否从头开始
+};
+
+/**
+ * @class FrameSource
+ * @brief 帧源抽象接口
+ *
+ * 所有方法都只在采集线程中调用。grab()可以只填写CameraFrame::raw，
+ * 由调用者负责解码。
+ */
+class FrameSource
+{
+public:
+    /**
+     * @brief grab()的结果
+     */
+    enum class GrabResult {
+        Frame,      ///< 成功取得一帧
+        Timeout,    ///< 等待超时，帧源仍然可用
+        Error       ///< 帧源出错，需要关闭后重新打开
+    };
+
+    virtual ~FrameSource() = default;
+
+    /**
+     * @brief 打开帧源
+     * @return 是否打开成功
+     */
+    virtual bool open() = 0;
+
+    /**
+     * @brief 关闭帧源，已交出的缓冲区在释放后仍然安全
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief 帧源是否已打开
+     * @return 是否已打开
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * @brief 设备或文件当前是否存在，不存在时不必尝试打开
+     * @return 是否存在，默认检查location()对应的文件
+     */
+    virtual bool isPresent() const;
+
+    /**
+     * @brief 等待并取出下一帧
+     * @param frame 输出帧，只写入image或raw相关字段以及deviceTimestampUs
+     * @param timeoutMs 最长等待时间（毫秒）
+     * @return 取帧结果
+     */
+    virtual GrabResult grab(CameraFrame& frame, int timeoutMs) = 0;
+
+    /**
+     * @brief 获取帧源的位置描述（设备路径或文件路径）
+     * @return 位置描述
+     */
+    virtual QString location() const = 0;
+
+    /**
+     * @brief 是否为录像回放，回放的帧源重新打开时会回到起始位置
+     * @return 是否为回放，默认为false
+     */
+    virtual bool isReplay() const { return false; }
+};
+
+/**
+ * @brief 根据位置创建合适的帧源
+ * @param location 设备路径、录像文件路径、"synthetic:<图案>"或"session:<会话文件>#<摄像头>"
+ * @param config 采集参数
+ * @return 帧源对象（尚未打开）
+ *
+ * "synthetic:"开头的位置使用合成测试画面，"session:"开头的位置回放会话文件中的一个摄像头，
+ * Linux下的/dev/video*设备使用原生V4L2实现，其他设备使用OpenCV，普通文件使用回放实现
+ */
+std::unique_ptr<FrameSource> createFrameSource(const QString& location,
+                                               const FrameSourceConfig& config = FrameSourceConfig());
+
+#endif // FRAMESOURCE_H
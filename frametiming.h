@@ -0,0 +1,43 @@
+/**
+ * @file frametiming.h
+ * @brief 帧时间戳的头文件
+ */
+#ifndef FRAMETIMING_H
+#define FRAMETIMING_H
+
+#include <QtGlobal>
+
+#include <chrono>
+
+/**
+ * @struct FrameTiming
+ * @brief 一帧经过各处理阶段的时间戳
+ *
+ * 所有时刻都取自单调时钟（微秒），与V4L2驱动时间戳使用同一时钟，可以直接相减
+ */
+struct FrameTiming
+{
+    quint64 sequence = 0;   ///< 帧序号
+    qint64 captureUs = 0;   ///< 采集时刻，优先使用驱动时间戳
+    qint64 decodeUs = 0;    ///< 解码完成时刻
+    qint64 convertUs = 0;   ///< 颜色转换和缩放完成时刻
+    qint64 presentUs = 0;   ///< 绘制完成时刻
+
+    /**
+     * @brief 采集到绘制完成的总延迟
+     * @return 微秒
+     */
+    qint64 totalUs() const { return presentUs - captureUs; }
+};
+
+/**
+ * @brief 获取单调时钟的当前时刻
+ * @return 微秒，与FrameTiming中的时刻和V4L2驱动时间戳使用同一时钟
+ */
+inline qint64 monotonicNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // FRAMETIMING_H
@@ -0,0 +1,528 @@
+/**
+ * @file fusedscaler.cpp
+ * @brief 颜色转换与缩放融合内核的实现文件
+ */
+#include "fusedscaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define FUSEDSCALER_X86 1
+#define FUSEDSCALER_AVX2 1
+#include <immintrin.h>
+#elif defined(_M_X64)
+#define FUSEDSCALER_X86 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#define FUSEDSCALER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// 插值权重的定点位数：权重和为128，垂直插值结果不超过255*128，可用16位保存
+constexpr int kWeightBits = 7;
+constexpr int kWeightOne = 1 << kWeightBits;
+constexpr int kRoundShift = 2 * kWeightBits;
+constexpr int kRoundBias = 1 << (kRoundShift - 1);
+
+using BlendRowsFunc = void (*)(const std::uint8_t *, const std::uint8_t *, int, int,
+                               std::uint16_t *, int);
+using PackRowFunc = void (*)(const std::uint16_t *, const std::int32_t *, const std::int32_t *,
+                             const std::int16_t *, std::uint32_t *, int);
+
+/**
+ * @brief 垂直插值的标量实现：out = r0 * w0 + r1 * w1
+ */
+void blendRowsScalar(const std::uint8_t *r0, const std::uint8_t *r1, int w0, int w1,
+                     std::uint16_t *out, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<std::uint16_t>(r0[i] * w0 + r1[i] * w1);
+    }
+}
+
+#ifdef FUSEDSCALER_X86
+/**
+ * @brief 垂直插值的SSE2实现，每次处理16字节
+ */
+void blendRowsSse2(const std::uint8_t *r0, const std::uint8_t *r1, int w0, int w1,
+                   std::uint16_t *out, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weight0 = _mm_set1_epi16(static_cast<short>(w0));
+    const __m128i weight1 = _mm_set1_epi16(static_cast<short>(w1));
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i));
+        const __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), weight0),
+                                         _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weight1));
+        const __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), weight0),
+                                         _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weight1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+    }
+    blendRowsScalar(r0 + i, r1 + i, w0, w1, out + i, count - i);
+}
+#endif
+
+#ifdef FUSEDSCALER_AVX2
+/**
+ * @brief 垂直插值的AVX2实现，每次处理32字节
+ */
+__attribute__((target("avx2")))
+void blendRowsAvx2(const std::uint8_t *r0, const std::uint8_t *r1, int w0, int w1,
+                   std::uint16_t *out, int count)
+{
+    const __m256i weight0 = _mm256_set1_epi16(static_cast<short>(w0));
+    const __m256i weight1 = _mm256_set1_epi16(static_cast<short>(w1));
+
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i a0 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i)));
+        const __m256i b0 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i)));
+        const __m256i a1 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i + 16)));
+        const __m256i b1 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i + 16)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_add_epi16(_mm256_mullo_epi16(a0, weight0), _mm256_mullo_epi16(b0, weight1)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 16),
+                            _mm256_add_epi16(_mm256_mullo_epi16(a1, weight0), _mm256_mullo_epi16(b1, weight1)));
+    }
+    blendRowsScalar(r0 + i, r1 + i, w0, w1, out + i, count - i);
+}
+#endif
+
+#ifdef FUSEDSCALER_NEON
+/**
+ * @brief 垂直插值的NEON实现，每次处理16字节
+ */
+void blendRowsNeon(const std::uint8_t *r0, const std::uint8_t *r1, int w0, int w1,
+                   std::uint16_t *out, int count)
+{
+    const uint8x8_t weight0 = vdup_n_u8(static_cast<std::uint8_t>(w0));
+    const uint8x8_t weight1 = vdup_n_u8(static_cast<std::uint8_t>(w1));
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t a = vld1q_u8(r0 + i);
+        const uint8x16_t b = vld1q_u8(r1 + i);
+        vst1q_u16(out + i, vmlal_u8(vmull_u8(vget_low_u8(a), weight0), vget_low_u8(b), weight1));
+        vst1q_u16(out + i + 8, vmlal_u8(vmull_u8(vget_high_u8(a), weight0), vget_high_u8(b), weight1));
+    }
+    blendRowsScalar(r0 + i, r1 + i, w0, w1, out + i, count - i);
+}
+#endif
+
+/**
+ * @brief 选择对应SIMD级别的垂直插值实现
+ */
+BlendRowsFunc blendRowsFor(FusedBgrScaler::SimdLevel level)
+{
+    switch (level) {
+#ifdef FUSEDSCALER_AVX2
+    case FusedBgrScaler::SimdLevel::AVX2:
+        return blendRowsAvx2;
+#endif
+#ifdef FUSEDSCALER_X86
+    case FusedBgrScaler::SimdLevel::SSE2:
+        return blendRowsSse2;
+#endif
+#ifdef FUSEDSCALER_NEON
+    case FusedBgrScaler::SimdLevel::NEON:
+        return blendRowsNeon;
+#endif
+    default:
+        return blendRowsScalar;
+    }
+}
+
+/**
+ * @brief 水平插值并打包为RGB32的标量实现
+ * @tparam BlueIndex 蓝色分量在源像素中的位置
+ * @tparam RedIndex 红色分量在源像素中的位置
+ */
+template <int BlueIndex, int RedIndex>
+void packRowScalar(const std::uint16_t *row, const std::int32_t *xOffset, const std::int32_t *xNext,
+                   const std::int16_t *xWeight, std::uint32_t *out, int dstWidth)
+{
+    for (int x = 0; x < dstWidth; ++x) {
+        const std::uint16_t *left = row + xOffset[x];
+        const std::uint16_t *right = left + xNext[x];
+        const int w1 = xWeight[x];
+        const int w0 = kWeightOne - w1;
+
+        const std::uint32_t blue = (left[BlueIndex] * w0 + right[BlueIndex] * w1 + kRoundBias) >> kRoundShift;
+        const std::uint32_t green = (left[1] * w0 + right[1] * w1 + kRoundBias) >> kRoundShift;
+        const std::uint32_t red = (left[RedIndex] * w0 + right[RedIndex] * w1 + kRoundBias) >> kRoundShift;
+        out[x] = 0xff000000u | (red << 16) | (green << 8) | blue;
+    }
+}
+
+#ifdef FUSEDSCALER_X86
+/**
+ * @brief 读取中间行中相邻的两个16位分量
+ */
+inline int loadPair(const std::uint16_t *p)
+{
+    return p[0] | (p[1] << 16);
+}
+
+/**
+ * @brief 水平插值并打包为RGB32的SSE2实现，每次处理4个目标像素
+ *
+ * SSE2没有gather，按插值表逐个读取左右像素的(c0,c1)和(c1,c2)分量对，
+ * 拼成(左,右)16位对后用madd一次完成两侧加权，再移位打包
+ */
+template <int BlueIndex, int RedIndex>
+void packRowSse2(const std::uint16_t *row, const std::int32_t *xOffset, const std::int32_t *xNext,
+                 const std::int16_t *xWeight, std::uint32_t *out, int dstWidth)
+{
+    const __m128i lowMask = _mm_set1_epi32(0xffff);
+    const __m128i highMask = _mm_set1_epi32(static_cast<int>(0xffff0000u));
+    const __m128i one = _mm_set1_epi32(kWeightOne);
+    const __m128i bias = _mm_set1_epi32(kRoundBias);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+    int x = 0;
+    for (; x + 4 <= dstWidth; x += 4) {
+        const std::uint16_t *l0 = row + xOffset[x];
+        const std::uint16_t *l1 = row + xOffset[x + 1];
+        const std::uint16_t *l2 = row + xOffset[x + 2];
+        const std::uint16_t *l3 = row + xOffset[x + 3];
+        const std::uint16_t *r0 = l0 + xNext[x];
+        const std::uint16_t *r1 = l1 + xNext[x + 1];
+        const std::uint16_t *r2 = l2 + xNext[x + 2];
+        const std::uint16_t *r3 = l3 + xNext[x + 3];
+        const __m128i left01 = _mm_set_epi32(loadPair(l3), loadPair(l2), loadPair(l1), loadPair(l0));
+        const __m128i left12 = _mm_set_epi32(loadPair(l3 + 1), loadPair(l2 + 1), loadPair(l1 + 1), loadPair(l0 + 1));
+        const __m128i right01 = _mm_set_epi32(loadPair(r3), loadPair(r2), loadPair(r1), loadPair(r0));
+        const __m128i right12 = _mm_set_epi32(loadPair(r3 + 1), loadPair(r2 + 1), loadPair(r1 + 1), loadPair(r0 + 1));
+
+        // 每个32位单元为(左,右)分量对，权重对为(w0,w1)
+        const __m128i w1 = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(xWeight + x))), 16);
+        const __m128i weights = _mm_or_si128(_mm_sub_epi32(one, w1), _mm_slli_epi32(w1, 16));
+        const __m128i c0 = _mm_or_si128(_mm_and_si128(left01, lowMask), _mm_slli_epi32(right01, 16));
+        const __m128i c1 = _mm_or_si128(_mm_srli_epi32(left01, 16), _mm_and_si128(right01, highMask));
+        const __m128i c2 = _mm_or_si128(_mm_srli_epi32(left12, 16), _mm_and_si128(right12, highMask));
+        const __m128i v0 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(c0, weights), bias), kRoundShift);
+        const __m128i v1 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(c1, weights), bias), kRoundShift);
+        const __m128i v2 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(c2, weights), bias), kRoundShift);
+        const __m128i blue = BlueIndex == 0 ? v0 : v2;
+        const __m128i red = RedIndex == 0 ? v0 : v2;
+        const __m128i pixels = _mm_or_si128(_mm_or_si128(alpha, _mm_slli_epi32(red, 16)),
+                                            _mm_or_si128(_mm_slli_epi32(v1, 8), blue));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), pixels);
+    }
+    packRowScalar<BlueIndex, RedIndex>(row, xOffset + x, xNext + x, xWeight + x, out + x, dstWidth - x);
+}
+#endif
+
+#ifdef FUSEDSCALER_AVX2
+/**
+ * @brief 水平插值并打包为RGB32的AVX2实现，每次处理8个目标像素
+ *
+ * 用插值表作为索引gather左右像素的(c0,c1)和(c1,c2)分量对，其余与SSE2实现相同。
+ * 分量对最远读到中间行的最后一个分量，不会越界
+ */
+template <int BlueIndex, int RedIndex>
+__attribute__((target("avx2")))
+void packRowAvx2(const std::uint16_t *row, const std::int32_t *xOffset, const std::int32_t *xNext,
+                 const std::int16_t *xWeight, std::uint32_t *out, int dstWidth)
+{
+    const int *base = reinterpret_cast<const int*>(row);
+    const __m256i lowMask = _mm256_set1_epi32(0xffff);
+    const __m256i highMask = _mm256_set1_epi32(static_cast<int>(0xffff0000u));
+    const __m256i oneElement = _mm256_set1_epi32(1);
+    const __m256i one = _mm256_set1_epi32(kWeightOne);
+    const __m256i bias = _mm256_set1_epi32(kRoundBias);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xff000000u));
+
+    int x = 0;
+    for (; x + 8 <= dstWidth; x += 8) {
+        // 索引以16位分量为单位，gather的比例因子取2
+        const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xOffset + x));
+        const __m256i right = _mm256_add_epi32(left, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xNext + x)));
+        const __m256i left01 = _mm256_i32gather_epi32(base, left, 2);
+        const __m256i left12 = _mm256_i32gather_epi32(base, _mm256_add_epi32(left, oneElement), 2);
+        const __m256i right01 = _mm256_i32gather_epi32(base, right, 2);
+        const __m256i right12 = _mm256_i32gather_epi32(base, _mm256_add_epi32(right, oneElement), 2);
+
+        const __m256i w1 = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xWeight + x)));
+        const __m256i weights = _mm256_or_si256(_mm256_sub_epi32(one, w1), _mm256_slli_epi32(w1, 16));
+        const __m256i c0 = _mm256_or_si256(_mm256_and_si256(left01, lowMask), _mm256_slli_epi32(right01, 16));
+        const __m256i c1 = _mm256_or_si256(_mm256_srli_epi32(left01, 16), _mm256_and_si256(right01, highMask));
+        const __m256i c2 = _mm256_or_si256(_mm256_srli_epi32(left12, 16), _mm256_and_si256(right12, highMask));
+        const __m256i v0 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(c0, weights), bias), kRoundShift);
+        const __m256i v1 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(c1, weights), bias), kRoundShift);
+        const __m256i v2 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(c2, weights), bias), kRoundShift);
+        const __m256i blue = BlueIndex == 0 ? v0 : v2;
+        const __m256i red = RedIndex == 0 ? v0 : v2;
+        const __m256i pixels = _mm256_or_si256(_mm256_or_si256(alpha, _mm256_slli_epi32(red, 16)),
+                                               _mm256_or_si256(_mm256_slli_epi32(v1, 8), blue));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), pixels);
+    }
+    packRowScalar<BlueIndex, RedIndex>(row, xOffset + x, xNext + x, xWeight + x, out + x, dstWidth - x);
+}
+#endif
+
+#ifdef FUSEDSCALER_NEON
+/**
+ * @brief 水平插值并打包为RGB32的NEON实现，每次处理4个目标像素
+ *
+ * 按插值表用vld3_lane逐个读取左右像素，读取时即拆分为三个分量向量
+ */
+template <int BlueIndex, int RedIndex>
+void packRowNeon(const std::uint16_t *row, const std::int32_t *xOffset, const std::int32_t *xNext,
+                 const std::int16_t *xWeight, std::uint32_t *out, int dstWidth)
+{
+    const uint32x4_t alpha = vdupq_n_u32(0xff000000u);
+    const uint16x4_t one = vdup_n_u16(kWeightOne);
+
+    int x = 0;
+    for (; x + 4 <= dstWidth; x += 4) {
+        uint16x4x3_t left = {};
+        uint16x4x3_t right = {};
+        left = vld3_lane_u16(row + xOffset[x], left, 0);
+        left = vld3_lane_u16(row + xOffset[x + 1], left, 1);
+        left = vld3_lane_u16(row + xOffset[x + 2], left, 2);
+        left = vld3_lane_u16(row + xOffset[x + 3], left, 3);
+        right = vld3_lane_u16(row + xOffset[x] + xNext[x], right, 0);
+        right = vld3_lane_u16(row + xOffset[x + 1] + xNext[x + 1], right, 1);
+        right = vld3_lane_u16(row + xOffset[x + 2] + xNext[x + 2], right, 2);
+        right = vld3_lane_u16(row + xOffset[x + 3] + xNext[x + 3], right, 3);
+
+        const uint16x4_t w1 = vreinterpret_u16_s16(vld1_s16(xWeight + x));
+        const uint16x4_t w0 = vsub_u16(one, w1);
+        // 带舍入的右移，等价于加kRoundBias后右移
+        const uint32x4_t v0 = vrshrq_n_u32(vmlal_u16(vmull_u16(left.val[0], w0), right.val[0], w1), kRoundShift);
+        const uint32x4_t v1 = vrshrq_n_u32(vmlal_u16(vmull_u16(left.val[1], w0), right.val[1], w1), kRoundShift);
+        const uint32x4_t v2 = vrshrq_n_u32(vmlal_u16(vmull_u16(left.val[2], w0), right.val[2], w1), kRoundShift);
+        const uint32x4_t blue = BlueIndex == 0 ? v0 : v2;
+        const uint32x4_t red = RedIndex == 0 ? v0 : v2;
+        const uint32x4_t pixels = vorrq_u32(vorrq_u32(alpha, vshlq_n_u32(red, 16)),
+                                            vorrq_u32(vshlq_n_u32(v1, 8), blue));
+        vst1q_u32(out + x, pixels);
+    }
+    packRowScalar<BlueIndex, RedIndex>(row, xOffset + x, xNext + x, xWeight + x, out + x, dstWidth - x);
+}
+#endif
+
+/**
+ * @brief 选择对应SIMD级别和通道顺序的水平插值实现
+ */
+template <int BlueIndex, int RedIndex>
+PackRowFunc packRowFor(FusedBgrScaler::SimdLevel level)
+{
+    switch (level) {
+#ifdef FUSEDSCALER_AVX2
+    case FusedBgrScaler::SimdLevel::AVX2:
+        return packRowAvx2<BlueIndex, RedIndex>;
+#endif
+#ifdef FUSEDSCALER_X86
+    case FusedBgrScaler::SimdLevel::SSE2:
+        return packRowSse2<BlueIndex, RedIndex>;
+#endif
+#ifdef FUSEDSCALER_NEON
+    case FusedBgrScaler::SimdLevel::NEON:
+        return packRowNeon<BlueIndex, RedIndex>;
+#endif
+    default:
+        return packRowScalar<BlueIndex, RedIndex>;
+    }
+}
+
+/**
+ * @brief 计算一个方向上的插值表，映射方式与cv::resize(INTER_LINEAR)一致
+ * @param srcSize 源尺寸
+ * @param dstSize 目标尺寸
+ * @param index 输出：每个目标位置对应的前一个源位置
+ * @param hasNext 输出：后一个源位置是否存在（边缘为false）
+ * @param weight 输出：后一个源位置的权重
+ */
+void buildAxisTable(int srcSize, int dstSize, std::vector<std::int32_t>& index,
+                    std::vector<bool>& hasNext, std::vector<std::int16_t>& weight)
+{
+    index.resize(dstSize);
+    hasNext.resize(dstSize);
+    weight.resize(dstSize);
+
+    const double scale = static_cast<double>(srcSize) / dstSize;
+    for (int d = 0; d < dstSize; ++d) {
+        const double s = (d + 0.5) * scale - 0.5;
+        int s0 = static_cast<int>(std::floor(s));
+        double fraction = s - s0;
+        if (s0 < 0) {
+            s0 = 0;
+            fraction = 0.0;
+        }
+
+        int w = static_cast<int>(std::lround(fraction * kWeightOne));
+        if (w >= kWeightOne) {
+            ++s0;
+            w = 0;
+        }
+        if (s0 >= srcSize - 1) {
+            s0 = srcSize - 1;
+            w = 0;
+        }
+
+        index[d] = s0;
+        hasNext[d] = s0 < srcSize - 1;
+        weight[d] = static_cast<std::int16_t>(w);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief FusedBgrScaler类的构造函数，自动选择最佳SIMD级别
+ */
+FusedBgrScaler::FusedBgrScaler()
+    : m_srcWidth(0)
+    , m_srcHeight(0)
+    , m_dstWidth(0)
+    , m_dstHeight(0)
+    , m_level(detectSimdLevel())
+{
+}
+
+/**
+ * @brief 设置源尺寸和目标尺寸
+ * @param srcWidth 源宽度
+ * @param srcHeight 源高度
+ * @param dstWidth 目标宽度
+ * @param dstHeight 目标高度
+ */
+void FusedBgrScaler::setGeometry(int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+{
+    if (srcWidth == m_srcWidth && srcHeight == m_srcHeight
+        && dstWidth == m_dstWidth && dstHeight == m_dstHeight)
+        return;
+
+    m_srcWidth = srcWidth;
+    m_srcHeight = srcHeight;
+    m_dstWidth = dstWidth;
+    m_dstHeight = dstHeight;
+
+    std::vector<bool> hasNext;
+    buildAxisTable(srcWidth, dstWidth, m_xOffset, hasNext, m_xWeight);
+    m_xNext.resize(dstWidth);
+    for (int x = 0; x < dstWidth; ++x) {
+        m_xOffset[x] *= 3;
+        m_xNext[x] = hasNext[x] ? 3 : 0;
+    }
+
+    buildAxisTable(srcHeight, dstHeight, m_yRow, hasNext, m_yWeight);
+    m_yNext.resize(dstHeight);
+    for (int y = 0; y < dstHeight; ++y) {
+        m_yNext[y] = hasNext[y] ? 1 : 0;
+    }
+
+    m_rowBuffer.resize(static_cast<std::size_t>(srcWidth) * 3);
+}
+
+/**
+ * @brief 执行颜色转换和缩放
+ * @param src 源数据首地址
+ * @param srcStride 源数据每行字节数
+ * @param order 源数据的通道顺序
+ * @param dst 目标数据首地址
+ * @param dstStride 目标数据每行字节数
+ */
+void FusedBgrScaler::process(const std::uint8_t *src, std::size_t srcStride, ChannelOrder order,
+                             std::uint8_t *dst, std::size_t dstStride)
+{
+    if (m_dstWidth <= 0 || m_dstHeight <= 0 || m_srcWidth <= 0 || m_srcHeight <= 0)
+        return;
+
+    const BlendRowsFunc blendRows = blendRowsFor(m_level);
+    const PackRowFunc packRow = order == ChannelOrder::BGR ? packRowFor<0, 2>(m_level) : packRowFor<2, 0>(m_level);
+    const int rowBytes = m_srcWidth * 3;
+
+    for (int y = 0; y < m_dstHeight; ++y) {
+        const std::uint8_t *row0 = src + static_cast<std::size_t>(m_yRow[y]) * srcStride;
+        const std::uint8_t *row1 = row0 + static_cast<std::size_t>(m_yNext[y]) * srcStride;
+        const int w1 = m_yWeight[y];
+        blendRows(row0, row1, kWeightOne - w1, w1, m_rowBuffer.data(), rowBytes);
+
+        std::uint32_t *out = reinterpret_cast<std::uint32_t*>(dst + static_cast<std::size_t>(y) * dstStride);
+        packRow(m_rowBuffer.data(), m_xOffset.data(), m_xNext.data(), m_xWeight.data(), out, m_dstWidth);
+    }
+}
+
+/**
+ * @brief 强制使用指定的SIMD级别
+ * @param level SIMD级别
+ */
+void FusedBgrScaler::setSimdLevel(SimdLevel level)
+{
+    const std::vector<SimdLevel> levels = supportedSimdLevels();
+    const bool supported = std::find(levels.begin(), levels.end(), level) != levels.end();
+    m_level = supported ? level : detectSimdLevel();
+}
+
+/**
+ * @brief 检测当前CPU支持的最佳SIMD级别
+ * @return SIMD级别
+ */
+FusedBgrScaler::SimdLevel FusedBgrScaler::detectSimdLevel()
+{
+#if defined(FUSEDSCALER_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+#elif defined(FUSEDSCALER_X86)
+    return SimdLevel::SSE2;
+#elif defined(FUSEDSCALER_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+/**
+ * @brief 列出当前CPU支持的全部SIMD级别
+ * @return SIMD级别
+ */
+std::vector<FusedBgrScaler::SimdLevel> FusedBgrScaler::supportedSimdLevels()
+{
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+#ifdef FUSEDSCALER_X86
+    levels.push_back(SimdLevel::SSE2);
+#endif
+#ifdef FUSEDSCALER_AVX2
+    if (detectSimdLevel() == SimdLevel::AVX2) {
+        levels.push_back(SimdLevel::AVX2);
+    }
+#endif
+#ifdef FUSEDSCALER_NEON
+    levels.push_back(SimdLevel::NEON);
+#endif
+    return levels;
+}
+
+/**
+ * @brief 获取SIMD级别的名称
+ * @param level SIMD级别
+ * @return 名称字符串
+ */
+const char* FusedBgrScaler::simdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::NEON:
+        return "NEON";
+    default:
+        return "Scalar";
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * @file fusedscaler.h
+ * @brief 颜色转换与缩放融合内核的头文件
+ *
+ * 该文件定义了FusedBgrScaler类，它在一次遍历中完成BGR888/RGB888到RGB32的
+ * 颜色转换和双线性缩放，直接写入控件的目标缓冲区。
+ */
+#ifndef FUSEDSCALER_H
+#define FUSEDSCALER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class FusedBgrScaler
+ * @brief 颜色转换+双线性缩放的融合内核
+ *
+ * 每一行输出先用SIMD把两条源行做垂直插值，写入一条留在缓存中的16位中间行，
+ * 再按插值表取左右像素（AVX2用gather）做水平插值，同样用SIMD直接打包为RGB32。源帧的每个像素只从内存读取一次，
+ * 目标帧的每个像素只写入一次。插值映射与cv::resize(INTER_LINEAR)一致，
+ * 权重为7位定点数，与参考实现的误差不超过1~2个灰度级。
+ *
+ * SIMD实现在运行时按CPU能力选择：AVX2、SSE2、NEON，否则使用标量实现。
+ * 同一对象不能被多个线程同时使用。
+ */
+class FusedBgrScaler
+{
+public:
+    /**
+     * @brief SIMD指令集级别
+     */
+    enum class SimdLevel {
+        Scalar,     ///< 标量实现
+        SSE2,       ///< x86 SSE2
+        AVX2,       ///< x86 AVX2
+        NEON        ///< ARM NEON
+    };
+
+    /**
+     * @brief 源数据的通道顺序
+     */
+    enum class ChannelOrder {
+        BGR,        ///< B,G,R字节顺序（OpenCV默认、QImage::Format_BGR888）
+        RGB         ///< R,G,B字节顺序（QImage::Format_RGB888）
+    };
+
+    FusedBgrScaler();
+
+    /**
+     * @brief 设置源尺寸和目标尺寸，尺寸不变时不重新计算插值表
+     * @param srcWidth 源宽度
+     * @param srcHeight 源高度
+     * @param dstWidth 目标宽度
+     * @param dstHeight 目标高度
+     */
+    void setGeometry(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+
+    /**
+     * @brief 执行颜色转换和缩放
+     * @param src 源数据首地址（3字节/像素）
+     * @param srcStride 源数据每行字节数
+     * @param order 源数据的通道顺序
+     * @param dst 目标数据首地址（RGB32，即0xffRRGGBB的32位整数）
+     * @param dstStride 目标数据每行字节数
+     */
+    void process(const std::uint8_t *src, std::size_t srcStride, ChannelOrder order,
+                 std::uint8_t *dst, std::size_t dstStride);
+
+    /**
+     * @brief 强制使用指定的SIMD级别（用于基准测试和校验）
+     * @param level SIMD级别，当前CPU不支持时回退到自动选择的级别
+     */
+    void setSimdLevel(SimdLevel level);
+
+    /**
+     * @brief 获取当前使用的SIMD级别
+     * @return SIMD级别
+     */
+    SimdLevel simdLevel() const { return m_level; }
+
+    /**
+     * @brief 检测当前CPU支持的最佳SIMD级别
+     * @return SIMD级别
+     */
+    static SimdLevel detectSimdLevel();
+
+    /**
+     * @brief 列出当前CPU支持的全部SIMD级别
+     * @return SIMD级别，从标量实现到最佳级别
+     */
+    static std::vector<SimdLevel> supportedSimdLevels();
+
+    /**
+     * @brief 获取SIMD级别的名称
+     * @param level SIMD级别
+     * @return 名称字符串
+     */
+    static const char* simdLevelName(SimdLevel level);
+
+private:
+    int m_srcWidth;
+    int m_srcHeight;
+    int m_dstWidth;
+    int m_dstHeight;
+    SimdLevel m_level;
+
+    std::vector<std::int32_t> m_xOffset;    ///< 每个目标列对应的左侧源像素字节偏移
+    std::vector<std::int32_t> m_xNext;      ///< 右侧源像素相对左侧的字节偏移（边缘为0）
+    std::vector<std::int16_t> m_xWeight;    ///< 右侧源像素的水平权重（0~128）
+    std::vector<std::int32_t> m_yRow;       ///< 每个目标行对应的上方源行号
+    std::vector<std::int32_t> m_yNext;      ///< 下方源行相对上方的行数（边缘为0）
+    std::vector<std::int16_t> m_yWeight;    ///< 下方源行的垂直权重（0~128）
+    std::vector<std::uint16_t> m_rowBuffer; ///< 垂直插值后的中间行
+};
+
+#endif // FUSEDSCALER_H
@@ -0,0 +1,107 @@
+/**
+ * @file gaugewidget.cpp
+ * @brief 自绘仪表控件基类的实现文件
+ */
+#include "gaugewidget.h"
+#include "styles.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+
+/**
+ * @brief GaugeWidget类的构造函数
+ * @param parent 父窗口指针
+ */
+GaugeWidget::GaugeWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_minimum(0)
+    , m_maximum(100)
+    , m_value(0)
+    , m_paintCount(0)
+{
+    // 每次绘制都先从缓存贴回底图，不需要Qt预先擦除背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+/**
+ * @brief 设置量程
+ * @param minimum 最小值
+ * @param maximum 最大值
+ */
+void GaugeWidget::setRange(int minimum, int maximum)
+{
+    m_minimum = minimum;
+    m_maximum = qMax(minimum + 1, maximum);
+    m_value = qBound(m_minimum, m_value, m_maximum);
+    m_background = QPixmap();
+    valueChanged();
+    update();
+}
+
+/**
+ * @brief 设置当前值
+ * @param value 当前值
+ */
+void GaugeWidget::setValue(int value)
+{
+    value = qBound(m_minimum, value, m_maximum);
+    if (value == m_value)
+        return;
+
+    const int oldValue = m_value;
+    m_value = value;
+    valueChanged();
+    update(changedRegion(oldValue, value));
+}
+
+/**
+ * @brief 当前值在量程中的比例
+ * @param value 值
+ * @return 0~1
+ */
+double GaugeWidget::fraction(int value) const
+{
+    return static_cast<double>(value - m_minimum) / (m_maximum - m_minimum);
+}
+
+/**
+ * @brief 绘制事件处理
+ * @param event 绘制事件
+ *
+ * 缓存按设备像素生成，高分屏下贴图不缩放
+ */
+void GaugeWidget::paintEvent(QPaintEvent *event)
+{
+    ++m_paintCount;
+
+    const qreal ratio = devicePixelRatioF();
+    if (m_background.isNull() || m_background.devicePixelRatio() != ratio) {
+        m_background = QPixmap(size() * ratio);
+        m_background.setDevicePixelRatio(ratio);
+        m_background.fill(PANEL_COLOR);
+        QPainter cachePainter(&m_background);
+        cachePainter.setRenderHint(QPainter::Antialiasing);
+        cachePainter.setFont(font());
+        paintBackground(cachePainter);
+    }
+
+    QPainter painter(this);
+    for (const QRect& rect : event->region()) {
+        const QRect source(rect.topLeft() * ratio, rect.size() * ratio);
+        painter.drawPixmap(rect, m_background, source);
+    }
+    painter.setClipRegion(event->region());
+    painter.setRenderHint(QPainter::Antialiasing);
+    paintValue(painter);
+}
+
+/**
+ * @brief 尺寸变化事件处理
+ * @param event 尺寸变化事件
+ */
+void GaugeWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_background = QPixmap();
+    layoutChanged();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file gaugewidget.h
+ * @brief 自绘仪表控件基类的头文件
+ *
+ * 该文件定义了GaugeWidget类，状态面板中的车速表和疲劳度表都由它派生，
+ * 取代由样式表驱动的QProgressBar。
+ */
+#ifndef GAUGEWIDGET_H
+#define GAUGEWIDGET_H
+
+#include <QPixmap>
+#include <QRegion>
+#include <QWidget>
+
+/**
+ * @class GaugeWidget
+ * @brief 自绘仪表控件基类
+ *
+ * 刻度、底色和文字等静态部分只在尺寸变化时绘制一次并缓存为QPixmap；
+ * 值变化时由派生类给出受影响的区域，只重绘该区域：先从缓存贴回底图，再画值相关的部分。
+ * 控件不透明，不经过样式表，也不因值变化而重新布局
+ */
+class GaugeWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父窗口指针，默认为nullptr
+     */
+    explicit GaugeWidget(QWidget *parent = nullptr);
+
+    /**
+     * @brief 设置量程
+     * @param minimum 最小值
+     * @param maximum 最大值
+     */
+    void setRange(int minimum, int maximum);
+
+    /**
+     * @brief 设置当前值，值不变时不做任何事
+     * @param value 当前值，超出量程时截断
+     */
+    void setValue(int value);
+
+    /**
+     * @brief 获取当前值
+     * @return 当前值
+     */
+    int value() const { return m_value; }
+
+    /**
+     * @brief 获取最小值
+     * @return 最小值
+     */
+    int minimum() const { return m_minimum; }
+
+    /**
+     * @brief 获取最大值
+     * @return 最大值
+     */
+    int maximum() const { return m_maximum; }
+
+    /**
+     * @brief 获取重绘次数
+     * @return 自创建以来paintEvent()的次数
+     */
+    quint64 paintCount() const { return m_paintCount; }
+
+protected:
+    /**
+     * @brief 当前值在量程中的比例
+     * @param value 值
+     * @return 0~1
+     */
+    double fraction(int value) const;
+
+    /**
+     * @brief 绘制静态部分，结果缓存到尺寸再次变化为止
+     * @param painter 缓存位图的绘制器，底色已填充
+     */
+    virtual void paintBackground(QPainter& painter) = 0;
+
+    /**
+     * @brief 绘制与当前值有关的部分
+     * @param painter 控件的绘制器，已裁剪到需要重绘的区域
+     */
+    virtual void paintValue(QPainter& painter) = 0;
+
+    /**
+     * @brief 计算值变化时需要重绘的区域
+     * @param oldValue 旧值
+     * @param newValue 新值
+     * @return 区域（控件坐标）
+     */
+    virtual QRegion changedRegion(int oldValue, int newValue) const = 0;
+
+    /**
+     * @brief 值发生变化，在计算重绘区域之前调用，派生类可在此更新缓存的文字
+     */
+    virtual void valueChanged() {}
+
+    /**
+     * @brief 尺寸发生变化，派生类在此重新计算布局
+     */
+    virtual void layoutChanged() {}
+
+    /**
+     * @brief 绘制事件处理
+     * @param event 绘制事件
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+    /**
+     * @brief 尺寸变化事件处理，使缓存失效并重新布局
+     * @param event 尺寸变化事件
+     */
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    int m_minimum;          ///< 最小值
+    int m_maximum;          ///< 最大值
+    int m_value;            ///< 当前值
+    QPixmap m_background;   ///< 静态部分的缓存
+    quint64 m_paintCount;   ///< 重绘次数
+};
+
+#endif // GAUGEWIDGET_H
@@ -0,0 +1,58 @@
+/**
+ * @file inferencescheduler.cpp
+ * @brief 推理调度器的实现文件
+ */
+#include "inferencescheduler.h"
+
+namespace {
+
+// 推理CPU时间滑动平均的权重，约10次推理后适应新的负载
+constexpr double kSmoothing = 0.2;
+
+} // namespace
+
+/**
+ * @brief InferenceScheduler类的构造函数
+ * @param cpuBudget CPU预算（核数）
+ * @param minIntervalUs 最短推理间隔
+ * @param maxIntervalUs 最长推理间隔
+ */
+InferenceScheduler::InferenceScheduler(double cpuBudget, qint64 minIntervalUs, qint64 maxIntervalUs)
+    : m_cpuBudget(1.0)
+    , m_minIntervalUs(qMax<qint64>(1, minIntervalUs))
+    , m_maxIntervalUs(qMax(m_minIntervalUs, maxIntervalUs))
+    , m_meanCpuUs(-1.0)
+{
+    setCpuBudget(cpuBudget);
+}
+
+/**
+ * @brief 设置CPU预算
+ * @param cores 核数
+ */
+void InferenceScheduler::setCpuBudget(double cores)
+{
+    m_cpuBudget = qMax(0.05, cores);
+}
+
+/**
+ * @brief 记录一次批量推理的开销
+ * @param cpuUs 推理消耗的CPU时间
+ */
+void InferenceScheduler::recordInference(qint64 cpuUs)
+{
+    if (cpuUs < 0)
+        return;
+    m_meanCpuUs = m_meanCpuUs < 0.0 ? cpuUs : m_meanCpuUs + (cpuUs - m_meanCpuUs) * kSmoothing;
+}
+
+/**
+ * @brief 获取当前的推理间隔
+ * @return 微秒
+ */
+qint64 InferenceScheduler::intervalUs() const
+{
+    if (m_meanCpuUs < 0.0)
+        return m_minIntervalUs;
+    return qBound(m_minIntervalUs, static_cast<qint64>(m_meanCpuUs / m_cpuBudget), m_maxIntervalUs);
+}
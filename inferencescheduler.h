@@ -0,0 +1,71 @@
+/**
+ * @file inferencescheduler.h
+ * @brief 推理调度器的头文件
+ *
+ * 该文件定义了InferenceScheduler类，按每次批量推理实际消耗的CPU时间和给定的CPU预算
+ * 决定推理间隔，即各摄像头的采样频率。
+ */
+#ifndef INFERENCESCHEDULER_H
+#define INFERENCESCHEDULER_H
+
+#include <QtGlobal>
+
+/**
+ * @class InferenceScheduler
+ * @brief 推理调度器
+ *
+ * 推理间隔 = 平均每次推理的CPU时间 / CPU预算（核数），并限制在[最短间隔, 最长间隔]之间。
+ * 摄像头越多，每批的CPU时间越长，采样频率随之降低，推理占用的CPU保持在预算以内；
+ * 模型或硬件足够快时采样频率受最短间隔限制，不会空耗CPU。
+ * 两次推理之间的目标位置由ObjectTracker外推。不是线程安全的，只在推理线程中使用
+ */
+class InferenceScheduler
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param cpuBudget CPU预算（核数）
+     * @param minIntervalUs 最短推理间隔（微秒）
+     * @param maxIntervalUs 最长推理间隔（微秒）
+     */
+    explicit InferenceScheduler(double cpuBudget = 1.0, qint64 minIntervalUs = 100000,
+                                qint64 maxIntervalUs = 1000000);
+
+    /**
+     * @brief 设置CPU预算
+     * @param cores 核数，大于0
+     */
+    void setCpuBudget(double cores);
+
+    /**
+     * @brief 获取CPU预算
+     * @return 核数
+     */
+    double cpuBudget() const { return m_cpuBudget; }
+
+    /**
+     * @brief 记录一次批量推理的开销
+     * @param cpuUs 推理消耗的CPU时间（微秒，含推理库的工作线程）
+     */
+    void recordInference(qint64 cpuUs);
+
+    /**
+     * @brief 获取当前的推理间隔
+     * @return 微秒，尚无记录时为最短间隔
+     */
+    qint64 intervalUs() const;
+
+    /**
+     * @brief 获取当前的采样频率
+     * @return 每秒推理次数
+     */
+    double sampleRateHz() const { return 1000000.0 / intervalUs(); }
+
+private:
+    double m_cpuBudget;         ///< CPU预算（核数）
+    qint64 m_minIntervalUs;     ///< 最短推理间隔
+    qint64 m_maxIntervalUs;     ///< 最长推理间隔
+    double m_meanCpuUs;         ///< 每次推理CPU时间的指数滑动平均，负数表示尚无记录
+};
+
+#endif // INFERENCESCHEDULER_H
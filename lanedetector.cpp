@@ -0,0 +1,457 @@
+/**
+ * @file lanedetector.cpp
+ * @brief 车道线检测线程的实现文件
+ */
+#include "lanedetector.h"
+#include "frametiming.h"
+#include "overlaylayer.h"
+
+#include <QMutexLocker>
+
+#include <cmath>
+#include <iostream>
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// 等待新帧的最长时间，保证停止请求能及时得到响应
+constexpr int kWaitTimeoutMs = 200;
+
+// 顶帽结果的最低亮度差，低于该值的像素不视为车道线
+constexpr double kMinContrast = 25.0;
+
+// 梯形掩码上沿的左右边界（相对检测区域宽度）
+constexpr double kMaskTopLeft = 0.25;
+constexpr double kMaskTopRight = 0.75;
+
+// 拟合一条车道线所需的最少候选点数，以及参与拟合的最多点数
+constexpr int kMinPoints = 20;
+constexpr int kMaxFitPoints = 400;
+
+// 候选点在纵向上至少覆盖检测区域高度的比例，排除路面上的斑块
+constexpr double kMinVerticalSpan = 0.3;
+
+// 拟合直线方向向量的最小纵向分量，更平的直线不是车道线
+constexpr double kMinVerticalComponent = 0.35;
+
+// 有跟踪结果时，候选点与预测位置的最大距离（相对检测区域宽度）
+constexpr double kSearchMargin = 0.08;
+
+// 观测与预测相差超过该值（相对检测区域宽度）时视为误检
+constexpr double kGate = 0.15;
+
+// 连续误检超过该帧数后按新的观测重新初始化
+constexpr int kReacquireAfter = 5;
+
+// 连续没有观测超过该帧数后视为丢失
+constexpr int kMaxMissedFrames = 10;
+
+// 卡尔曼滤波的过程噪声和观测噪声（单位为检测区域宽度比例的平方）
+constexpr float kProcessNoise = 1e-5f;
+constexpr float kMeasurementNoise = 4e-4f;
+
+// 车道线叠加层的颜色和线宽
+const QColor kLaneLineColor(0x2e, 0xcc, 0x71, 220);
+const QColor kLaneFillColor(0x2e, 0xcc, 0x71, 60);
+constexpr qreal kLaneLineWidth = 3.0;
+
+/**
+ * @brief 把检测结果转换为叠加图元
+ * @param lanes 检测结果
+ * @return 叠加场景，两条车道线都有时先填充本车道，没有车道线时为空
+ */
+OverlayScene laneScene(const LaneGeometry& lanes)
+{
+    OverlayScene scene;
+    scene.timeUs = lanes.captureTimeUs;
+    const LaneLine& left = lanes.left;
+    const LaneLine& right = lanes.right;
+
+    if (left.valid && right.valid) {
+        OverlayItem area;
+        area.shape = OverlayItem::Shape::Polygon;
+        area.points << QPointF(left.xTop, lanes.yTop) << QPointF(right.xTop, lanes.yTop)
+                    << QPointF(right.xBottom, lanes.yBottom) << QPointF(left.xBottom, lanes.yBottom);
+        area.fill = kLaneFillColor;
+        area.timeUs = lanes.captureTimeUs;
+        scene.items.append(area);
+    }
+
+    for (const LaneLine *line : {&left, &right}) {
+        if (!line->valid)
+            continue;
+        OverlayItem item;
+        item.shape = OverlayItem::Shape::Polyline;
+        item.points << QPointF(line->xTop, lanes.yTop) << QPointF(line->xBottom, lanes.yBottom);
+        item.color = kLaneLineColor;
+        item.width = kLaneLineWidth;
+        item.timeUs = lanes.captureTimeUs;
+        scene.items.append(item);
+    }
+    return scene;
+}
+
+} // namespace
+
+/**
+ * @brief LaneDetector类的构造函数
+ * @param parent 父对象指针
+ */
+LaneDetector::LaneDetector(QObject *parent)
+    : QThread(parent)
+    , m_accepting(false)
+    , m_frameReady(false)
+    , m_overlay(nullptr)
+    , m_processedFrames(0)
+    , m_totalProcessUs(0)
+    , m_maxProcessUs(0)
+{
+}
+
+/**
+ * @brief LaneDetector类的析构函数
+ */
+LaneDetector::~LaneDetector()
+{
+    stop();
+}
+
+/**
+ * @brief 提交一帧画面
+ * @param frame 已解码的帧
+ *
+ * 只拷贝检测区域的一个通道，再缩小到kAnalysisWidth宽
+ */
+void LaneDetector::submit(const CameraFrame& frame)
+{
+    if (!m_accepting.load(std::memory_order_acquire) || frame.image.empty())
+        return;
+
+    const int top = qRound(frame.image.rows * kRoiTop);
+    const int bottom = qRound(frame.image.rows * kRoiBottom);
+    if (bottom - top < 2)
+        return;
+
+    AnalysisFrame& slot = m_mailbox.writeSlot();
+    try {
+        const cv::Mat region = frame.image.rowRange(top, bottom);
+        if (region.channels() == 3) {
+            cv::extractChannel(region, slot.channel, 2);
+        } else {
+            region.copyTo(slot.channel);
+        }
+        if (slot.channel.cols > kAnalysisWidth) {
+            const int height = qMax(1, slot.channel.rows * kAnalysisWidth / slot.channel.cols);
+            cv::resize(slot.channel, slot.roi, cv::Size(kAnalysisWidth, height), 0, 0, cv::INTER_AREA);
+        } else {
+            slot.roi = slot.channel;
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "车道线检测帧转换异常: " << e.what() << std::endl;
+        return;
+    }
+    slot.captureTimeUs = frame.captureTimeUs;
+    m_mailbox.publish();
+
+    QMutexLocker locker(&m_wakeMutex);
+    m_frameReady = true;
+    m_wake.wakeOne();
+}
+
+/**
+ * @brief 停止线程
+ */
+void LaneDetector::stop()
+{
+    requestInterruption();
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        m_wake.wakeAll();
+    }
+    wait();
+}
+
+/**
+ * @brief 获取平均每帧处理耗时
+ * @return 毫秒
+ */
+double LaneDetector::meanProcessMs() const
+{
+    const quint64 frames = processedFrames();
+    return frames > 0 ? m_totalProcessUs.load(std::memory_order_relaxed) / 1000.0 / frames : 0.0;
+}
+
+/**
+ * @brief 线程主函数
+ *
+ * 车道线没有变化时不发布，画面块不会因此多绘制一次；停止时发布空结果清除叠加层
+ */
+void LaneDetector::run()
+{
+    m_left = LaneTrack();
+    m_right = LaneTrack();
+    m_accepting.store(true, std::memory_order_release);
+
+    auto publish = [this](const LaneGeometry& geometry) {
+        m_published = geometry;
+        if (m_overlay) {
+            m_overlay->publish(laneScene(geometry));
+        }
+    };
+
+    while (!isInterruptionRequested()) {
+        {
+            QMutexLocker locker(&m_wakeMutex);
+            if (!m_frameReady) {
+                m_wake.wait(&m_wakeMutex, kWaitTimeoutMs);
+            }
+            if (!m_frameReady)
+                continue;
+            m_frameReady = false;
+        }
+        if (!m_mailbox.fetch())
+            continue;
+
+        const AnalysisFrame& frame = m_mailbox.readSlot();
+        const LaneGeometry geometry = processFrame(frame.roi, frame.captureTimeUs);
+        if (geometry.left != m_published.left || geometry.right != m_published.right) {
+            publish(geometry);
+        }
+    }
+
+    m_accepting.store(false, std::memory_order_release);
+    if (m_published.hasLanes()) {
+        publish(LaneGeometry());
+    }
+}
+
+/**
+ * @brief 按检测区域尺寸重建掩码和形态学核
+ * @param size 检测区域尺寸
+ *
+ * 顶帽核比远处和近处的车道线都宽，比车道间距窄得多
+ */
+void LaneDetector::prepare(const cv::Size& size)
+{
+    m_preparedSize = size;
+
+    m_mask = cv::Mat::zeros(size, CV_8UC1);
+    const cv::Point corners[] = {
+        cv::Point(qRound(size.width * kMaskTopLeft), 0),
+        cv::Point(qRound(size.width * kMaskTopRight), 0),
+        cv::Point(size.width - 1, size.height - 1),
+        cv::Point(0, size.height - 1),
+    };
+    cv::fillConvexPoly(m_mask, corners, 4, cv::Scalar(255));
+
+    const int kernelWidth = qMax(3, size.width / 20) | 1;
+    m_kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(kernelWidth, 1));
+
+    // 尺寸变化后旧的像素坐标不再有效
+    m_left = LaneTrack();
+    m_right = LaneTrack();
+}
+
+/**
+ * @brief 检测一帧
+ * @param roi 检测区域的单通道图像
+ * @param timeUs 采集时刻
+ * @return 检测结果
+ */
+LaneGeometry LaneDetector::processFrame(const cv::Mat& roi, qint64 timeUs)
+{
+    const qint64 startUs = monotonicNowUs();
+
+    double leftTop = 0.0;
+    double leftBottom = 0.0;
+    double rightTop = 0.0;
+    double rightBottom = 0.0;
+    bool leftFound = false;
+    bool rightFound = false;
+    try {
+        if (roi.size() != m_preparedSize) {
+            prepare(roi.size());
+        }
+
+        cv::morphologyEx(roi, m_tophat, cv::MORPH_TOPHAT, m_kernel);
+        cv::threshold(m_tophat, m_binary, kMinContrast, 255, cv::THRESH_BINARY);
+        cv::bitwise_and(m_binary, m_mask, m_binary);
+
+        m_points.clear();
+        if (cv::countNonZero(m_binary) > 0) {
+            cv::findNonZero(m_binary, m_points);
+        }
+
+        // 按车道中心分组，有跟踪结果时只保留预测位置附近的点
+        const double margin = kSearchMargin * roi.cols;
+        const bool bothTracked = m_left.initialized && m_right.initialized;
+        m_leftPoints.clear();
+        m_rightPoints.clear();
+        for (const cv::Point& point : m_points) {
+            const double leftX = m_left.initialized ? predictedX(m_left, point.y) : 0.0;
+            const double rightX = m_right.initialized ? predictedX(m_right, point.y) : 0.0;
+            const double center = bothTracked ? (leftX + rightX) / 2.0 : roi.cols / 2.0;
+            if (point.x < center) {
+                if (!m_left.initialized || std::abs(point.x - leftX) <= margin) {
+                    m_leftPoints.push_back(point);
+                }
+            } else if (!m_right.initialized || std::abs(point.x - rightX) <= margin) {
+                m_rightPoints.push_back(point);
+            }
+        }
+
+        leftFound = fitLane(m_leftPoints, true, leftTop, leftBottom);
+        rightFound = fitLane(m_rightPoints, false, rightTop, rightBottom);
+    } catch (const cv::Exception& e) {
+        std::cerr << "车道线检测异常: " << e.what() << std::endl;
+    }
+
+    LaneGeometry geometry;
+    geometry.left = updateTrack(m_left, leftFound, leftTop, leftBottom);
+    geometry.right = updateTrack(m_right, rightFound, rightTop, rightBottom);
+    geometry.yTop = kRoiTop;
+    geometry.yBottom = kRoiBottom;
+    geometry.captureTimeUs = timeUs;
+
+    const qint64 elapsedUs = monotonicNowUs() - startUs;
+    m_processedFrames.fetch_add(1, std::memory_order_relaxed);
+    m_totalProcessUs.fetch_add(elapsedUs, std::memory_order_relaxed);
+    qint64 maxUs = m_maxProcessUs.load(std::memory_order_relaxed);
+    while (elapsedUs > maxUs && !m_maxProcessUs.compare_exchange_weak(maxUs, elapsedUs, std::memory_order_relaxed)) {
+    }
+
+    return geometry;
+}
+
+/**
+ * @brief 预测的车道线在某一行的横坐标
+ * @param track 跟踪状态
+ * @param y 行
+ * @return 横坐标
+ */
+double LaneDetector::predictedX(const LaneTrack& track, double y) const
+{
+    const cv::Mat& state = track.filter.statePost;
+    const double bottom = state.at<float>(0);
+    const double top = state.at<float>(1);
+    const double t = m_preparedSize.height > 1 ? y / (m_preparedSize.height - 1) : 1.0;
+    return (top + (bottom - top) * t) * m_preparedSize.width;
+}
+
+/**
+ * @brief 用候选点拟合一条车道线
+ * @param points 候选点
+ * @param leftSide 是否为左车道线
+ * @param xTop 输出上沿处的横坐标
+ * @param xBottom 输出下沿处的横坐标
+ * @return 是否拟合成功
+ *
+ * 点数过多时等间隔抽样；左车道线向上应偏向右侧，右车道线向上应偏向左侧
+ */
+bool LaneDetector::fitLane(const std::vector<cv::Point>& points, bool leftSide, double& xTop, double& xBottom)
+{
+    if (static_cast<int>(points.size()) < kMinPoints)
+        return false;
+
+    const std::size_t stride = qMax<std::size_t>(1, points.size() / kMaxFitPoints);
+    m_fitPoints.clear();
+    int minY = m_preparedSize.height;
+    int maxY = 0;
+    for (std::size_t i = 0; i < points.size(); i += stride) {
+        m_fitPoints.push_back(points[i]);
+        minY = qMin(minY, points[i].y);
+        maxY = qMax(maxY, points[i].y);
+    }
+    if (maxY - minY < m_preparedSize.height * kMinVerticalSpan)
+        return false;
+
+    cv::Vec4f line;
+    cv::fitLine(m_fitPoints, line, cv::DIST_HUBER, 0, 0.01, 0.01);
+    const double vx = line[0];
+    const double vy = line[1];
+    if (std::abs(vy) < kMinVerticalComponent)
+        return false;
+
+    const double bottomY = m_preparedSize.height - 1;
+    const double top = line[2] + (0.0 - line[3]) * vx / vy;
+    const double bottom = line[2] + (bottomY - line[3]) * vx / vy;
+    const double tolerance = 0.02 * m_preparedSize.width;
+    if (leftSide ? top - bottom < -tolerance : bottom - top < -tolerance)
+        return false;
+
+    xTop = top / m_preparedSize.width;
+    xBottom = bottom / m_preparedSize.width;
+    return true;
+}
+
+/**
+ * @brief 初始化卡尔曼滤波器
+ * @param track 跟踪状态
+ *
+ * 状态[下端点, 上端点, 下端点速度, 上端点速度]，恒速模型
+ */
+void LaneDetector::initFilter(LaneTrack& track)
+{
+    track.filter.init(4, 2, 0, CV_32F);
+    track.filter.transitionMatrix = (cv::Mat_<float>(4, 4) <<
+        1, 0, 1, 0,
+        0, 1, 0, 1,
+        0, 0, 1, 0,
+        0, 0, 0, 1);
+    cv::setIdentity(track.filter.measurementMatrix);
+    cv::setIdentity(track.filter.processNoiseCov, cv::Scalar::all(kProcessNoise));
+    cv::setIdentity(track.filter.measurementNoiseCov, cv::Scalar::all(kMeasurementNoise));
+    cv::setIdentity(track.filter.errorCovPost, cv::Scalar::all(1e-2));
+}
+
+/**
+ * @brief 用本帧的观测更新跟踪状态
+ * @param track 跟踪状态
+ * @param measured 是否有观测
+ * @param xTop 观测的上沿横坐标
+ * @param xBottom 观测的下沿横坐标
+ * @return 平滑后的车道线
+ *
+ * 与预测相差太大的观测视为误检而忽略，连续误检说明车道确实变了（如变道），此时重新初始化；
+ * 没有观测时沿用预测值，速度减半避免外推过远
+ */
+LaneLine LaneDetector::updateTrack(LaneTrack& track, bool measured, double xTop, double xBottom)
+{
+    auto reset = [&]() {
+        initFilter(track);
+        track.filter.statePost = (cv::Mat_<float>(4, 1) << xBottom, xTop, 0, 0);
+        track.initialized = true;
+        track.missed = 0;
+    };
+
+    if (!track.initialized) {
+        if (!measured)
+            return LaneLine();
+        reset();
+    } else {
+        const cv::Mat& prediction = track.filter.predict();
+        const bool outlier = measured && (std::abs(xBottom - prediction.at<float>(0)) > kGate
+                                          || std::abs(xTop - prediction.at<float>(1)) > kGate);
+        if (outlier && track.missed >= kReacquireAfter) {
+            reset();
+        } else if (measured && !outlier) {
+            const cv::Mat measurement = (cv::Mat_<float>(2, 1) << xBottom, xTop);
+            track.filter.correct(measurement);
+            track.missed = 0;
+        } else {
+            track.filter.statePost.at<float>(2) *= 0.5f;
+            track.filter.statePost.at<float>(3) *= 0.5f;
+            if (++track.missed > kMaxMissedFrames) {
+                track.initialized = false;
+                return LaneLine();
+            }
+        }
+    }
+
+    LaneLine lane;
+    lane.valid = true;
+    lane.xBottom = track.filter.statePost.at<float>(0);
+    lane.xTop = track.filter.statePost.at<float>(1);
+    return lane;
+}
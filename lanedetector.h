@@ -0,0 +1,203 @@
+/**
+ * @file lanedetector.h
+ * @brief 车道线检测线程的头文件
+ *
+ * 该文件定义了LaneDetector类，在独立线程中对前视摄像头的画面做车道线检测：
+ * 透视裁剪、缩小、顶帽滤波提取亮线、直线拟合，再用卡尔曼滤波做时间平滑。
+ */
+#ifndef LANEDETECTOR_H
+#define LANEDETECTOR_H
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/video/tracking.hpp>
+
+#include "frameanalyzer.h"
+#include "framemailbox.h"
+#include "lanegeometry.h"
+
+class OverlayChannel;
+
+/**
+ * @class LaneDetector
+ * @brief 车道线检测线程
+ *
+ * 解码线程通过submit()只取画面下部的检测区域，取红色通道（白线和黄线都较亮）缩小放入信箱，
+ * 检测线程只处理最新一帧。每帧的处理：
+ * 1. 水平方向的形态学顶帽，提取比两侧路面亮的窄条，对光照变化不敏感（OpenCV的形态学运算有SIMD实现）
+ * 2. 阈值化后用梯形掩码去掉检测区域上部两侧的路边和护栏
+ * 3. 按上一帧的车道中心把候选点分为左右两组，有跟踪结果时只保留预测位置附近的点
+ * 4. 每组用Huber鲁棒拟合直线，按倾斜方向排除不合理的结果
+ * 5. 每条车道线的上下端点由恒速模型的卡尔曼滤波平滑，短暂丢失时沿用预测值
+ * 结果有变化时在检测线程中转换为折线和多边形，直接发布到画面块叠加层的通道，不经过界面线程
+ */
+class LaneDetector : public QThread, public FrameAnalyzer
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit LaneDetector(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，停止线程
+     */
+    ~LaneDetector() override;
+
+    /**
+     * @brief 提交一帧画面（由解码线程调用）
+     * @param frame 已解码的帧
+     *
+     * 只处理检测区域，线程未运行时直接返回
+     */
+    void submit(const CameraFrame& frame) override;
+
+    /**
+     * @brief 停止线程
+     */
+    void stop();
+
+    /**
+     * @brief 设置发布检测结果的叠加层通道（线程启动前调用）
+     * @param channel 画面块叠加层的通道，须在线程停止后才销毁；为nullptr时不发布
+     */
+    void setOverlayChannel(OverlayChannel *channel) { m_overlay = channel; }
+
+    /**
+     * @brief 检测一帧（仅检测线程或线程未运行时调用）
+     * @param roi 检测区域的单通道图像，宽度不超过kAnalysisWidth
+     * @param timeUs 采集时刻（单调时钟，微秒）
+     * @return 检测结果
+     */
+    LaneGeometry processFrame(const cv::Mat& roi, qint64 timeUs);
+
+    /**
+     * @brief 获取已处理的帧数（线程安全）
+     * @return 帧数
+     */
+    quint64 processedFrames() const { return m_processedFrames.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取平均每帧处理耗时（线程安全）
+     * @return 毫秒
+     */
+    double meanProcessMs() const;
+
+    /**
+     * @brief 获取单帧最长处理耗时（线程安全）
+     * @return 毫秒
+     */
+    double maxProcessMs() const { return m_maxProcessUs.load(std::memory_order_relaxed) / 1000.0; }
+
+    static constexpr int kAnalysisWidth = 256;      ///< 检测区域缩小后的宽度
+    static constexpr double kRoiTop = 0.6;          ///< 检测区域上沿（相对画面高度）
+    static constexpr double kRoiBottom = 0.95;      ///< 检测区域下沿，去掉车头
+
+protected:
+    /**
+     * @brief 线程主函数，等待并处理最新一帧
+     */
+    void run() override;
+
+private:
+    /**
+     * @struct AnalysisFrame
+     * @brief 信箱中的一帧检测区域
+     */
+    struct AnalysisFrame
+    {
+        cv::Mat channel;            ///< 检测区域的红色通道（中间结果，复用缓冲区）
+        cv::Mat roi;                ///< 缩小后的检测区域
+        qint64 captureTimeUs = 0;   ///< 采集时刻
+    };
+
+    /**
+     * @struct LaneTrack
+     * @brief 一条车道线的卡尔曼跟踪状态
+     *
+     * 状态为上下端点的横坐标及其每帧变化量，观测为上下端点的横坐标，单位为检测区域宽度的比例
+     */
+    struct LaneTrack
+    {
+        cv::KalmanFilter filter;    ///< 卡尔曼滤波器
+        bool initialized = false;   ///< 是否已有观测
+        int missed = 0;             ///< 连续没有观测的帧数
+    };
+
+    /**
+     * @brief 按检测区域尺寸重建掩码和形态学核
+     * @param size 检测区域尺寸
+     */
+    void prepare(const cv::Size& size);
+
+    /**
+     * @brief 预测的车道线在某一行的横坐标
+     * @param track 跟踪状态
+     * @param y 行（检测区域坐标）
+     * @return 横坐标（检测区域坐标）
+     */
+    double predictedX(const LaneTrack& track, double y) const;
+
+    /**
+     * @brief 用候选点拟合一条车道线
+     * @param points 候选点
+     * @param leftSide 是否为左车道线
+     * @param xTop 输出上沿处的横坐标（检测区域宽度的比例）
+     * @param xBottom 输出下沿处的横坐标（检测区域宽度的比例）
+     * @return 是否拟合成功
+     */
+    bool fitLane(const std::vector<cv::Point>& points, bool leftSide, double& xTop, double& xBottom);
+
+    /**
+     * @brief 用本帧的观测更新跟踪状态
+     * @param track 跟踪状态
+     * @param measured 是否有观测
+     * @param xTop 观测的上沿横坐标
+     * @param xBottom 观测的下沿横坐标
+     * @return 平滑后的车道线
+     */
+    LaneLine updateTrack(LaneTrack& track, bool measured, double xTop, double xBottom);
+
+    /**
+     * @brief 初始化卡尔曼滤波器
+     * @param track 跟踪状态
+     */
+    static void initFilter(LaneTrack& track);
+
+    FrameMailbox<AnalysisFrame> m_mailbox;      ///< 最新帧信箱
+    std::atomic<bool> m_accepting;              ///< 线程是否在运行并接收新帧
+    QMutex m_wakeMutex;                         ///< 唤醒互斥锁
+    QWaitCondition m_wake;                      ///< 新帧通知
+    bool m_frameReady;                          ///< 是否有未处理的新帧（受m_wakeMutex保护）
+
+    OverlayChannel *m_overlay;                  ///< 发布检测结果的叠加层通道
+
+    // 以下仅检测线程访问
+    cv::Size m_preparedSize;                    ///< 掩码对应的检测区域尺寸
+    cv::Mat m_mask;                             ///< 梯形掩码
+    cv::Mat m_kernel;                           ///< 顶帽运算的水平结构元素
+    cv::Mat m_tophat;                           ///< 顶帽结果（复用缓冲区）
+    cv::Mat m_binary;                           ///< 阈值化结果（复用缓冲区）
+    std::vector<cv::Point> m_points;            ///< 全部候选点
+    std::vector<cv::Point> m_leftPoints;        ///< 左侧候选点
+    std::vector<cv::Point> m_rightPoints;       ///< 右侧候选点
+    std::vector<cv::Point> m_fitPoints;         ///< 参与拟合的抽样点
+    LaneTrack m_left;                           ///< 左车道线跟踪
+    LaneTrack m_right;                          ///< 右车道线跟踪
+    LaneGeometry m_published;                   ///< 上一次发布的结果
+
+    std::atomic<quint64> m_processedFrames;     ///< 已处理的帧数
+    std::atomic<qint64> m_totalProcessUs;       ///< 处理耗时总和
+    std::atomic<qint64> m_maxProcessUs;         ///< 单帧最长处理耗时
+};
+
+#endif // LANEDETECTOR_H
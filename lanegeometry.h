@@ -0,0 +1,53 @@
+/**
+ * @file lanegeometry.h
+ * @brief 车道线几何数据的头文件
+ *
+ * 该文件定义了LaneLine和LaneGeometry，是车道线检测的矢量结果，
+ * 由检测线程转换为叠加图元发布到画面块的叠加层，不写入画面像素。
+ */
+#ifndef LANEGEOMETRY_H
+#define LANEGEOMETRY_H
+
+#include <QtGlobal>
+
+/**
+ * @struct LaneLine
+ * @brief 一条车道线，在检测区域内近似为直线段
+ *
+ * 横坐标为相对画面宽度的比例（0~1），与画面块的显示尺寸无关
+ */
+struct LaneLine
+{
+    bool valid = false;     ///< 是否检测到（含短暂丢失期间的预测）
+    double xTop = 0.0;      ///< 检测区域上沿处的横坐标
+    double xBottom = 0.0;   ///< 检测区域下沿处的横坐标
+
+    bool operator==(const LaneLine& other) const
+    {
+        return valid == other.valid && xTop == other.xTop && xBottom == other.xBottom;
+    }
+    bool operator!=(const LaneLine& other) const { return !(*this == other); }
+};
+
+/**
+ * @struct LaneGeometry
+ * @brief 一帧的车道线检测结果
+ *
+ * 纵坐标为相对画面高度的比例（0~1）
+ */
+struct LaneGeometry
+{
+    LaneLine left;              ///< 左车道线
+    LaneLine right;             ///< 右车道线
+    double yTop = 0.0;          ///< 检测区域上沿
+    double yBottom = 1.0;       ///< 检测区域下沿
+    qint64 captureTimeUs = 0;   ///< 对应帧的采集时刻（单调时钟，微秒）
+
+    /**
+     * @brief 是否至少有一条车道线
+     * @return 是否有车道线
+     */
+    bool hasLanes() const { return left.valid || right.valid; }
+};
+
+#endif // LANEGEOMETRY_H
@@ -0,0 +1,147 @@
+/**
+ * @file latencystats.cpp
+ * @brief 单路摄像头延迟统计的实现文件
+ */
+#include "latencystats.h"
+
+#include <cmath>
+
+namespace {
+
+// 各阶段耗时滑动平均的权重
+constexpr double kAverageWeight = 0.05;
+
+/**
+ * @brief 更新滑动平均值，第一次直接取样本值
+ * @param average 滑动平均值
+ * @param sample 新样本
+ * @param first 是否第一个样本
+ */
+void updateAverage(double& average, qint64 sample, bool first)
+{
+    average = first ? sample : average * (1.0 - kAverageWeight) + sample * kAverageWeight;
+}
+
+} // namespace
+
+/**
+ * @brief LatencyStats类的构造函数
+ * @param windowUs 统计窗口长度
+ */
+LatencyStats::LatencyStats(qint64 windowUs)
+    : m_windowUs(qMax<qint64>(1, windowUs))
+{
+    reset();
+}
+
+/**
+ * @brief 记录一帧已显示的帧
+ * @param timing 帧时间戳
+ */
+void LatencyStats::record(const FrameTiming& timing)
+{
+    // 窗口到期后丢弃更早的窗口，开始新窗口
+    if (timing.presentUs - m_windowStartUs >= m_windowUs) {
+        m_current ^= 1;
+        m_windows[m_current] = Window();
+        m_windowStartUs = timing.presentUs;
+    }
+
+    if (m_lastSequence != 0 && timing.sequence > m_lastSequence + 1) {
+        m_dropped += timing.sequence - m_lastSequence - 1;
+    }
+    m_lastSequence = timing.sequence;
+
+    const qint64 totalUs = qMax<qint64>(0, timing.totalUs());
+    const int bucket = static_cast<int>(qMin<qint64>(totalUs / 1000, kBucketCount - 1));
+    Window& window = m_windows[m_current];
+    ++window.buckets[bucket];
+    ++window.count;
+    window.maxUs = qMax(window.maxUs, totalUs);
+    m_worstUs = qMax(m_worstUs, totalUs);
+    m_totalUs += totalUs;
+
+    const bool first = m_frames == 0;
+    updateAverage(m_decodeAvgUs, timing.decodeUs - timing.captureUs, first);
+    updateAverage(m_convertAvgUs, timing.convertUs - timing.decodeUs, first);
+    updateAverage(m_presentAvgUs, timing.presentUs - timing.convertUs, first);
+    ++m_frames;
+
+    // 显示节奏：间隔均匀时偏差接近0，与显示刷新拍频产生顿挫时偏差明显增大
+    if (m_lastPresentUs != 0) {
+        const qint64 intervalUs = timing.presentUs - m_lastPresentUs;
+        const bool firstInterval = m_intervals == 0;
+        updateAverage(m_intervalAvgUs, intervalUs, firstInterval);
+        updateAverage(m_jitterAvgUs, static_cast<qint64>(std::abs(intervalUs - m_intervalAvgUs)), firstInterval);
+        ++m_intervals;
+    }
+    m_lastPresentUs = timing.presentUs;
+}
+
+/**
+ * @brief 获取统计摘要
+ * @return 统计摘要
+ */
+LatencyStats::Summary LatencyStats::summary() const
+{
+    Summary result;
+    result.frames = m_frames;
+    result.dropped = m_dropped;
+    result.p50Ms = percentileMs(0.50);
+    result.p99Ms = percentileMs(0.99);
+    result.maxMs = qMax(m_windows[0].maxUs, m_windows[1].maxUs) / 1000.0;
+    result.worstMs = m_worstUs / 1000.0;
+    result.totalMs = m_totalUs / 1000.0;
+    result.decodeMs = m_decodeAvgUs / 1000.0;
+    result.convertMs = m_convertAvgUs / 1000.0;
+    result.presentMs = m_presentAvgUs / 1000.0;
+    result.intervalMs = m_intervalAvgUs / 1000.0;
+    result.jitterMs = m_jitterAvgUs / 1000.0;
+    return result;
+}
+
+/**
+ * @brief 清空所有统计
+ */
+void LatencyStats::reset()
+{
+    m_windows[0] = Window();
+    m_windows[1] = Window();
+    m_current = 0;
+    m_windowStartUs = 0;
+    m_frames = 0;
+    m_dropped = 0;
+    m_lastSequence = 0;
+    m_worstUs = 0;
+    m_totalUs = 0;
+    m_decodeAvgUs = 0.0;
+    m_convertAvgUs = 0.0;
+    m_presentAvgUs = 0.0;
+    m_lastPresentUs = 0;
+    m_intervals = 0;
+    m_intervalAvgUs = 0.0;
+    m_jitterAvgUs = 0.0;
+}
+
+/**
+ * @brief 计算两个窗口合并后的百分位数
+ * @param fraction 百分位
+ * @return 延迟（毫秒）
+ */
+double LatencyStats::percentileMs(double fraction) const
+{
+    const quint64 total = m_windows[0].count + m_windows[1].count;
+    if (total == 0)
+        return 0.0;
+
+    // 第rank个样本所在的桶，rank从1开始
+    const quint64 rank = qMax<quint64>(1, static_cast<quint64>(fraction * total + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < kBucketCount - 1; ++i) {
+        seen += m_windows[0].buckets[i] + m_windows[1].buckets[i];
+        if (seen >= rank)
+            return i + 1.0;
+    }
+    // 落在溢出桶中，用窗口最大值代替
+    return qMax(m_windows[0].maxUs, m_windows[1].maxUs) / 1000.0;
+}
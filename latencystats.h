@@ -0,0 +1,111 @@
+/**
+ * @file latencystats.h
+ * @brief 单路摄像头延迟统计的头文件
+ *
+ * 该文件定义了LatencyStats类，用固定桶直方图统计采集到显示的延迟分布和丢帧数，
+ * 同时统计相邻两次显示的间隔及其抖动，
+ * 记录一帧只需几次整数运算，不分配内存。
+ */
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <QtGlobal>
+
+#include <array>
+
+#include "frametiming.h"
+
+/**
+ * @class LatencyStats
+ * @brief 单路摄像头的延迟直方图与丢帧计数
+ *
+ * 直方图按1毫秒分桶，覆盖0~999毫秒，更大的值计入最后一个桶。
+ * 使用两个交替的时间窗口，百分位数反映最近一到两个窗口的情况；
+ * 百分位数取桶的上沿，偏保守。非线程安全，只在界面线程中使用。
+ */
+class LatencyStats
+{
+public:
+    /**
+     * @struct Summary
+     * @brief 统计摘要，时间单位均为毫秒
+     */
+    struct Summary
+    {
+        quint64 frames = 0;         ///< 已显示的帧数
+        quint64 dropped = 0;        ///< 采集后未显示就被覆盖的帧数
+        double p50Ms = 0.0;         ///< 最近窗口的中位延迟
+        double p99Ms = 0.0;         ///< 最近窗口的99%延迟
+        double maxMs = 0.0;         ///< 最近窗口的最大延迟
+        double worstMs = 0.0;       ///< 启动以来的最大延迟
+        double totalMs = 0.0;       ///< 启动以来各帧延迟之和，两次摘要相减得到区间内的平均延迟
+        double decodeMs = 0.0;      ///< 采集到解码完成的平均耗时
+        double convertMs = 0.0;     ///< 解码完成到缩放完成的平均耗时
+        double presentMs = 0.0;     ///< 缩放完成到绘制完成的平均耗时
+        double intervalMs = 0.0;    ///< 相邻两次显示的平均间隔
+        double jitterMs = 0.0;      ///< 显示间隔相对平均间隔的平均偏差
+    };
+
+    /**
+     * @brief 构造函数
+     * @param windowUs 统计窗口长度（微秒），默认10秒
+     */
+    explicit LatencyStats(qint64 windowUs = 10000000);
+
+    /**
+     * @brief 记录一帧已显示的帧
+     * @param timing 帧时间戳，presentUs必须已填写
+     */
+    void record(const FrameTiming& timing);
+
+    /**
+     * @brief 获取统计摘要
+     * @return 统计摘要
+     */
+    Summary summary() const;
+
+    /**
+     * @brief 清空所有统计
+     */
+    void reset();
+
+private:
+    static constexpr int kBucketCount = 1000;   ///< 直方图桶数（每桶1毫秒）
+
+    /**
+     * @struct Window
+     * @brief 一个时间窗口内的直方图
+     */
+    struct Window
+    {
+        std::array<quint32, kBucketCount> buckets{};    ///< 各桶的帧数
+        quint64 count = 0;                              ///< 窗口内的帧数
+        qint64 maxUs = 0;                               ///< 窗口内的最大延迟
+    };
+
+    /**
+     * @brief 计算两个窗口合并后的百分位数
+     * @param fraction 百分位（0~1）
+     * @return 延迟（毫秒）
+     */
+    double percentileMs(double fraction) const;
+
+    qint64 m_windowUs;          ///< 窗口长度
+    Window m_windows[2];        ///< 当前窗口和上一个窗口
+    int m_current;              ///< 当前窗口下标
+    qint64 m_windowStartUs;     ///< 当前窗口的起始时刻
+    quint64 m_frames;           ///< 已显示的帧数
+    quint64 m_dropped;          ///< 丢帧数
+    quint64 m_lastSequence;     ///< 上一次显示的帧序号
+    qint64 m_worstUs;           ///< 启动以来的最大延迟
+    qint64 m_totalUs;           ///< 启动以来的延迟之和
+    double m_decodeAvgUs;       ///< 解码阶段耗时滑动平均
+    double m_convertAvgUs;      ///< 缩放阶段耗时滑动平均
+    double m_presentAvgUs;      ///< 绘制阶段耗时滑动平均
+    qint64 m_lastPresentUs;     ///< 上一帧的显示时刻
+    quint64 m_intervals;        ///< 已统计的显示间隔数
+    double m_intervalAvgUs;     ///< 显示间隔滑动平均
+    double m_jitterAvgUs;       ///< 显示间隔偏差滑动平均
+};
+
+#endif // LATENCYSTATS_H
@@ -3,8 +3,35 @@
  * @brief 高级驾驶辅助系统(ADAS)应用程序的入口点
  */
 #include "adasdisplay.h"
+#include "perfreport.h"
+#include "stageprofiler.h"
+#include "startuptimeline.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QTimer>
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief 在创建QApplication之前检查是否指定了--headless
+ * @param argc 命令行参数数量
+ * @param argv 命令行参数数组
+ * @return 是否无界面运行
+ */
+bool hasHeadlessFlag(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace
 
 /**
  * @brief 应用程序入口函数
@@ -12,14 +39,166 @@
  * @param argv 命令行参数数组
  * @return 应用程序退出代码
  * 
- * 创建Qt应用程序实例和ADAS显示界面，并启动应用程序的事件循环
+ * 创建Qt应用程序实例和ADAS显示界面，并启动应用程序的事件循环。
+ * 通过--cameras指定摄像头配置文件，或通过--synthetic使用多路合成摄像头做压力测试，
+ * 都未指定或配置读取失败时使用默认配置。
+ * --headless使用offscreen平台插件运行完整的采集→解码→缩放→绘制流程，
+ * 到达--duration指定的时间后写入性能报告并退出，用于夜间的长时间运行测试。
+ * --can指定车速等车辆信号的来源，可以是SocketCAN接口或candump日志；
+ * --face-models指定驾驶员疲劳监测使用的级联模型目录，默认在OpenCV的安装目录中查找；
+ * --lane-camera对指定索引的摄像头做车道线检测，如回放前视录像时；
+ * --vehicle-model指定车辆/行人检测的ONNX模型，--detector-cores限制推理占用的CPU
  */
 int main(int argc, char *argv[])
 {
+    StartupTimeline::markProcessStart();
+    
+    // 平台插件必须在创建QApplication之前选定
+    const bool headless = hasHeadlessFlag(argc, argv);
+    if (headless && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    
     QApplication app(argc, argv);
     
-    ADASDisplay display;
+    QCommandLineParser parser;
+    parser.setApplicationDescription("ADAS显示系统");
+    parser.addHelpOption();
+    QCommandLineOption camerasOption("cameras", "摄像头配置文件（INI格式）", "file");
+    QCommandLineOption syntheticOption("synthetic", "使用指定数量的合成摄像头（压力测试）", "count");
+    QCommandLineOption syntheticSizeOption("synthetic-size", "合成摄像头分辨率", "WxH", "1920x1080");
+    QCommandLineOption syntheticFpsOption("synthetic-fps", "合成摄像头帧率", "fps", "30");
+    QCommandLineOption replayOption("replay", "回放录像文件，多个文件用逗号分隔", "files");
+    QCommandLineOption sessionOption("session", "回放事件录像会话文件（.adss）", "file");
+    QCommandLineOption replayStartOption("replay-start", "回放起始位置（相对录像开始）", "seconds");
+    QCommandLineOption replaySpeedOption("replay-speed", "回放速度倍数，0表示尽可能快", "factor", "1");
+    QCommandLineOption headlessOption("headless", "无界面运行（offscreen平台），结束时写入性能报告");
+    QCommandLineOption durationOption("duration", "无界面运行的时长", "seconds", "60");
+    QCommandLineOption reportOption("report", "性能报告文件", "file", "perf_report.json");
+    QCommandLineOption recordDirOption("record-dir", "报警事件录像的保存目录", "dir", "recordings");
+    QCommandLineOption canOption("can", "车辆信号来源：can:<接口名>或candump日志文件", "source");
+    QCommandLineOption canSignalsOption("can-signals", "CAN信号表文件（INI格式）", "file");
+    QCommandLineOption noGovernorOption("no-governor", "不按显示延迟自动降低摄像头画质");
+    QCommandLineOption faceModelsOption("face-models", "驾驶员监测的Haar级联模型目录", "dir");
+    QCommandLineOption laneCameraOption("lane-camera", "对指定摄像头做车道线检测", "index");
+    QCommandLineOption vehicleModelOption("vehicle-model", "车辆/行人检测模型（YOLOv8格式的ONNX）", "file");
+    QCommandLineOption detectorCoresOption("detector-cores", "车辆检测推理的CPU预算（核数）", "cores", "1");
+    parser.addOption(camerasOption);
+    parser.addOption(syntheticOption);
+    parser.addOption(syntheticSizeOption);
+    parser.addOption(syntheticFpsOption);
+    parser.addOption(replayOption);
+    parser.addOption(sessionOption);
+    parser.addOption(replayStartOption);
+    parser.addOption(replaySpeedOption);
+    parser.addOption(headlessOption);
+    parser.addOption(durationOption);
+    parser.addOption(reportOption);
+    parser.addOption(recordDirOption);
+    parser.addOption(canOption);
+    parser.addOption(canSignalsOption);
+    parser.addOption(noGovernorOption);
+    parser.addOption(faceModelsOption);
+    parser.addOption(laneCameraOption);
+    parser.addOption(vehicleModelOption);
+    parser.addOption(detectorCoresOption);
+    parser.process(app);
+    
+    CameraRegistry registry = CameraRegistry::defaults();
+    if (parser.isSet(syntheticOption)) {
+        const QStringList size = parser.value(syntheticSizeOption).split('x');
+        FrameSourceConfig source;
+        if (size.size() == 2) {
+            source.width = size[0].toInt();
+            source.height = size[1].toInt();
+        }
+        source.fps = parser.value(syntheticFpsOption).toInt();
+        registry = CameraRegistry::synthetic(qMax(1, parser.value(syntheticOption).toInt()), source);
+    } else if (parser.isSet(sessionOption)) {
+        bool ok = false;
+        CameraRegistry session = CameraRegistry::fromSession(parser.value(sessionOption), &ok);
+        if (ok) {
+            registry = session;
+        } else {
+            std::cerr << "会话文件无效，使用默认配置" << std::endl;
+        }
+    } else if (parser.isSet(replayOption)) {
+        registry = CameraRegistry::fromLocations(parser.value(replayOption).split(','));
+    } else if (parser.isSet(camerasOption)) {
+        bool ok = false;
+        CameraRegistry configured = CameraRegistry::fromSettings(parser.value(camerasOption), &ok);
+        if (ok) {
+            registry = configured;
+        } else {
+            std::cerr << "摄像头配置无效，使用默认配置" << std::endl;
+        }
+    }
+    
+    if (parser.isSet(replaySpeedOption)) {
+        registry.setReplaySpeed(parser.value(replaySpeedOption).toDouble());
+    }
+    if (parser.isSet(replayStartOption)) {
+        registry.setReplayStart(static_cast<qint64>(parser.value(replayStartOption).toDouble() * 1000000.0));
+    }
+    if (parser.isSet(laneCameraOption)) {
+        registry.setLaneDetection(parser.value(laneCameraOption).toInt(), true);
+    }
+    
+    // 报告从界面创建前开始计时，帧率包含启动阶段
+    PerfReport report;
+    if (headless) {
+        StageProfiler::setEnabled(true);
+    }
+    
+    ADASDisplay display(registry);
+    display.setRecordingDirectory(parser.value(recordDirOption));
+    if (parser.isSet(noGovernorOption)) {
+        display.setQualityGovernorEnabled(false);
+    }
+    if (parser.isSet(faceModelsOption)) {
+        display.setDriverModelDirectory(parser.value(faceModelsOption));
+    }
+    if (parser.isSet(detectorCoresOption)) {
+        display.setDetectorCpuBudget(parser.value(detectorCoresOption).toDouble());
+    }
+    if (parser.isSet(vehicleModelOption)) {
+        display.setVehicleModel(parser.value(vehicleModelOption));
+    }
+    if (parser.isSet(canOption)) {
+        QVector<CanSignalDef> table = CanSignalDecoder::defaultTable();
+        if (parser.isSet(canSignalsOption)) {
+            bool ok = false;
+            const QVector<CanSignalDef> configured = CanSignalDecoder::fromSettings(parser.value(canSignalsOption), &ok);
+            if (ok) {
+                table = configured;
+            } else {
+                std::cerr << "CAN信号表无效，使用默认信号表" << std::endl;
+            }
+        }
+        // candump日志与录像使用相同的回放速度
+        CanSourceConfig canConfig;
+        if (parser.isSet(replaySpeedOption)) {
+            const double speed = parser.value(replaySpeedOption).toDouble();
+            canConfig.realtime = speed > 0.0;
+            canConfig.speed = speed > 0.0 ? speed : 1.0;
+        }
+        display.startVehicleSignals(parser.value(canOption), table, canConfig);
+    }
     display.show();
     
+    if (headless) {
+        const QString reportPath = parser.value(reportOption);
+        const int durationMs = qMax(1, parser.value(durationOption).toInt()) * 1000;
+        QTimer::singleShot(durationMs, &app, [&]() {
+            display.fillPerfReport(report);
+            if (report.write(reportPath)) {
+                std::cout << "性能报告已写入: " << reportPath.toStdString() << std::endl;
+            } else {
+                std::cerr << "无法写入性能报告: " << reportPath.toStdString() << std::endl;
+            }
+            app.quit();
+        });
+    }
+    
     return app.exec();
 }
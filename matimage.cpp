@@ -0,0 +1,55 @@
+/**
+ * @file matimage.cpp
+ * @brief OpenCV图像与Qt图像之间转换的实现文件
+ */
+#include "matimage.h"
+#include "framecopycounter.h"
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+/**
+ * @brief 释放QImage借用的Mat引用
+ * @param info 指向持有缓冲区引用的cv::Mat
+ *
+ * 作为QImage的清理回调，在最后一个共享该缓冲区的QImage销毁时调用
+ */
+void releaseBorrowedMat(void *info)
+{
+    delete static_cast<cv::Mat*>(info);
+}
+
+} // namespace
+
+/**
+ * @brief 将OpenCV的Mat转换为QImage
+ * @param mat OpenCV的Mat图像
+ * @return 转换后的QImage
+ *
+ * Qt 5.14及以上支持BGR888格式，无需颜色转换也无需拷贝；
+ * 更早的版本只做一次BGR到RGB的转换
+ */
+QImage matToQImage(const cv::Mat& mat)
+{
+    // 检查图像是否为空
+    if (mat.empty() || mat.type() != CV_8UC3)
+        return QImage();
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    const cv::Mat *holder = new cv::Mat(mat);
+    const QImage::Format format = QImage::Format_BGR888;
+#else
+    // 转换颜色空间从BGR到RGB，这是唯一的一次像素遍历
+    cv::Mat *holder = new cv::Mat();
+    cv::cvtColor(mat, *holder, cv::COLOR_BGR2RGB);
+    FrameCopyCounter::recordAllocation();
+    FrameCopyCounter::recordPixelPass(static_cast<qint64>(holder->total() * holder->elemSize()));
+    const QImage::Format format = QImage::Format_RGB888;
+#endif
+
+    // 使用只读构造，QImage不会写入借用的缓冲区
+    return QImage(static_cast<const uchar*>(holder->data), holder->cols, holder->rows,
+                  static_cast<int>(holder->step), format,
+                  releaseBorrowedMat, const_cast<cv::Mat*>(holder));
+}
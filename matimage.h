@@ -0,0 +1,22 @@
+/**
+ * @file matimage.h
+ * @brief OpenCV图像与Qt图像之间转换的头文件
+ */
+#ifndef MATIMAGE_H
+#define MATIMAGE_H
+
+#include <QImage>
+
+#include <opencv2/core.hpp>
+
+/**
+ * @brief 将OpenCV的Mat零拷贝地包装为QImage
+ * @param mat BGR格式的OpenCV图像（CV_8UC3）
+ * @return 借用Mat缓冲区的QImage，格式不支持时返回空图像
+ *
+ * QImage持有Mat的一个引用，最后一个共享该缓冲区的QImage销毁时释放。
+ * 采集端在复用缓冲区前检查引用计数，因此被借用的缓冲区不会被覆盖
+ */
+QImage matToQImage(const cv::Mat& mat);
+
+#endif // MATIMAGE_H
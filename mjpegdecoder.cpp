@@ -0,0 +1,139 @@
+/**
+ * @file mjpegdecoder.cpp
+ * @brief 基于libjpeg-turbo的MJPEG解码器的实现文件
+ */
+#include "mjpegdecoder.h"
+
+#include <csetjmp>
+#include <cstdio>
+
+#include <jpeglib.h>
+
+#include <opencv2/imgproc.hpp>
+
+/**
+ * @struct MjpegDecoderContext
+ * @brief libjpeg解码上下文及错误处理
+ *
+ * libjpeg通过error_exit报告致命错误，这里用longjmp跳回decode()，
+ * 因此setjmp之后不能构造带析构函数的局部对象
+ */
+struct MjpegDecoderContext
+{
+    jpeg_decompress_struct info;
+    jpeg_error_mgr errorManager;
+    std::jmp_buf jump;
+};
+
+namespace {
+
+/**
+ * @brief libjpeg致命错误回调，跳回decode()
+ */
+void onJpegError(j_common_ptr info)
+{
+    MjpegDecoderContext *context = static_cast<MjpegDecoderContext*>(info->client_data);
+    std::longjmp(context->jump, 1);
+}
+
+/**
+ * @brief libjpeg警告回调，摄像头的MJPEG常有不影响显示的小错误，不输出
+ */
+void onJpegMessage(j_common_ptr info)
+{
+    (void)info;
+}
+
+} // namespace
+
+/**
+ * @brief MjpegDecoder类的构造函数，创建解码上下文
+ */
+MjpegDecoder::MjpegDecoder()
+    : m_context(new MjpegDecoderContext())
+{
+    m_context->info.err = jpeg_std_error(&m_context->errorManager);
+    m_context->errorManager.error_exit = onJpegError;
+    m_context->errorManager.output_message = onJpegMessage;
+    jpeg_create_decompress(&m_context->info);
+    m_context->info.client_data = m_context.get();
+}
+
+/**
+ * @brief MjpegDecoder类的析构函数，销毁解码上下文
+ */
+MjpegDecoder::~MjpegDecoder()
+{
+    jpeg_destroy_decompress(&m_context->info);
+}
+
+/**
+ * @brief 解码一帧MJPEG数据为BGR图像
+ * @param data 压缩数据首地址
+ * @param size 压缩数据字节数
+ * @param targetSize 显示目标尺寸
+ * @param out 输出的BGR图像
+ * @return 是否解码成功
+ *
+ * UVC摄像头输出的MJPEG通常省略Huffman表，libjpeg-turbo会自动使用标准表
+ */
+bool MjpegDecoder::decode(const unsigned char *data, std::size_t size, const cv::Size& targetSize, cv::Mat& out)
+{
+    if (!data || size == 0)
+        return false;
+
+    jpeg_decompress_struct& info = m_context->info;
+    if (setjmp(m_context->jump)) {
+        jpeg_abort_decompress(&info);
+        return false;
+    }
+
+    jpeg_mem_src(&info, const_cast<unsigned char*>(data), static_cast<unsigned long>(size));
+    if (jpeg_read_header(&info, TRUE) != JPEG_HEADER_OK) {
+        jpeg_abort_decompress(&info);
+        return false;
+    }
+
+    const cv::Size sourceSize(static_cast<int>(info.image_width), static_cast<int>(info.image_height));
+    info.scale_num = 1;
+    info.scale_denom = static_cast<unsigned int>(chooseScaleDenom(sourceSize, targetSize));
+#ifdef JCS_EXTENSIONS
+    info.out_color_space = JCS_EXT_BGR;
+#else
+    info.out_color_space = JCS_RGB;
+#endif
+    // 显示用途，优先速度
+    info.dct_method = JDCT_IFAST;
+    info.do_fancy_upsampling = FALSE;
+
+    jpeg_start_decompress(&info);
+    out.create(static_cast<int>(info.output_height), static_cast<int>(info.output_width), CV_8UC3);
+    while (info.output_scanline < info.output_height) {
+        JSAMPROW row = out.ptr<JSAMPLE>(static_cast<int>(info.output_scanline));
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+    jpeg_finish_decompress(&info);
+
+#ifndef JCS_EXTENSIONS
+    cv::cvtColor(out, out, cv::COLOR_RGB2BGR);
+#endif
+    return true;
+}
+
+/**
+ * @brief 选择不小于目标尺寸的最大DCT缩放分母
+ * @param sourceSize 原图尺寸
+ * @param targetSize 目标尺寸
+ * @return 缩放分母
+ */
+int MjpegDecoder::chooseScaleDenom(const cv::Size& sourceSize, const cv::Size& targetSize)
+{
+    if (targetSize.width <= 0 || targetSize.height <= 0)
+        return 1;
+
+    for (int denom = 8; denom > 1; denom /= 2) {
+        if (sourceSize.width / denom >= targetSize.width && sourceSize.height / denom >= targetSize.height)
+            return denom;
+    }
+    return 1;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file mjpegdecoder.h
+ * @brief 基于libjpeg-turbo的MJPEG解码器的头文件
+ */
+#ifndef MJPEGDECODER_H
+#define MJPEGDECODER_H
+
+#include <cstddef>
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+struct MjpegDecoderContext;
+
+/**
+ * @class MjpegDecoder
+ * @brief 支持DCT域缩放的MJPEG解码器
+ *
+ * 目标尺寸小于原图时，利用libjpeg-turbo在DCT域直接按1/2、1/4、1/8解码，
+ * 跳过不需要的高频系数，比先全尺寸解码再缩小省下大部分计算量。
+ * 解码上下文在多帧之间复用；同一对象不能被多个线程同时使用。
+ */
+class MjpegDecoder
+{
+public:
+    MjpegDecoder();
+    ~MjpegDecoder();
+
+    MjpegDecoder(const MjpegDecoder&) = delete;
+    MjpegDecoder& operator=(const MjpegDecoder&) = delete;
+
+    /**
+     * @brief 解码一帧MJPEG数据为BGR图像
+     * @param data 压缩数据首地址
+     * @param size 压缩数据字节数
+     * @param targetSize 显示目标尺寸，为空时按原尺寸解码
+     * @param out 输出的BGR图像，尺寸不变时复用其缓冲区
+     * @return 是否解码成功
+     */
+    bool decode(const unsigned char *data, std::size_t size, const cv::Size& targetSize, cv::Mat& out);
+
+    /**
+     * @brief 选择不小于目标尺寸的最大DCT缩放分母
+     * @param sourceSize 原图尺寸
+     * @param targetSize 目标尺寸
+     * @return 1、2、4或8
+     */
+    static int chooseScaleDenom(const cv::Size& sourceSize, const cv::Size& targetSize);
+
+private:
+    std::unique_ptr<MjpegDecoderContext> m_context;   ///< libjpeg解码上下文
+};
+
+#endif // MJPEGDECODER_H
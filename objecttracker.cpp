@@ -0,0 +1,152 @@
+/**
+ * @file objecttracker.cpp
+ * @brief 目标跟踪器的实现文件
+ */
+#include "objecttracker.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// 检测结果与预测目标框的最小IoU，低于该值不视为同一目标
+constexpr double kMinIou = 0.3;
+
+// alpha-beta滤波的位置和速度增益
+constexpr double kAlpha = 0.5;
+constexpr double kBeta = 0.2;
+
+// 目标框中心的最大速度（每秒画面宽高的比例），限制误匹配造成的外推
+constexpr double kMaxSpeed = 1.0;
+
+// 没有匹配时保留目标的最多推理次数
+constexpr int kMaxMisses = 3;
+
+/**
+ * @struct Candidate
+ * @brief 一对目标与检测结果的匹配候选
+ */
+struct Candidate
+{
+    double iou;     ///< 交并比
+    int track;      ///< 目标下标
+    int detection;  ///< 检测结果下标
+};
+
+/**
+ * @brief 计算两个矩形的交并比
+ * @param a 矩形
+ * @param b 矩形
+ * @return 交并比
+ */
+double intersectionOverUnion(const QRectF& a, const QRectF& b)
+{
+    const QRectF overlap = a.intersected(b);
+    if (overlap.isEmpty())
+        return 0.0;
+    const double inter = overlap.width() * overlap.height();
+    const double uni = a.width() * a.height() + b.width() * b.height() - inter;
+    return uni > 0.0 ? inter / uni : 0.0;
+}
+
+} // namespace
+
+/**
+ * @brief ObjectTracker类的构造函数
+ */
+ObjectTracker::ObjectTracker()
+    : m_nextId(1)
+{
+}
+
+/**
+ * @brief 清除全部跟踪目标
+ */
+void ObjectTracker::reset()
+{
+    m_tracks.clear();
+}
+
+/**
+ * @brief 用一次推理的检测结果更新跟踪目标
+ * @param detections 检测结果
+ * @param timeUs 采集时刻
+ * @return 当前的全部跟踪目标
+ */
+DetectedObjects ObjectTracker::update(const DetectedObjects& detections, qint64 timeUs)
+{
+    // 预测到本次推理的采集时刻
+    for (Track& track : m_tracks) {
+        const double dt = qMax<qint64>(0, timeUs - track.object.timeUs) / 1000000.0;
+        track.object.box.translate(track.object.velocity * dt);
+    }
+
+    std::vector<Candidate> candidates;
+    for (int t = 0; t < m_tracks.size(); ++t) {
+        for (int d = 0; d < detections.size(); ++d) {
+            if (m_tracks[t].object.objectClass != detections[d].objectClass)
+                continue;
+            const double iou = intersectionOverUnion(m_tracks[t].object.box, detections[d].box);
+            if (iou >= kMinIou) {
+                candidates.push_back({iou, t, d});
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.iou > b.iou; });
+
+    QVector<bool> trackMatched(m_tracks.size(), false);
+    QVector<bool> detectionMatched(detections.size(), false);
+    for (const Candidate& candidate : candidates) {
+        if (trackMatched[candidate.track] || detectionMatched[candidate.detection])
+            continue;
+        trackMatched[candidate.track] = true;
+        detectionMatched[candidate.detection] = true;
+
+        Track& track = m_tracks[candidate.track];
+        DetectedObject& object = track.object;
+        const DetectedObject& measured = detections[candidate.detection];
+        const double dt = qMax<qint64>(1, timeUs - object.timeUs) / 1000000.0;
+
+        const QPointF residual = measured.box.center() - object.box.center();
+        object.velocity += residual * (kBeta / dt);
+        object.velocity.setX(qBound(-kMaxSpeed, object.velocity.x(), kMaxSpeed));
+        object.velocity.setY(qBound(-kMaxSpeed, object.velocity.y(), kMaxSpeed));
+
+        const QPointF center = object.box.center() + residual * kAlpha;
+        const QSizeF size = object.box.size() + (measured.box.size() - object.box.size()) * kAlpha;
+        object.box = QRectF(QPointF(), size);
+        object.box.moveCenter(center);
+        object.confidence = measured.confidence;
+        track.misses = 0;
+    }
+
+    // 没有匹配的目标沿预测位置保留，逐渐减速
+    for (int t = m_tracks.size() - 1; t >= 0; --t) {
+        if (trackMatched[t])
+            continue;
+        if (++m_tracks[t].misses > kMaxMisses) {
+            m_tracks.remove(t);
+        } else {
+            m_tracks[t].object.velocity *= 0.5;
+        }
+    }
+
+    for (int d = 0; d < detections.size(); ++d) {
+        if (detectionMatched[d])
+            continue;
+        Track track;
+        track.object = detections[d];
+        track.object.trackId = m_nextId++;
+        track.object.velocity = QPointF();
+        m_tracks.append(track);
+    }
+
+    DetectedObjects objects;
+    objects.reserve(m_tracks.size());
+    for (Track& track : m_tracks) {
+        track.object.timeUs = timeUs;
+        objects.append(track.object);
+    }
+    return objects;
+}
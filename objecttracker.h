@@ -0,0 +1,66 @@
+/**
+ * @file objecttracker.h
+ * @brief 目标跟踪器的头文件
+ *
+ * 该文件定义了ObjectTracker类，在两次推理之间把检测结果关联为跟踪目标并估计其运动，
+ * 使显示端可以按速度外推目标框，推理频率低于显示帧率时目标框也能平滑移动。
+ */
+#ifndef OBJECTTRACKER_H
+#define OBJECTTRACKER_H
+
+#include "detectedobject.h"
+
+/**
+ * @class ObjectTracker
+ * @brief 单个摄像头的轻量目标跟踪器
+ *
+ * 只使用目标框做关联，不访问图像：
+ * 1. 把已有目标按速度预测到本次推理的采集时刻
+ * 2. 同类别的目标与检测结果按IoU从大到小贪心匹配
+ * 3. 匹配上的目标用alpha-beta滤波更新位置和速度，尺寸按比例平滑
+ * 4. 没有匹配的目标沿预测位置保留几次推理，没有匹配的检测结果成为新目标
+ * 每次更新的开销与目标数的平方成正比，一帧几十个目标时可以忽略
+ */
+class ObjectTracker
+{
+public:
+    /**
+     * @brief 构造函数
+     */
+    ObjectTracker();
+
+    /**
+     * @brief 用一次推理的检测结果更新跟踪目标
+     * @param detections 检测结果，trackId和velocity被忽略
+     * @param timeUs 推理所用帧的采集时刻（单调时钟，微秒）
+     * @return 当前的全部跟踪目标，位置对应timeUs
+     */
+    DetectedObjects update(const DetectedObjects& detections, qint64 timeUs);
+
+    /**
+     * @brief 清除全部跟踪目标
+     */
+    void reset();
+
+    /**
+     * @brief 获取当前跟踪目标的数量
+     * @return 目标数量
+     */
+    int trackCount() const { return m_tracks.size(); }
+
+private:
+    /**
+     * @struct Track
+     * @brief 一个跟踪目标
+     */
+    struct Track
+    {
+        DetectedObject object;  ///< 目标状态
+        int misses = 0;         ///< 连续没有匹配的推理次数
+    };
+
+    QVector<Track> m_tracks;    ///< 跟踪目标
+    int m_nextId;               ///< 下一个跟踪编号
+};
+
+#endif // OBJECTTRACKER_H
@@ -0,0 +1,76 @@
+/**
+ * @file opencvframesource.cpp
+ * @brief 基于cv::VideoCapture的帧源的实现文件
+ */
+#include "opencvframesource.h"
+
+#include <iostream>
+
+/**
+ * @brief OpenCvFrameSource类的构造函数
+ * @param location 设备路径
+ * @param config 采集参数
+ */
+OpenCvFrameSource::OpenCvFrameSource(const QString& location, const FrameSourceConfig& config)
+    : m_location(location)
+    , m_config(config)
+{
+}
+
+/**
+ * @brief 打开摄像头并设置采集参数
+ * @return 是否打开成功
+ */
+bool OpenCvFrameSource::open()
+{
+#ifdef __linux__
+    const int apiPreference = cv::CAP_V4L2;
+#else
+    const int apiPreference = cv::CAP_ANY;
+#endif
+    if (!m_capture.open(m_location.toStdString(), apiPreference))
+        return false;
+
+    m_capture.set(cv::CAP_PROP_FRAME_WIDTH, m_config.width);
+    m_capture.set(cv::CAP_PROP_FRAME_HEIGHT, m_config.height);
+    // 禁用不必要的功能，减少警告
+    m_capture.set(cv::CAP_PROP_BUFFERSIZE, 1);
+    // 设置更多属性以解决内存分配问题
+    m_capture.set(cv::CAP_PROP_FOURCC, static_cast<double>(m_config.pixelFormat));
+    return true;
+}
+
+/**
+ * @brief 释放摄像头
+ */
+void OpenCvFrameSource::close()
+{
+    if (m_capture.isOpened()) {
+        m_capture.release();
+    }
+}
+
+/**
+ * @brief 读取一帧
+ * @param frame 输出帧
+ * @param timeoutMs 未使用，OpenCV的读取超时由后端决定
+ * @return 取帧结果
+ */
+FrameSource::GrabResult OpenCvFrameSource::grab(CameraFrame& frame, int timeoutMs)
+{
+    Q_UNUSED(timeoutMs);
+
+    bool success = false;
+    try {
+        success = m_capture.read(frame.image);
+    } catch (const cv::Exception& e) {
+        std::cerr << m_location.toStdString() << " 读取异常: " << e.what() << std::endl;
+    }
+
+    if (!success || frame.image.empty())
+        return GrabResult::Error;
+
+    frame.releaseRaw();
+    frame.deviceTimestampUs = 0;
+    return GrabResult::Frame;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file opencvframesource.h
+ * @brief 基于cv::VideoCapture的帧源的头文件
+ */
+#ifndef OPENCVFRAMESOURCE_H
+#define OPENCVFRAMESOURCE_H
+
+#include <opencv2/videoio.hpp>
+
+#include "framesource.h"
+
+/**
+ * @class OpenCvFrameSource
+ * @brief 基于cv::VideoCapture的帧源
+ *
+ * 用于原生V4L2实现不可用的平台，帧由OpenCV内部解码并拷贝到CameraFrame::image
+ */
+class OpenCvFrameSource : public FrameSource
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param location 设备路径
+     * @param config 采集参数
+     */
+    OpenCvFrameSource(const QString& location, const FrameSourceConfig& config);
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_capture.isOpened(); }
+    GrabResult grab(CameraFrame& frame, int timeoutMs) override;
+    QString location() const override { return m_location; }
+
+private:
+    QString m_location;             ///< 设备路径
+    FrameSourceConfig m_config;     ///< 采集参数
+    cv::VideoCapture m_capture;     ///< OpenCV摄像头
+};
+
+#endif // OPENCVFRAMESOURCE_H
@@ -0,0 +1,304 @@
+/**
+ * @file overlaylayer.cpp
+ * @brief 画面块矢量叠加层的实现文件
+ */
+#include "overlaylayer.h"
+
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPen>
+
+namespace {
+
+// 需要重绘的区域由过多小矩形组成时合并为外接矩形，裁剪的开销超过多绘制的像素
+constexpr int kMaxDirtyRects = 16;
+
+// 标签文字与底色边缘的间距
+constexpr int kLabelPaddingX = 8;
+constexpr int kLabelPaddingY = 2;
+
+/**
+ * @brief 把相对画面的坐标换算为合成器坐标
+ * @param point 相对坐标
+ * @param geometry 画面块的位置
+ * @return 合成器的逻辑坐标
+ */
+QPointF mapPoint(const QPointF& point, const QRect& geometry)
+{
+    return QPointF(geometry.x() + point.x() * geometry.width(), geometry.y() + point.y() * geometry.height());
+}
+
+/**
+ * @brief 把相对画面的矩形换算为合成器坐标
+ * @param rect 相对矩形
+ * @param geometry 画面块的位置
+ * @return 合成器的逻辑坐标
+ */
+QRectF mapRect(const QRectF& rect, const QRect& geometry)
+{
+    return QRectF(mapPoint(rect.topLeft(), geometry),
+                  QSizeF(rect.width() * geometry.width(), rect.height() * geometry.height()));
+}
+
+/**
+ * @brief 把相对画面的顶点换算为合成器坐标
+ * @param points 相对坐标
+ * @param offset 外推的位移（相对坐标）
+ * @param geometry 画面块的位置
+ * @return 合成器的逻辑坐标
+ */
+QPolygonF mapPolygon(const QPolygonF& points, const QPointF& offset, const QRect& geometry)
+{
+    QPolygonF mapped;
+    mapped.reserve(points.size());
+    for (const QPointF& point : points) {
+        mapped.append(mapPoint(point + offset, geometry));
+    }
+    return mapped;
+}
+
+/**
+ * @brief 计算标签的位置
+ * @param text 标签文字
+ * @param anchor 锚点矩形（合成器坐标）
+ * @param aboveAnchor 是否画在锚点矩形上方，贴近画面块顶部时改为画在矩形内
+ * @param geometry 画面块的位置
+ * @param metrics 字体度量
+ * @return 标签底色的矩形
+ */
+QRectF labelRect(const QString& text, const QRectF& anchor, bool aboveAnchor, const QRect& geometry,
+                 const QFontMetrics& metrics)
+{
+    QRectF rect(anchor.topLeft(), QSizeF(metrics.boundingRect(text).width() + kLabelPaddingX,
+                                         metrics.height() + kLabelPaddingY));
+    if (aboveAnchor) {
+        rect.moveBottom(anchor.top());
+        if (rect.top() < geometry.top()) {
+            rect.moveTop(anchor.top());
+        }
+    }
+    return rect;
+}
+
+/**
+ * @brief 绘制标签
+ * @param painter 绘制器
+ * @param rect 标签底色的矩形
+ * @param item 图元
+ */
+void drawLabel(QPainter& painter, const QRectF& rect, const OverlayItem& item)
+{
+    painter.fillRect(rect, item.color.isValid() ? item.color : QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    painter.drawText(rect, Qt::AlignCenter, item.text);
+}
+
+} // namespace
+
+/**
+ * @brief OverlayChannel类的构造函数
+ * @param layer 所属的叠加层
+ */
+OverlayChannel::OverlayChannel(OverlayLayer *layer)
+    : m_layer(layer)
+    , m_publishedEmpty(true)
+{
+}
+
+/**
+ * @brief 发布新的场景
+ * @param scene 场景
+ *
+ * 前后都没有图元时不打扰界面线程
+ */
+void OverlayChannel::publish(const OverlayScene& scene)
+{
+    if (scene.isEmpty() && m_publishedEmpty)
+        return;
+    m_publishedEmpty = scene.isEmpty();
+    m_scenes.writeSlot() = scene;
+    m_scenes.publish();
+    m_layer->notify();
+}
+
+/**
+ * @brief OverlayLayer类的构造函数
+ * @param parent 父对象指针
+ */
+OverlayLayer::OverlayLayer(QObject *parent)
+    : QObject(parent)
+    , m_notifyPending(false)
+{
+}
+
+/**
+ * @brief OverlayLayer类的析构函数
+ *
+ * 各通道的生产者须在此之前停止
+ */
+OverlayLayer::~OverlayLayer() = default;
+
+/**
+ * @brief 添加一个分析来源的发布通道
+ * @return 发布通道
+ */
+OverlayChannel* OverlayLayer::addChannel()
+{
+    m_channels.emplace_back(new OverlayChannel(this));
+    return m_channels.back().get();
+}
+
+/**
+ * @brief 通道发布后调用
+ *
+ * 界面线程取走之前只发出一次changed()，期间的发布在takeChanges()中一并取走
+ */
+void OverlayLayer::notify()
+{
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        emit changed();
+    }
+}
+
+/**
+ * @brief 取走各通道新发布的场景
+ * @param geometry 画面块的位置
+ * @param frameTimeUs 当前画面的采集时刻
+ * @return 需要重绘的区域
+ *
+ * 先清除标志再取场景，取走之后发布的场景一定会再次通知。
+ * 重绘区域是有变化的通道上一次绘制的范围与新场景范围的并集，旧图元被视频覆盖，新图元画在上方
+ */
+QRegion OverlayLayer::takeChanges(const QRect& geometry, qint64 frameTimeUs)
+{
+    m_notifyPending.store(false, std::memory_order_release);
+
+    const QFontMetrics metrics(m_font);
+    QRegion dirty;
+    for (const std::unique_ptr<OverlayChannel>& channel : m_channels) {
+        if (!channel->m_scenes.fetch())
+            continue;
+        dirty += channel->m_painted;
+        for (const OverlayItem& item : channel->m_scenes.readSlot().items) {
+            dirty += itemBounds(item, geometry, frameTimeUs, metrics);
+        }
+    }
+
+    dirty &= geometry;
+    if (dirty.rectCount() > kMaxDirtyRects) {
+        dirty = dirty.boundingRect();
+    }
+    return dirty;
+}
+
+/**
+ * @brief 绘制全部图元
+ * @param painter 绘制器
+ * @param geometry 画面块的位置
+ * @param frameTimeUs 当前画面的采集时刻
+ * @param region 需要重绘的区域
+ *
+ * 与region不相交的图元跳过绘制，但仍记录其范围，下次变化时用于计算重绘区域
+ */
+void OverlayLayer::paint(QPainter& painter, const QRect& geometry, qint64 frameTimeUs, const QRegion& region)
+{
+    m_font = painter.font();
+    const QFontMetrics metrics = painter.fontMetrics();
+
+    painter.save();
+    for (const std::unique_ptr<OverlayChannel>& channel : m_channels) {
+        channel->m_painted = QRegion();
+        for (const OverlayItem& item : channel->m_scenes.readSlot().items) {
+            const QRect bounds = itemBounds(item, geometry, frameTimeUs, metrics);
+            channel->m_painted += bounds;
+            if (region.isEmpty() || region.intersects(bounds)) {
+                drawItem(painter, item, geometry, frameTimeUs);
+            }
+        }
+    }
+    painter.restore();
+}
+
+/**
+ * @brief 计算图元在画面块中覆盖的范围
+ * @param item 图元
+ * @param geometry 画面块的位置
+ * @param frameTimeUs 当前画面的采集时刻
+ * @param metrics 标签字体的度量
+ * @return 范围
+ */
+QRect OverlayLayer::itemBounds(const OverlayItem& item, const QRect& geometry, qint64 frameTimeUs,
+                               const QFontMetrics& metrics)
+{
+    const QPointF offset = item.offsetAt(frameTimeUs);
+    // 半个线宽加抗锯齿的一个像素
+    const qreal margin = item.width / 2.0 + 1.0;
+
+    QRectF bounds;
+    switch (item.shape) {
+    case OverlayItem::Shape::Box: {
+        const QRectF rect = mapRect(item.rect.translated(offset), geometry);
+        bounds = rect.adjusted(-margin, -margin, margin, margin);
+        if (!item.text.isEmpty()) {
+            bounds |= labelRect(item.text, rect, true, geometry, metrics);
+        }
+        break;
+    }
+    case OverlayItem::Shape::Polyline:
+    case OverlayItem::Shape::Polygon:
+        bounds = mapPolygon(item.points, offset, geometry).boundingRect().adjusted(-margin, -margin, margin, margin);
+        break;
+    case OverlayItem::Shape::Label:
+        bounds = labelRect(item.text, mapRect(item.rect.translated(offset), geometry), false, geometry, metrics);
+        break;
+    }
+    return bounds.toAlignedRect();
+}
+
+/**
+ * @brief 绘制一个图元
+ * @param painter 绘制器
+ * @param item 图元
+ * @param geometry 画面块的位置
+ * @param frameTimeUs 当前画面的采集时刻
+ *
+ * 只有斜线和多边形开启抗锯齿，水平竖直的框保持锐利
+ */
+void OverlayLayer::drawItem(QPainter& painter, const OverlayItem& item, const QRect& geometry, qint64 frameTimeUs)
+{
+    const QPointF offset = item.offsetAt(frameTimeUs);
+    const QPen pen = item.color.isValid() && item.width > 0.0
+                         ? QPen(item.color, item.width, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin)
+                         : QPen(Qt::NoPen);
+
+    switch (item.shape) {
+    case OverlayItem::Shape::Box: {
+        const QRectF rect = mapRect(item.rect.translated(offset), geometry);
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        painter.setPen(pen);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(rect);
+        if (!item.text.isEmpty()) {
+            drawLabel(painter, labelRect(item.text, rect, true, geometry, painter.fontMetrics()), item);
+        }
+        break;
+    }
+    case OverlayItem::Shape::Polyline:
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(pen);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolyline(mapPolygon(item.points, offset, geometry));
+        break;
+    case OverlayItem::Shape::Polygon:
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(pen);
+        painter.setBrush(item.fill.isValid() ? QBrush(item.fill) : QBrush(Qt::NoBrush));
+        painter.drawPolygon(mapPolygon(item.points, offset, geometry));
+        break;
+    case OverlayItem::Shape::Label:
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        drawLabel(painter, labelRect(item.text, mapRect(item.rect.translated(offset), geometry), false,
+                                     geometry, painter.fontMetrics()), item);
+        break;
+    }
+}
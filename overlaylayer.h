@@ -0,0 +1,222 @@
+/**
+ * @file overlaylayer.h
+ * @brief 画面块矢量叠加层的头文件
+ *
+ * 该文件定义了OverlayItem、OverlayScene、OverlayChannel和OverlayLayer。分析线程把结果
+ * 以矢量图元（框、折线、多边形、标签）发布到画面块的叠加层，合成时才画到视频上方，
+ * 不写入画面像素，原始帧可以直接用于录像。
+ */
+#ifndef OVERLAYLAYER_H
+#define OVERLAYLAYER_H
+
+#include <QColor>
+#include <QFont>
+#include <QObject>
+#include <QPointF>
+#include <QPolygonF>
+#include <QRectF>
+#include <QRegion>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "framemailbox.h"
+
+class QFontMetrics;
+class QPainter;
+class OverlayLayer;
+
+/**
+ * @struct OverlayItem
+ * @brief 一个叠加图元
+ *
+ * 坐标为相对画面宽高的比例（0~1），与画面块的显示尺寸无关；线宽为逻辑像素。
+ * 有速度的图元在绘制时按速度外推到当前画面的采集时刻，分析频率低于帧率时随画面平滑移动
+ */
+struct OverlayItem
+{
+    /**
+     * @brief 图元形状
+     */
+    enum class Shape {
+        Box,        ///< 矩形框，text非空时在框上方加标签
+        Polyline,   ///< 折线
+        Polygon,    ///< 多边形，fill有效时填充
+        Label       ///< 文字标签，左上角位于rect.topLeft()
+    };
+
+    Shape shape = Shape::Box;           ///< 形状
+    QRectF rect;                        ///< 矩形框或标签锚点
+    QPolygonF points;                   ///< 折线或多边形的顶点
+    QString text;                       ///< 标签文字
+    QColor color;                       ///< 线条颜色和标签底色，无效时不描边
+    QColor fill;                        ///< 多边形填充颜色，无效时不填充
+    qreal width = 2.0;                  ///< 线宽（逻辑像素）
+    QPointF velocity;                   ///< 每秒移动的比例
+    qint64 timeUs = 0;                  ///< 坐标对应的采集时刻（单调时钟，微秒）
+
+    static constexpr qint64 kMaxExtrapolationUs = 500000;  ///< 最长外推时间
+
+    /**
+     * @brief 外推到指定时刻的位移
+     * @param atUs 采集时刻（单调时钟，微秒）
+     * @return 位移，外推时间不超过kMaxExtrapolationUs，早于timeUs时不外推
+     */
+    QPointF offsetAt(qint64 atUs) const
+    {
+        if (velocity.isNull())
+            return QPointF();
+        const qint64 dtUs = qBound<qint64>(0, atUs - timeUs, kMaxExtrapolationUs);
+        return velocity * (dtUs / 1000000.0);
+    }
+};
+
+/**
+ * @struct OverlayScene
+ * @brief 一个分析来源的全部叠加图元，每次发布整体替换
+ */
+struct OverlayScene
+{
+    QVector<OverlayItem> items;         ///< 图元，按顺序绘制
+    qint64 timeUs = 0;                  ///< 对应帧的采集时刻（单调时钟，微秒）
+
+    /**
+     * @brief 是否没有图元
+     * @return 是否为空
+     */
+    bool isEmpty() const { return items.isEmpty(); }
+};
+
+/**
+ * @class OverlayChannel
+ * @brief 叠加层中一个分析来源的发布通道
+ *
+ * 每个通道只能有一个生产者线程，通过无锁信箱发布，只保留最新的场景。
+ * 由OverlayLayer拥有，生命周期与画面块相同
+ */
+class OverlayChannel
+{
+public:
+    OverlayChannel(const OverlayChannel&) = delete;
+    OverlayChannel& operator=(const OverlayChannel&) = delete;
+
+    /**
+     * @brief 发布新的场景（仅该通道的生产者线程调用）
+     * @param scene 场景，前后都为空时不发布
+     */
+    void publish(const OverlayScene& scene);
+
+    /**
+     * @brief 清除该通道的图元（仅该通道的生产者线程调用）
+     */
+    void clear() { publish(OverlayScene()); }
+
+private:
+    friend class OverlayLayer;
+
+    /**
+     * @brief 构造函数
+     * @param layer 所属的叠加层
+     */
+    explicit OverlayChannel(OverlayLayer *layer);
+
+    OverlayLayer *m_layer;                  ///< 所属的叠加层
+    FrameMailbox<OverlayScene> m_scenes;    ///< 最新场景信箱
+    bool m_publishedEmpty;                  ///< 上一次发布的场景是否为空（仅生产者访问）
+    QRegion m_painted;                      ///< 上一次绘制时图元覆盖的区域（仅界面线程访问）
+};
+
+/**
+ * @class OverlayLayer
+ * @brief 画面块的矢量叠加层
+ *
+ * 保存各分析来源最新的图元，合成时由画面块画在视频上方。分析线程按自己的频率发布，
+ * 与视频帧率无关；第一份未处理的发布发出changed()，界面线程取走之前不重复通知。
+ * 只有叠加层变化时，takeChanges()给出新旧图元覆盖区域的并集，画面块只重绘这部分，
+ * 不必重新绘制整个画面块。通道按添加顺序绘制，后添加的在上方
+ */
+class OverlayLayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit OverlayLayer(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~OverlayLayer() override;
+
+    /**
+     * @brief 添加一个分析来源的发布通道（仅界面线程在生产者启动前调用）
+     * @return 发布通道，由叠加层拥有
+     */
+    OverlayChannel* addChannel();
+
+    /**
+     * @brief 取走各通道新发布的场景（仅界面线程调用）
+     * @param geometry 画面块的位置（合成器的逻辑坐标）
+     * @param frameTimeUs 当前画面的采集时刻，用于外推
+     * @return 需要重绘的区域，已限制在geometry内
+     *
+     * 调用后再发布的场景会重新触发changed()
+     */
+    QRegion takeChanges(const QRect& geometry, qint64 frameTimeUs);
+
+    /**
+     * @brief 绘制全部图元（仅界面线程调用）
+     * @param painter 绘制器，调用方负责裁剪
+     * @param geometry 画面块的位置（合成器的逻辑坐标）
+     * @param frameTimeUs 当前画面的采集时刻，用于外推
+     * @param region 需要重绘的区域，为空时绘制全部图元
+     */
+    void paint(QPainter& painter, const QRect& geometry, qint64 frameTimeUs,
+               const QRegion& region = QRegion());
+
+signals:
+    /**
+     * @brief 有通道发布了新的场景，可能由任意线程发出
+     */
+    void changed();
+
+private:
+    friend class OverlayChannel;
+
+    /**
+     * @brief 通道发布后调用，合并通知
+     */
+    void notify();
+
+    /**
+     * @brief 计算图元在画面块中覆盖的范围
+     * @param item 图元
+     * @param geometry 画面块的位置
+     * @param frameTimeUs 当前画面的采集时刻
+     * @param metrics 标签字体的度量
+     * @return 范围（合成器的逻辑坐标），含线宽和抗锯齿的边缘
+     */
+    static QRect itemBounds(const OverlayItem& item, const QRect& geometry, qint64 frameTimeUs,
+                            const QFontMetrics& metrics);
+
+    /**
+     * @brief 绘制一个图元
+     * @param painter 绘制器
+     * @param item 图元
+     * @param geometry 画面块的位置
+     * @param frameTimeUs 当前画面的采集时刻
+     */
+    static void drawItem(QPainter& painter, const OverlayItem& item, const QRect& geometry, qint64 frameTimeUs);
+
+    std::vector<std::unique_ptr<OverlayChannel>> m_channels;   ///< 发布通道
+    std::atomic<bool> m_notifyPending;                         ///< 是否已发出changed()且界面线程尚未取走
+    QFont m_font;                                               ///< 最近一次绘制使用的字体，用于估算标签范围
+};
+
+#endif // OVERLAYLAYER_H
@@ -0,0 +1,150 @@
+/**
+ * @file perclosestimator.cpp
+ * @brief PERCLOS疲劳度估计的实现文件
+ */
+#include "perclosestimator.h"
+
+#include <QtMath>
+
+namespace {
+
+// PERCLOS与疲劳度的对应点，点之间线性插值
+constexpr double kPerclosPoints[] = {0.0, 0.075, 0.15, 0.30};
+constexpr double kLevelPoints[] = {0.0, 50.0, 70.0, 100.0};
+constexpr int kPointCount = sizeof(kPerclosPoints) / sizeof(kPerclosPoints[0]);
+
+// 持续闭眼超过该时长视为微睡眠
+constexpr double kMicrosleepMs = 1500.0;
+constexpr int kMicrosleepLevel = 75;
+
+} // namespace
+
+/**
+ * @brief PerclosEstimator类的构造函数
+ * @param windowUs 滑动窗口长度（微秒）
+ */
+PerclosEstimator::PerclosEstimator(qint64 windowUs)
+    : m_windowUs(qMax<qint64>(kMinObservedUs, windowUs))
+    , m_observedUs(0)
+    , m_closedUs(0)
+    , m_lastUs(0)
+    , m_lastFace(false)
+    , m_lastClosed(false)
+    , m_closedSinceUs(0)
+{
+}
+
+/**
+ * @brief 加入一帧的观测结果
+ * @param timeUs 采集时刻
+ * @param faceVisible 是否检测到人脸
+ * @param eyesClosed 是否闭眼
+ */
+void PerclosEstimator::addSample(qint64 timeUs, bool faceVisible, bool eyesClosed)
+{
+    // 上一个样本的状态持续到本样本
+    if (m_lastUs > 0 && m_lastFace && timeUs > m_lastUs) {
+        const qint64 durationUs = qMin(timeUs - m_lastUs, kMaxSampleGapUs);
+        m_intervals.push_back({timeUs, durationUs, m_lastClosed});
+        m_observedUs += durationUs;
+        if (m_lastClosed) {
+            m_closedUs += durationUs;
+        }
+    }
+
+    const bool closed = faceVisible && eyesClosed;
+    if (closed && m_closedSinceUs == 0) {
+        m_closedSinceUs = timeUs;
+    } else if (!closed && m_closedSinceUs > 0) {
+        // 看不到人脸时中断的闭眼不计为眨眼
+        const qint64 closureUs = timeUs - m_closedSinceUs;
+        if (faceVisible && closureUs >= kMinBlinkUs && closureUs <= kMaxBlinkUs) {
+            m_blinks.push_back(timeUs);
+        }
+        m_closedSinceUs = 0;
+    }
+
+    m_lastUs = timeUs;
+    m_lastFace = faceVisible;
+    m_lastClosed = closed;
+    evict(timeUs);
+}
+
+/**
+ * @brief 移除窗口之外的观测和眨眼
+ * @param nowUs 当前时刻
+ */
+void PerclosEstimator::evict(qint64 nowUs)
+{
+    const qint64 startUs = nowUs - m_windowUs;
+    while (!m_intervals.empty() && m_intervals.front().endUs <= startUs) {
+        const Interval& interval = m_intervals.front();
+        m_observedUs -= interval.durationUs;
+        if (interval.closed) {
+            m_closedUs -= interval.durationUs;
+        }
+        m_intervals.pop_front();
+    }
+    while (!m_blinks.empty() && m_blinks.front() <= startUs) {
+        m_blinks.pop_front();
+    }
+}
+
+/**
+ * @brief 获取当前估计结果
+ * @return 估计结果
+ */
+DriverEstimate PerclosEstimator::estimate() const
+{
+    DriverEstimate estimate;
+    estimate.faceVisible = m_lastFace;
+    estimate.valid = m_observedUs >= kMinObservedUs;
+    if (m_observedUs > 0) {
+        estimate.perclos = static_cast<double>(m_closedUs) / m_observedUs;
+        estimate.blinksPerMinute = m_blinks.size() * 60000000.0 / m_observedUs;
+    }
+    if (m_closedSinceUs > 0) {
+        estimate.closureMs = (m_lastUs - m_closedSinceUs) / 1000.0;
+    }
+    estimate.fatigueLevel = fatigueLevelFor(estimate.perclos, estimate.closureMs);
+    return estimate;
+}
+
+/**
+ * @brief 清空窗口
+ */
+void PerclosEstimator::reset()
+{
+    m_intervals.clear();
+    m_blinks.clear();
+    m_observedUs = 0;
+    m_closedUs = 0;
+    m_lastUs = 0;
+    m_lastFace = false;
+    m_lastClosed = false;
+    m_closedSinceUs = 0;
+}
+
+/**
+ * @brief 把PERCLOS和持续闭眼时长换算为疲劳度
+ * @param perclos 闭眼时间占比
+ * @param closureMs 当前持续闭眼的时长
+ * @return 疲劳度
+ */
+int PerclosEstimator::fatigueLevelFor(double perclos, double closureMs)
+{
+    double level = kLevelPoints[kPointCount - 1];
+    for (int i = 1; i < kPointCount; ++i) {
+        if (perclos < kPerclosPoints[i]) {
+            const double t = (perclos - kPerclosPoints[i - 1]) / (kPerclosPoints[i] - kPerclosPoints[i - 1]);
+            level = kLevelPoints[i - 1] + t * (kLevelPoints[i] - kLevelPoints[i - 1]);
+            break;
+        }
+    }
+
+    int result = qBound(0, qRound(level), 100);
+    if (closureMs >= kMicrosleepMs) {
+        result = qMax(result, kMicrosleepLevel);
+    }
+    return result;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file perclosestimator.h
+ * @brief PERCLOS疲劳度估计的头文件
+ *
+ * 该文件定义了PerclosEstimator类，根据逐帧的眼睛睁闭状态计算滑动窗口内的
+ * PERCLOS（闭眼时间占比）和眨眼频率，并换算为状态面板使用的0~100疲劳度。
+ */
+#ifndef PERCLOSESTIMATOR_H
+#define PERCLOSESTIMATOR_H
+
+#include <QMetaType>
+#include <QtGlobal>
+
+#include <deque>
+
+/**
+ * @struct DriverEstimate
+ * @brief 驾驶员疲劳状态估计结果
+ */
+struct DriverEstimate
+{
+    bool valid = false;             ///< 观测时间是否足够，不足时其余字段仅供参考
+    bool faceVisible = false;       ///< 最近一帧是否检测到人脸
+    double perclos = 0.0;           ///< 窗口内闭眼时间占比（0~1）
+    double blinksPerMinute = 0.0;   ///< 窗口内每分钟眨眼次数
+    double closureMs = 0.0;         ///< 当前持续闭眼的时长，睁眼时为0
+    int fatigueLevel = 0;           ///< 疲劳度（0~100）
+};
+
+Q_DECLARE_METATYPE(DriverEstimate)
+
+/**
+ * @class PerclosEstimator
+ * @brief PERCLOS和眨眼频率的滑动窗口估计
+ *
+ * 只累计检测到人脸的时间，驾驶员转头或离开画面时窗口暂停而不是按睁眼计算。
+ * 每个样本的状态持续到下一个样本，单个间隔最多按kMaxSampleGapUs计，丢帧不会放大某一帧的权重。
+ * 50~500毫秒的闭眼计为一次眨眼，更长的闭眼只计入PERCLOS，并在持续时直接提高疲劳度
+ */
+class PerclosEstimator
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param windowUs 滑动窗口长度（微秒），默认60秒
+     */
+    explicit PerclosEstimator(qint64 windowUs = 60000000);
+
+    /**
+     * @brief 加入一帧的观测结果
+     * @param timeUs 采集时刻（单调时钟，微秒），须单调不减
+     * @param faceVisible 是否检测到人脸
+     * @param eyesClosed 是否闭眼，未检测到人脸时忽略
+     */
+    void addSample(qint64 timeUs, bool faceVisible, bool eyesClosed);
+
+    /**
+     * @brief 获取当前估计结果
+     * @return 估计结果
+     */
+    DriverEstimate estimate() const;
+
+    /**
+     * @brief 清空窗口
+     */
+    void reset();
+
+    /**
+     * @brief 把PERCLOS和持续闭眼时长换算为疲劳度
+     * @param perclos 闭眼时间占比（0~1）
+     * @param closureMs 当前持续闭眼的时长
+     * @return 疲劳度（0~100）
+     *
+     * PERCLOS 7.5%对应轻度疲劳阈值50，15%对应疲劳阈值70，30%及以上为100；
+     * 持续闭眼超过1.5秒视为微睡眠，疲劳度至少为75
+     */
+    static int fatigueLevelFor(double perclos, double closureMs);
+
+    static constexpr qint64 kMaxSampleGapUs = 200000;       ///< 单个样本最多代表的时长
+    static constexpr qint64 kMinObservedUs = 10000000;      ///< 给出有效估计所需的最短观测时间
+    static constexpr qint64 kMinBlinkUs = 50000;            ///< 眨眼的最短闭眼时长
+    static constexpr qint64 kMaxBlinkUs = 500000;           ///< 眨眼的最长闭眼时长
+
+private:
+    /**
+     * @struct Interval
+     * @brief 一段观测时间
+     */
+    struct Interval
+    {
+        qint64 endUs;       ///< 结束时刻
+        qint64 durationUs;  ///< 时长
+        bool closed;        ///< 是否闭眼
+    };
+
+    /**
+     * @brief 移除窗口之外的观测和眨眼
+     * @param nowUs 当前时刻
+     */
+    void evict(qint64 nowUs);
+
+    qint64 m_windowUs;              ///< 窗口长度
+    std::deque<Interval> m_intervals; ///< 窗口内的观测时间段
+    std::deque<qint64> m_blinks;    ///< 窗口内各次眨眼的结束时刻
+    qint64 m_observedUs;            ///< 窗口内观测时间总和
+    qint64 m_closedUs;              ///< 窗口内闭眼时间总和
+    qint64 m_lastUs;                ///< 上一个样本的时刻，0表示没有
+    bool m_lastFace;                ///< 上一个样本是否检测到人脸
+    bool m_lastClosed;              ///< 上一个样本是否闭眼
+    qint64 m_closedSinceUs;         ///< 本次闭眼开始的时刻，0表示睁眼
+};
+
+#endif // PERCLOSESTIMATOR_H
@@ -0,0 +1,204 @@
+/**
+ * @file perfreport.cpp
+ * @brief 无界面运行性能报告的实现文件
+ */
+#include "perfreport.h"
+#include "framecopycounter.h"
+#include "frametiming.h"
+#include "stageprofiler.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonObject>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <fstream>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief PerfReport类的构造函数
+ */
+PerfReport::PerfReport()
+    : m_startUs(monotonicNowUs())
+    , m_startCpuUs(processCpuTimeUs())
+    , m_startRssKb(currentRssKb())
+{
+}
+
+/**
+ * @brief 添加一个摄像头的统计
+ * @param name 摄像头名称
+ * @param capturedFrames 采集到的帧数
+ * @param stats 显示端的延迟统计
+ */
+void PerfReport::addCamera(const QString& name, quint64 capturedFrames, const LatencyStats::Summary& stats)
+{
+    const double seconds = qMax(0.001, elapsedSeconds());
+
+    QJsonObject camera;
+    camera["name"] = name;
+    camera["captured_frames"] = static_cast<double>(capturedFrames);
+    camera["displayed_frames"] = static_cast<double>(stats.frames);
+    camera["dropped_frames"] = static_cast<double>(stats.dropped);
+    camera["captured_fps"] = capturedFrames / seconds;
+    camera["displayed_fps"] = stats.frames / seconds;
+    camera["latency_p50_ms"] = stats.p50Ms;
+    camera["latency_p99_ms"] = stats.p99Ms;
+    camera["latency_worst_ms"] = stats.worstMs;
+    camera["present_interval_ms"] = stats.intervalMs;
+    camera["present_jitter_ms"] = stats.jitterMs;
+    m_cameras.append(camera);
+}
+
+/**
+ * @brief 设置车辆检测的推理统计
+ * @param inferences 推理次数
+ * @param images 推理过的画面数
+ * @param objects 检测到的目标数
+ * @param cpuUs 推理消耗的CPU时间
+ *
+ * 每核每秒的画面数和目标数可以直接用于估算一定路数摄像头所需的核数
+ */
+void PerfReport::setDetection(quint64 inferences, quint64 images, quint64 objects, qint64 cpuUs)
+{
+    const double seconds = qMax(0.001, elapsedSeconds());
+    const double cpuSeconds = cpuUs / 1000000.0;
+
+    m_detection = QJsonObject();
+    m_detection["inferences"] = static_cast<double>(inferences);
+    m_detection["images"] = static_cast<double>(images);
+    m_detection["objects"] = static_cast<double>(objects);
+    m_detection["mean_batch"] = inferences > 0 ? double(images) / inferences : 0.0;
+    m_detection["images_per_s"] = images / seconds;
+    m_detection["cpu_ms_per_s"] = cpuUs / 1000.0 / seconds;
+    m_detection["images_per_core_s"] = cpuSeconds > 0.0 ? images / cpuSeconds : 0.0;
+    m_detection["objects_per_core_s"] = cpuSeconds > 0.0 ? objects / cpuSeconds : 0.0;
+}
+
+/**
+ * @brief 生成JSON报告
+ * @return JSON文档
+ */
+QJsonDocument PerfReport::toJson() const
+{
+    const double seconds = qMax(0.001, elapsedSeconds());
+
+    // 各阶段CPU时间，每秒CPU毫秒数可以直接与核心数比较
+    const StageProfiler::Snapshot profile = StageProfiler::snapshot();
+    QJsonArray stages;
+    for (int i = 0; i < static_cast<int>(StageProfiler::Stage::Count); ++i) {
+        QJsonObject stage;
+        stage["name"] = StageProfiler::stageName(static_cast<StageProfiler::Stage>(i));
+        stage["calls"] = static_cast<double>(profile.calls[i]);
+        stage["cpu_ms"] = profile.cpuUs[i] / 1000.0;
+        stage["cpu_ms_per_s"] = profile.cpuUs[i] / 1000.0 / seconds;
+        stage["cpu_us_per_call"] = profile.calls[i] ? double(profile.cpuUs[i]) / profile.calls[i] : 0.0;
+        stages.append(stage);
+    }
+
+    QJsonObject process;
+    const qint64 cpuUs = processCpuTimeUs();
+    process["cpu_ms"] = cpuUs >= 0 && m_startCpuUs >= 0 ? (cpuUs - m_startCpuUs) / 1000.0 : -1.0;
+    process["peak_rss_kb"] = static_cast<double>(peakRssKb());
+    process["start_rss_kb"] = static_cast<double>(m_startRssKb);
+    process["end_rss_kb"] = static_cast<double>(currentRssKb());
+
+    const FrameCopyCounter::Snapshot copies = FrameCopyCounter::snapshot();
+    QJsonObject copyStats;
+    copyStats["passes_per_frame"] = copies.passesPerFrame();
+    copyStats["allocations_per_frame"] = copies.allocationsPerFrame();
+
+    QJsonObject root;
+    root["report"] = "adas_headless";
+    root["finished_at"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["duration_s"] = seconds;
+    root["cameras"] = m_cameras;
+    root["stages"] = stages;
+    root["process"] = process;
+    root["frame_copies"] = copyStats;
+    if (!m_detection.isEmpty()) {
+        root["detection"] = m_detection;
+    }
+    return QJsonDocument(root);
+}
+
+/**
+ * @brief 写入报告文件
+ * @param path 文件路径
+ * @return 是否写入成功
+ */
+bool PerfReport::write(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(toJson().toJson(QJsonDocument::Indented)) >= 0;
+}
+
+/**
+ * @brief 获取进程的内存占用峰值
+ * @return KB
+ */
+qint64 PerfReport::peakRssKb()
+{
+#ifdef Q_OS_UNIX
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MACOS
+        // macOS下ru_maxrss的单位是字节
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief 获取进程当前的内存占用
+ * @return KB
+ */
+qint64 PerfReport::currentRssKb()
+{
+#ifdef Q_OS_LINUX
+    // statm的第二列为常驻内存页数
+    std::ifstream file("/proc/self/statm");
+    long long totalPages = 0;
+    long long residentPages = 0;
+    if (file >> totalPages >> residentPages) {
+        return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief 获取进程已消耗的CPU时间
+ * @return 微秒
+ */
+qint64 PerfReport::processCpuTimeUs()
+{
+#ifdef Q_OS_UNIX
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return (static_cast<qint64>(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000
+               + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief 距离起始时刻的秒数
+ * @return 秒
+ */
+double PerfReport::elapsedSeconds() const
+{
+    return (monotonicNowUs() - m_startUs) / 1000000.0;
+}
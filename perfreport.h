@@ -0,0 +1,95 @@
+/**
+ * @file perfreport.h
+ * @brief 无界面运行性能报告的头文件
+ *
+ * 该文件定义了PerfReport类，汇总运行期间各摄像头的持续帧率和丢帧数、
+ * 各处理阶段的CPU时间以及进程内存峰值，以JSON格式写入文件。
+ */
+#ifndef PERFREPORT_H
+#define PERFREPORT_H
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include "latencystats.h"
+
+/**
+ * @class PerfReport
+ * @brief 性能报告
+ *
+ * 构造时记录起始时刻、进程CPU时间和内存占用，
+ * 运行结束后逐个添加摄像头统计再写入文件
+ */
+class PerfReport
+{
+public:
+    /**
+     * @brief 构造函数，记录起始状态
+     */
+    PerfReport();
+
+    /**
+     * @brief 添加一个摄像头的统计
+     * @param name 摄像头名称
+     * @param capturedFrames 采集到的帧数
+     * @param stats 显示端的延迟统计
+     */
+    void addCamera(const QString& name, quint64 capturedFrames, const LatencyStats::Summary& stats);
+
+    /**
+     * @brief 设置车辆检测的推理统计
+     * @param inferences 推理次数
+     * @param images 推理过的画面数
+     * @param objects 检测到的目标数
+     * @param cpuUs 推理消耗的CPU时间（微秒）
+     */
+    void setDetection(quint64 inferences, quint64 images, quint64 objects, qint64 cpuUs);
+
+    /**
+     * @brief 生成JSON报告
+     * @return JSON文档
+     */
+    QJsonDocument toJson() const;
+
+    /**
+     * @brief 写入报告文件
+     * @param path 文件路径
+     * @return 是否写入成功
+     */
+    bool write(const QString& path) const;
+
+    /**
+     * @brief 获取进程的内存占用峰值
+     * @return KB，不支持的平台返回-1
+     */
+    static qint64 peakRssKb();
+
+    /**
+     * @brief 获取进程当前的内存占用
+     * @return KB，不支持的平台返回-1
+     */
+    static qint64 currentRssKb();
+
+    /**
+     * @brief 获取进程已消耗的CPU时间（用户态+内核态）
+     * @return 微秒，不支持的平台返回-1
+     */
+    static qint64 processCpuTimeUs();
+
+private:
+    /**
+     * @brief 距离起始时刻的秒数
+     * @return 秒
+     */
+    double elapsedSeconds() const;
+
+    qint64 m_startUs;           ///< 起始时刻（单调时钟，微秒）
+    qint64 m_startCpuUs;        ///< 起始时的进程CPU时间
+    qint64 m_startRssKb;        ///< 起始时的内存占用
+    QJsonArray m_cameras;       ///< 各摄像头统计
+    QJsonObject m_detection;    ///< 车辆检测的推理统计
+};
+
+#endif // PERFREPORT_H
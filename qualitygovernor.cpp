@@ -0,0 +1,313 @@
+/**
+ * @file qualitygovernor.cpp
+ * @brief 自适应画质调节器的实现文件
+ */
+#include "qualitygovernor.h"
+#include "cameracaptureworker.h"
+#include "camerapipeline.h"
+#include "frametiming.h"
+#include "videotile.h"
+#include "workerpool.h"
+
+#include <QThreadPool>
+
+#include <iostream>
+
+namespace {
+
+// 采样周期
+constexpr int kSampleIntervalMs = 1000;
+
+// 排队延迟（区间平均延迟超出该摄像头基线的部分）与有效帧间隔之比的上下限，
+// 超过一个帧间隔说明有处理阶段已经跟不上
+constexpr double kHighLateness = 1.0;
+constexpr double kLowLateness = 0.25;
+
+// 丢帧率（采集后未显示就被覆盖的帧占比）的上下限
+constexpr double kHighDropRatio = 0.1;
+constexpr double kLowDropRatio = 0.01;
+
+// 一个周期内至少显示多少帧才更新基线，帧数过少时平均值不可靠
+constexpr quint64 kMinBaselineFrames = 5;
+
+// 界面线程负载的上下限，界面线程还要处理输入和其他控件，留出较多余量
+constexpr double kGuiHighLoad = 0.6;
+constexpr double kGuiLowLoad = 0.3;
+
+// 线程池负载的上下限
+constexpr double kPoolHighLoad = 0.85;
+constexpr double kPoolLowLoad = 0.5;
+
+// 连续超过上限多少个周期后降级
+constexpr int kOverloadedSamplesToStepDown = 2;
+
+// 连续低于下限多少个周期后恢复，比降级慢，避免刚恢复又超载
+constexpr int kHeadroomSamplesToStepUp = 5;
+
+// 每次调整后等待的周期数，让新的设置生效后再判断
+constexpr int kHoldSamplesAfterChange = 3;
+
+/**
+ * @brief 计算一个阶段在两次快照之间消耗的CPU时间
+ * @param now 当前快照
+ * @param last 上一次快照
+ * @param stage 阶段
+ * @return 微秒
+ */
+qint64 stageDeltaUs(const StageProfiler::Snapshot& now, const StageProfiler::Snapshot& last,
+                    StageProfiler::Stage stage)
+{
+    const int index = static_cast<int>(stage);
+    return now.cpuUs[index] - last.cpuUs[index];
+}
+
+} // namespace
+
+/**
+ * @brief QualityGovernor类的构造函数
+ * @param parent 父对象指针
+ */
+QualityGovernor::QualityGovernor(QObject *parent)
+    : QObject(parent)
+    , m_lastSampleUs(0)
+    , m_overloadedSamples(0)
+    , m_headroomSamples(0)
+    , m_holdSamples(0)
+    , m_adjustments(0)
+    , m_profilerOwned(false)
+{
+    connect(&m_timer, &QTimer::timeout, this, &QualityGovernor::sample);
+}
+
+/**
+ * @brief 添加一个摄像头
+ * @param pipeline 摄像头流水线
+ * @param protectedQuality 是否始终保持全画质
+ */
+void QualityGovernor::addCamera(CameraPipeline *pipeline, bool protectedQuality)
+{
+    Camera camera;
+    camera.pipeline = pipeline;
+    camera.protectedQuality = protectedQuality;
+    m_cameras.append(camera);
+}
+
+/**
+ * @brief 移除所有摄像头
+ */
+void QualityGovernor::clear()
+{
+    m_cameras.clear();
+}
+
+/**
+ * @brief 开始周期性采样
+ *
+ * 只有启用调节时才统计各阶段的CPU时间，--no-governor时不增加开销
+ */
+void QualityGovernor::start()
+{
+    if (!m_timer.isActive() && !StageProfiler::isEnabled()) {
+        StageProfiler::setEnabled(true);
+        m_profilerOwned = true;
+    }
+    for (Camera& camera : m_cameras) {
+        const LatencyStats::Summary summary = camera.pipeline->tile()->latencyStats().summary();
+        camera.lastFrames = summary.frames;
+        camera.lastDropped = summary.dropped;
+        camera.lastTotalMs = summary.totalMs;
+    }
+    m_lastSnapshot = StageProfiler::snapshot();
+    m_lastSampleUs = monotonicNowUs();
+    m_overloadedSamples = 0;
+    m_headroomSamples = 0;
+    m_holdSamples = 0;
+    m_timer.start(kSampleIntervalMs);
+}
+
+/**
+ * @brief 停止采样
+ */
+void QualityGovernor::stop()
+{
+    m_timer.stop();
+    if (m_profilerOwned) {
+        StageProfiler::setEnabled(false);
+        m_profilerOwned = false;
+    }
+}
+
+/**
+ * @brief 获取摄像头当前的画质等级
+ * @param pipeline 摄像头流水线
+ * @return 画质等级
+ */
+int QualityGovernor::level(const CameraPipeline *pipeline) const
+{
+    for (const Camera& camera : m_cameras) {
+        if (camera.pipeline == pipeline)
+            return camera.level;
+    }
+    return 0;
+}
+
+/**
+ * @brief 计算本周期内最迟的摄像头的排队延迟和丢帧率
+ * @return 各摄像头中的最大值
+ *
+ * 采集到显示的延迟包含传感器读出、USB传输、解码和等待绘制等固定开销，降低画质也无法消除，
+ * 因此不直接与帧间隔比较，而是减去该摄像头在全画质下测得的最低区间平均延迟（基线），
+ * 只有超出的部分才是处理跟不上造成的排队。基线只在等级0时更新，降级后延迟下降也不会拉低基线。
+ * 预算取降低帧率后的有效帧间隔。驾驶员摄像头虽然不降级，其迟到同样说明整体负载过高，也参与计算
+ */
+QualityGovernor::Lateness QualityGovernor::sampleLateness()
+{
+    Lateness lateness;
+    for (Camera& camera : m_cameras) {
+        const LatencyStats::Summary summary = camera.pipeline->tile()->latencyStats().summary();
+        if (summary.frames > camera.lastFrames && summary.totalMs >= camera.lastTotalMs
+            && summary.dropped >= camera.lastDropped) {
+            const quint64 frames = summary.frames - camera.lastFrames;
+            const quint64 dropped = summary.dropped - camera.lastDropped;
+            const double averageMs = (summary.totalMs - camera.lastTotalMs) / frames;
+            if (camera.level == 0 && frames >= kMinBaselineFrames
+                && (camera.baselineMs < 0.0 || averageMs < camera.baselineMs)) {
+                camera.baselineMs = averageMs;
+            }
+            if (camera.baselineMs >= 0.0) {
+                const int divisor = camera.level >= 2 ? 2 : 1;
+                const double budgetMs = 1000.0 * divisor / qMax(1, camera.pipeline->config().source.fps);
+                lateness.queueing = qMax(lateness.queueing, qMax(0.0, averageMs - camera.baselineMs) / budgetMs);
+            }
+            lateness.dropRatio = qMax(lateness.dropRatio, static_cast<double>(dropped) / (frames + dropped));
+        }
+        camera.lastFrames = summary.frames;
+        camera.lastDropped = summary.dropped;
+        camera.lastTotalMs = summary.totalMs;
+    }
+    return lateness;
+}
+
+/**
+ * @brief 采样一个周期的延迟和CPU时间并决定是否调整画质
+ *
+ * 取帧和绘制都在界面线程中串行执行，其CPU时间直接与墙钟时间比较；
+ * 解码和缩放分布在线程池的各线程中，与线程数乘以墙钟时间比较
+ */
+void QualityGovernor::sample()
+{
+    const Lateness lateness = sampleLateness();
+    const StageProfiler::Snapshot snapshot = StageProfiler::snapshot();
+    const qint64 nowUs = monotonicNowUs();
+    const qint64 elapsedUs = qMax<qint64>(1, nowUs - m_lastSampleUs);
+
+    using Stage = StageProfiler::Stage;
+    const qint64 guiUs = stageDeltaUs(snapshot, m_lastSnapshot, Stage::Present)
+                       + stageDeltaUs(snapshot, m_lastSnapshot, Stage::Paint);
+    const qint64 poolUs = stageDeltaUs(snapshot, m_lastSnapshot, Stage::Decode)
+                        + stageDeltaUs(snapshot, m_lastSnapshot, Stage::Scale);
+    const int poolThreads = qMax(1, frameWorkerPool()->maxThreadCount());
+    const double guiLoad = static_cast<double>(guiUs) / elapsedUs;
+    const double poolLoad = static_cast<double>(poolUs) / (static_cast<double>(elapsedUs) * poolThreads);
+
+    m_lastSnapshot = snapshot;
+    m_lastSampleUs = nowUs;
+
+    if (m_holdSamples > 0) {
+        --m_holdSamples;
+        return;
+    }
+
+    // 排队和丢帧决定是否调整，CPU负载只在排队处于上下限之间时促成降级，或阻止恢复；
+    // 上下限之间的情况两个计数都清零，形成滞回区间
+    const bool cpuOverloaded = guiLoad > kGuiHighLoad || poolLoad > kPoolHighLoad;
+    const bool cpuHeadroom = guiLoad < kGuiLowLoad && poolLoad < kPoolLowLoad;
+    const bool overloaded = lateness.queueing > kHighLateness || lateness.dropRatio > kHighDropRatio
+                            || (lateness.queueing > kLowLateness && cpuOverloaded);
+    const bool headroom = lateness.queueing < kLowLateness && lateness.dropRatio < kLowDropRatio && cpuHeadroom;
+    m_overloadedSamples = overloaded ? m_overloadedSamples + 1 : 0;
+    m_headroomSamples = headroom ? m_headroomSamples + 1 : 0;
+
+    bool changed = false;
+    if (m_overloadedSamples >= kOverloadedSamplesToStepDown) {
+        changed = stepDown();
+    } else if (m_headroomSamples >= kHeadroomSamplesToStepUp) {
+        changed = stepUp();
+    }
+
+    if (changed) {
+        std::cout << "（排队延迟" << qRound(lateness.queueing * 100) << "%帧间隔，丢帧率"
+                  << qRound(lateness.dropRatio * 100) << "%，界面线程负载" << static_cast<int>(guiLoad * 100)
+                  << "%，线程池负载" << static_cast<int>(poolLoad * 100) << "%）" << std::endl;
+        m_overloadedSamples = 0;
+        m_headroomSamples = 0;
+        m_holdSamples = kHoldSamplesAfterChange;
+    }
+}
+
+/**
+ * @brief 降低一个摄像头一级画质
+ * @return 是否有摄像头可以降级
+ *
+ * 优先级最低的摄像头先降级，同一优先级内先降等级最低的，使降级均匀分布
+ */
+bool QualityGovernor::stepDown()
+{
+    Camera *target = nullptr;
+    for (Camera& camera : m_cameras) {
+        if (camera.protectedQuality || camera.level >= kMaxLevel)
+            continue;
+        const int priority = camera.pipeline->config().priority;
+        if (!target || priority < target->pipeline->config().priority
+            || (priority == target->pipeline->config().priority && camera.level < target->level)) {
+            target = &camera;
+        }
+    }
+    if (!target)
+        return false;
+
+    applyLevel(*target, target->level + 1);
+    return true;
+}
+
+/**
+ * @brief 恢复一个摄像头一级画质
+ * @return 是否有摄像头可以恢复
+ *
+ * 与降级顺序相反：优先级最高的摄像头先恢复，同一优先级内先恢复等级最高的
+ */
+bool QualityGovernor::stepUp()
+{
+    Camera *target = nullptr;
+    for (Camera& camera : m_cameras) {
+        if (camera.level == 0)
+            continue;
+        const int priority = camera.pipeline->config().priority;
+        if (!target || priority > target->pipeline->config().priority
+            || (priority == target->pipeline->config().priority && camera.level > target->level)) {
+            target = &camera;
+        }
+    }
+    if (!target)
+        return false;
+
+    applyLevel(*target, target->level - 1);
+    return true;
+}
+
+/**
+ * @brief 把画质等级应用到摄像头
+ * @param camera 摄像头
+ * @param level 画质等级
+ */
+void QualityGovernor::applyLevel(Camera& camera, int level)
+{
+    std::cout << "画质调整: " << camera.pipeline->config().name.toStdString()
+              << " 等级" << camera.level << " -> " << level;
+    camera.level = level;
+    ++m_adjustments;
+
+    camera.pipeline->tile()->setRenderScale(level >= 1 ? 0.5 : 1.0);
+    camera.pipeline->worker()->setFrameDivisor(level >= 2 ? 2 : 1);
+    camera.pipeline->worker()->setCaptureDivisor(level >= 3 ? 2 : 1);
+}
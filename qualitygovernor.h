@@ -0,0 +1,157 @@
+/**
+ * @file qualitygovernor.h
+ * @brief 自适应画质调节器的头文件
+ *
+ * 该文件定义了QualityGovernor类，按各摄像头采集到显示的实际延迟判断是否超出帧预算，
+ * 画面跟不上时按摄像头优先级逐级降低画质，延迟回落后再逐级恢复。
+ */
+#ifndef QUALITYGOVERNOR_H
+#define QUALITYGOVERNOR_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include "stageprofiler.h"
+
+class CameraPipeline;
+
+/**
+ * @class QualityGovernor
+ * @brief 自适应画质调节器
+ *
+ * 主要依据是墙钟时间上的排队：每个采样周期取各摄像头在该周期内显示的帧的
+ * 平均采集到显示延迟，减去该摄像头全画质时测得的基线（传感器、传输、解码等固定开销），
+ * 超出部分除以降低帧率后的有效帧间隔；另取该周期内的丢帧率，均取所有摄像头中的最大值。
+ * CPU时间只作为辅助判断：界面线程上取帧和绘制的CPU时间占墙钟时间的比例，
+ * 以及线程池中解码和缩放的CPU时间占全部线程可用时间的比例。
+ * 排队或丢帧超过上限，或排队处于上下限之间且CPU负载超过上限，连续数个周期后降低一个摄像头
+ * 一级画质；排队、丢帧和CPU负载都低于下限并持续数个周期后恢复一级；
+ * 每次调整后等待数个周期再判断，避免来回振荡。CPU负载高但画面准时时不降级。
+ *
+ * 画质等级：
+ * - 0：全画质
+ * - 1：按一半尺寸解码和缩放，绘制时放大
+ * - 2：再把显示帧率降为一半
+ * - 3：再把采集分辨率降为一半（需要重新打开设备，录像回放不支持）
+ *
+ * 降级时选择优先级最低、等级最低的摄像头，恢复时选择优先级最高、等级最高的摄像头，
+ * 受保护的摄像头（驾驶员摄像头）始终保持全画质。仅在界面线程中使用。
+ */
+class QualityGovernor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kMaxLevel = 3;     ///< 最低画质等级
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit QualityGovernor(QObject *parent = nullptr);
+
+    /**
+     * @brief 添加一个摄像头
+     * @param pipeline 摄像头流水线，生命周期须长于调节器或在其之前调用clear()
+     * @param protectedQuality 是否始终保持全画质
+     */
+    void addCamera(CameraPipeline *pipeline, bool protectedQuality);
+
+    /**
+     * @brief 移除所有摄像头，不恢复它们的画质
+     */
+    void clear();
+
+    /**
+     * @brief 开始周期性采样，同时启用StageProfiler
+     */
+    void start();
+
+    /**
+     * @brief 停止采样，恢复start()之前StageProfiler的启用状态
+     */
+    void stop();
+
+    /**
+     * @brief 获取摄像头当前的画质等级
+     * @param pipeline 摄像头流水线
+     * @return 画质等级，未添加的摄像头返回0
+     */
+    int level(const CameraPipeline *pipeline) const;
+
+    /**
+     * @brief 获取画质调整次数
+     * @return 降级和恢复的总次数
+     */
+    int adjustments() const { return m_adjustments; }
+
+private slots:
+    /**
+     * @brief 采样一个周期的延迟和CPU时间并决定是否调整画质
+     */
+    void sample();
+
+private:
+    /**
+     * @struct Camera
+     * @brief 受调节的摄像头
+     */
+    struct Camera
+    {
+        CameraPipeline *pipeline = nullptr;     ///< 摄像头流水线
+        bool protectedQuality = false;          ///< 是否始终保持全画质
+        int level = 0;                          ///< 当前画质等级
+        quint64 lastFrames = 0;                 ///< 上一次采样时已显示的帧数
+        quint64 lastDropped = 0;                ///< 上一次采样时的丢帧数
+        double lastTotalMs = 0.0;               ///< 上一次采样时的延迟之和（毫秒）
+        double baselineMs = -1.0;               ///< 全画质下最低的区间平均延迟（毫秒），小于0表示尚未测得
+    };
+
+    /**
+     * @struct Lateness
+     * @brief 一个采样周期内各摄像头中最严重的迟到情况
+     */
+    struct Lateness
+    {
+        double queueing = 0.0;                  ///< 平均延迟超出基线的部分与有效帧间隔之比
+        double dropRatio = 0.0;                 ///< 丢帧数占采集帧数的比例
+    };
+
+    /**
+     * @brief 计算本周期内最迟的摄像头的迟到情况，并记下各摄像头的统计
+     * @return 各摄像头中的最大值，没有摄像头显示新帧时都为0
+     */
+    Lateness sampleLateness();
+
+    /**
+     * @brief 降低一个摄像头一级画质
+     * @return 是否有摄像头可以降级
+     */
+    bool stepDown();
+
+    /**
+     * @brief 恢复一个摄像头一级画质
+     * @return 是否有摄像头可以恢复
+     */
+    bool stepUp();
+
+    /**
+     * @brief 把画质等级应用到摄像头
+     * @param camera 摄像头
+     * @param level 画质等级
+     */
+    void applyLevel(Camera& camera, int level);
+
+    QVector<Camera> m_cameras;              ///< 受调节的摄像头
+    QTimer m_timer;                         ///< 采样定时器
+    StageProfiler::Snapshot m_lastSnapshot; ///< 上一次采样的CPU时间
+    qint64 m_lastSampleUs;                  ///< 上一次采样的时刻（单调时钟，微秒）
+    int m_overloadedSamples;                ///< 连续超过上限的周期数
+    int m_headroomSamples;                  ///< 连续低于下限的周期数
+    int m_holdSamples;                      ///< 调整后还需等待的周期数
+    int m_adjustments;                      ///< 调整次数
+    bool m_profilerOwned;                   ///< StageProfiler是否由start()启用
+};
+
+#endif // QUALITYGOVERNOR_H
@@ -0,0 +1,38 @@
+/**
+ * @file reconnectbackoff.cpp
+ * @brief 重连退避策略的实现文件
+ */
+#include "reconnectbackoff.h"
+
+#include <QRandomGenerator>
+#include <QtGlobal>
+
+/**
+ * @brief ReconnectBackoff类的构造函数
+ * @param initialDelayMs 首次重试的等待时间
+ * @param maxDelayMs 等待时间上限
+ * @param jitter 抖动比例
+ */
+ReconnectBackoff::ReconnectBackoff(int initialDelayMs, int maxDelayMs, double jitter)
+    : m_initialDelayMs(qMax(1, initialDelayMs))
+    , m_maxDelayMs(qMax(initialDelayMs, maxDelayMs))
+    , m_jitter(qBound(0.0, jitter, 1.0))
+    , m_attempts(0)
+{
+}
+
+/**
+ * @brief 记录一次失败并返回下次重试前的等待时间
+ * @return 等待时间（毫秒）
+ */
+int ReconnectBackoff::nextDelayMs()
+{
+    // 移位次数有限，避免溢出
+    const int shift = qMin(m_attempts, 16);
+    ++m_attempts;
+
+    const double base = qMin(static_cast<double>(m_maxDelayMs),
+                             static_cast<double>(m_initialDelayMs) * (1 << shift));
+    const double factor = 1.0 + m_jitter * (2.0 * QRandomGenerator::global()->generateDouble() - 1.0);
+    return qMax(1, static_cast<int>(base * factor));
+}
@@ -0,0 +1,50 @@
+/**
+ * @file reconnectbackoff.h
+ * @brief 重连退避策略的头文件
+ */
+#ifndef RECONNECTBACKOFF_H
+#define RECONNECTBACKOFF_H
+
+/**
+ * @class ReconnectBackoff
+ * @brief 带随机抖动的指数退避
+ *
+ * 每次失败后等待时间翻倍直到上限，并加入随机抖动，
+ * 避免同一USB集线器上的多个摄像头在同一时刻重连
+ */
+class ReconnectBackoff
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param initialDelayMs 首次重试的等待时间（毫秒）
+     * @param maxDelayMs 等待时间上限（毫秒）
+     * @param jitter 抖动比例，0.2表示在±20%范围内随机
+     */
+    explicit ReconnectBackoff(int initialDelayMs = 250, int maxDelayMs = 8000, double jitter = 0.2);
+
+    /**
+     * @brief 记录一次失败并返回下次重试前的等待时间
+     * @return 等待时间（毫秒）
+     */
+    int nextDelayMs();
+
+    /**
+     * @brief 连接成功后重置
+     */
+    void reset() { m_attempts = 0; }
+
+    /**
+     * @brief 获取连续失败次数
+     * @return 失败次数
+     */
+    int attempts() const { return m_attempts; }
+
+private:
+    int m_initialDelayMs;   ///< 首次等待时间
+    int m_maxDelayMs;       ///< 等待时间上限
+    double m_jitter;        ///< 抖动比例
+    int m_attempts;         ///< 连续失败次数
+};
+
+#endif // RECONNECTBACKOFF_H
@@ -0,0 +1,44 @@
+/**
+ * @file replayframesource.h
+ * @brief 录像文件回放帧源的头文件
+ */
+#ifndef REPLAYFRAMESOURCE_H
+#define REPLAYFRAMESOURCE_H
+
+#include <opencv2/videoio.hpp>
+
+#include "framesource.h"
+
+/**
+ * @class ReplayFrameSource
+ * @brief 录像文件回放帧源
+ *
+ * 在没有摄像头的开发机和CI上代替真实设备，按文件的原始帧率（或尽可能快地）
+ * 输出帧，并生成与真实采集一致的单调时间戳
+ */
+class ReplayFrameSource : public FrameSource
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param path 录像文件路径
+     * @param config 采集参数，使用realtime、speed、loop、startUs和fps字段
+     */
+    ReplayFrameSource(const QString& path, const FrameSourceConfig& config);
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_capture.isOpened(); }
+    GrabResult grab(CameraFrame& frame, int timeoutMs) override;
+    QString location() const override { return m_path; }
+    bool isReplay() const override { return true; }
+
+private:
+    QString m_path;                 ///< 录像文件路径
+    FrameSourceConfig m_config;     ///< 采集参数
+    cv::VideoCapture m_capture;     ///< 文件解码器
+    qint64 m_frameIntervalUs;       ///< 帧间隔（微秒）
+    qint64 m_nextFrameTimeUs;       ///< 下一帧的计划输出时刻（单调时钟，微秒）
+};
+
+#endif // REPLAYFRAMESOURCE_H
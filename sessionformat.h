@@ -0,0 +1,74 @@
+/**
+ * @file sessionformat.h
+ * @brief 录像会话文件格式的头文件
+ *
+ * 会话文件（.adss）把多个摄像头的压缩帧保存在同一个文件中，文件末尾是
+ * 各摄像头按时间排序的索引。读取时整个文件映射到内存，按时间定位任意帧只需一次二分查找，
+ * 帧数据直接从映射区交给解码器。
+ *
+ * 文件布局：
+ * @code
+ * SessionHeader                    文件头，64字节
+ * 帧数据                           各摄像头的帧按写入顺序依次排列，没有分隔
+ * SessionIndexEntry[]              摄像头0的索引，按时间排序
+ * ...                              其余摄像头的索引
+ * SessionCameraEntry[cameraCount]  摄像头表
+ * @endcode
+ * 所有整数均为小端序。文件头中的cameraTableOffset为0表示录像未正常结束，没有索引。
+ */
+#ifndef SESSIONFORMAT_H
+#define SESSIONFORMAT_H
+
+#include <QtGlobal>
+
+/// 文件头魔数
+constexpr char kSessionMagic[8] = {'A', 'D', 'A', 'S', 'S', 'E', 'S', '1'};
+
+/// 文件格式版本
+constexpr quint32 kSessionVersion = 1;
+
+/**
+ * @struct SessionHeader
+ * @brief 会话文件头
+ */
+struct SessionHeader
+{
+    char magic[8];                  ///< 魔数kSessionMagic
+    quint32 version;                ///< 格式版本
+    quint32 cameraCount;            ///< 摄像头数量
+    quint64 cameraTableOffset;      ///< 摄像头表的文件偏移，0表示未正常结束
+    qint64 startTimeUs;             ///< 最早一帧的时间戳（单调时钟，微秒）
+    qint64 endTimeUs;               ///< 最晚一帧的时间戳
+    qint64 createdMs;               ///< 文件创建时间（UTC毫秒）
+    quint8 reserved[16];            ///< 保留，填0
+};
+
+/**
+ * @struct SessionCameraEntry
+ * @brief 摄像头表中的一项
+ */
+struct SessionCameraEntry
+{
+    quint64 indexOffset;            ///< 该摄像头索引的文件偏移
+    quint32 frameCount;             ///< 帧数
+    quint32 fourcc;                 ///< 帧数据的像素格式
+    char name[48];                  ///< 摄像头名称（UTF-8，以0结尾）
+};
+
+/**
+ * @struct SessionIndexEntry
+ * @brief 索引中的一项，对应一帧
+ */
+struct SessionIndexEntry
+{
+    qint64 timeUs;                  ///< 采集时间戳（单调时钟，微秒）
+    quint64 offset;                 ///< 帧数据的文件偏移
+    quint32 size;                   ///< 帧数据字节数
+    quint32 reserved;               ///< 保留，填0
+};
+
+static_assert(sizeof(SessionHeader) == 64, "SessionHeader必须为64字节");
+static_assert(sizeof(SessionCameraEntry) == 64, "SessionCameraEntry必须为64字节");
+static_assert(sizeof(SessionIndexEntry) == 24, "SessionIndexEntry必须为24字节");
+
+#endif // SESSIONFORMAT_H
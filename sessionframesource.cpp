@@ -0,0 +1,195 @@
+/**
+ * @file sessionframesource.cpp
+ * @brief 录像会话回放帧源的实现文件
+ */
+#include "sessionframesource.h"
+#include "frametiming.h"
+#include "sessionreader.h"
+
+#include <QFile>
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// 位置前缀
+const QString kSessionPrefix = QStringLiteral("session:");
+
+// 落后超过该时间（如被调试器暂停）时直接跳到当前会话时间，而不是连续追帧
+constexpr qint64 kMaxLagUs = 1000000;
+
+// 会话过短时一次循环的最短时长，避免只有一帧的会话空转
+constexpr qint64 kMinLoopUs = 100000;
+
+} // namespace
+
+/**
+ * @brief SessionFrameSource类的构造函数
+ * @param location 位置
+ * @param config 采集参数
+ *
+ * 位置中没有"#<摄像头索引>"时使用摄像头0
+ */
+SessionFrameSource::SessionFrameSource(const QString& location, const FrameSourceConfig& config)
+    : m_location(location)
+    , m_camera(0)
+    , m_config(config)
+    , m_nextIndex(0)
+    , m_anchorFrameUs(0)
+    , m_anchorWallUs(0)
+{
+    m_path = location.mid(kSessionPrefix.size());
+    const int hash = m_path.lastIndexOf('#');
+    if (hash >= 0) {
+        m_camera = m_path.mid(hash + 1).toInt();
+        m_path.truncate(hash);
+    }
+}
+
+/**
+ * @brief 判断位置是否表示会话文件中的摄像头
+ * @param location 位置
+ * @return 是否以"session:"开头
+ */
+bool SessionFrameSource::isSessionLocation(const QString& location)
+{
+    return location.startsWith(kSessionPrefix);
+}
+
+/**
+ * @brief 生成会话文件中某个摄像头的位置
+ * @param path 会话文件路径
+ * @param camera 摄像头索引
+ * @return 位置
+ */
+QString SessionFrameSource::sessionLocation(const QString& path, int camera)
+{
+    return QString("%1%2#%3").arg(kSessionPrefix, path).arg(camera);
+}
+
+/**
+ * @brief 打开会话文件并定位到当前会话时间
+ * @return 是否打开成功
+ *
+ * 起始位置对应共同的基准时刻clockStartUs，晚打开或重连的摄像头直接从
+ * 其他摄像头正在播放的位置开始
+ */
+bool SessionFrameSource::open()
+{
+    auto reader = std::make_shared<SessionReader>();
+    if (!reader->open(m_path) || reader->frameCount(m_camera) == 0)
+        return false;
+
+    m_reader = reader;
+    const qint64 wallUs = m_config.clockStartUs > 0 ? m_config.clockStartUs : monotonicNowUs();
+    anchor(m_reader->startTimeUs() + m_config.startUs, wallUs);
+    return true;
+}
+
+/**
+ * @brief 关闭帧源
+ *
+ * 仍在解码的帧持有读取器，映射区在它们释放后才解除
+ */
+void SessionFrameSource::close()
+{
+    m_reader.reset();
+}
+
+/**
+ * @brief 会话文件是否存在
+ * @return 是否存在
+ */
+bool SessionFrameSource::isPresent() const
+{
+    return QFile::exists(m_path);
+}
+
+/**
+ * @brief 跳转到指定时刻
+ * @param offsetUs 相对会话开始的时间
+ *
+ * 从现在起以该时刻为会话时间轴的基准，二分查找该摄像头的索引，不读取任何帧数据
+ */
+void SessionFrameSource::seek(qint64 offsetUs)
+{
+    if (!m_reader)
+        return;
+
+    anchor(m_reader->startTimeUs() + offsetUs, monotonicNowUs());
+}
+
+/**
+ * @brief 把会话时间轴对齐到指定时刻
+ * @param sessionUs 会话时间
+ * @param wallUs 对应的单调时钟时刻
+ *
+ * 基准取目标会话时间而不是找到的帧的时间戳，各摄像头的帧间隔不同也落在同一条时间轴上
+ */
+void SessionFrameSource::anchor(qint64 sessionUs, qint64 wallUs)
+{
+    m_anchorFrameUs = sessionUs;
+    m_anchorWallUs = wallUs;
+    const qint64 targetUs = m_config.realtime ? sessionTimeAt(monotonicNowUs()) : sessionUs;
+    m_nextIndex = qMax(0, m_reader->seek(m_camera, targetUs));
+}
+
+/**
+ * @brief 计算某一时刻对应的会话时间
+ * @param wallUs 单调时钟时刻
+ * @return 会话时间
+ */
+qint64 SessionFrameSource::sessionTimeAt(qint64 wallUs) const
+{
+    const double speed = qMax(0.01, m_config.speed);
+    return m_anchorFrameUs + static_cast<qint64>((wallUs - m_anchorWallUs) * speed);
+}
+
+/**
+ * @brief 按原始时间间隔输出下一帧
+ * @param frame 输出帧
+ * @param timeoutMs 最长等待时间（毫秒）
+ * @return 取帧结果
+ */
+FrameSource::GrabResult SessionFrameSource::grab(CameraFrame& frame, int timeoutMs)
+{
+    if (!m_reader)
+        return GrabResult::Error;
+
+    if (m_nextIndex >= m_reader->frameCount(m_camera)) {
+        if (!m_config.loop)
+            return GrabResult::Error;
+        // 会话时间轴走到结尾时回到会话开始时刻，与其他摄像头在同一时刻循环
+        const double speed = qMax(0.01, m_config.speed);
+        const qint64 loopUs = qMax(kMinLoopUs, m_reader->endTimeUs() - m_anchorFrameUs);
+        m_anchorWallUs += static_cast<qint64>(loopUs / speed);
+        m_anchorFrameUs = m_reader->startTimeUs();
+        m_nextIndex = 0;
+    }
+
+    SessionReader::Frame next = m_reader->frame(m_camera, m_nextIndex);
+    if (m_config.realtime) {
+        const double speed = qMax(0.01, m_config.speed);
+        const qint64 dueUs = m_anchorWallUs + static_cast<qint64>((next.timeUs - m_anchorFrameUs) / speed);
+        const qint64 waitUs = dueUs - monotonicNowUs();
+        if (waitUs < -kMaxLagUs) {
+            // 跳到当前会话时间，时间轴不变，仍与其他摄像头同步
+            m_nextIndex = qMax(m_nextIndex, m_reader->seek(m_camera, sessionTimeAt(monotonicNowUs())));
+            next = m_reader->frame(m_camera, m_nextIndex);
+        } else if (waitUs > static_cast<qint64>(timeoutMs) * 1000) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+            return GrabResult::Timeout;
+        } else if (waitUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+        }
+    }
+    ++m_nextIndex;
+
+    // 压缩数据直接指向映射区，由解码任务读取
+    frame.raw = cv::Mat(1, static_cast<int>(next.size), CV_8UC1, const_cast<uchar*>(next.data));
+    frame.rawFormat = m_reader->fourcc(m_camera);
+    frame.buffer = m_reader;
+    frame.deviceTimestampUs = monotonicNowUs();
+    return GrabResult::Frame;
+}
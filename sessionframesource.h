@@ -0,0 +1,91 @@
+/**
+ * @file sessionframesource.h
+ * @brief 录像会话回放帧源的头文件
+ *
+ * 该文件定义了SessionFrameSource类，从内存映射的会话文件中按原始时间戳回放
+ * 某一个摄像头的压缩帧，解码和显示与实时摄像头走同一条流水线。
+ */
+#ifndef SESSIONFRAMESOURCE_H
+#define SESSIONFRAMESOURCE_H
+
+#include <memory>
+
+#include "framesource.h"
+
+class SessionReader;
+
+/**
+ * @class SessionFrameSource
+ * @brief 录像会话回放帧源
+ *
+ * 位置写作"session:<文件路径>#<摄像头索引>"。帧数据直接指向映射区，
+ * 通过CameraFrame::buffer持有读取器，解码完成前文件不会被解除映射。
+ * 按会话时间轴输出，realtime为false时尽可能快地输出。同一会话的各摄像头以
+ * clockStartUs为共同的基准时刻，落后时跳到当前会话时间而不是各自重新对齐，
+ * 循环时一起回到会话开始时刻，各路画面始终保持同步。
+ */
+class SessionFrameSource : public FrameSource
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param location 位置，如"session:/data/event.adss#0"
+     * @param config 采集参数，使用realtime、speed、loop、startUs和clockStartUs字段
+     */
+    SessionFrameSource(const QString& location, const FrameSourceConfig& config);
+
+    /**
+     * @brief 判断位置是否表示会话文件中的摄像头
+     * @param location 位置
+     * @return 是否以"session:"开头
+     */
+    static bool isSessionLocation(const QString& location);
+
+    /**
+     * @brief 生成会话文件中某个摄像头的位置
+     * @param path 会话文件路径
+     * @param camera 摄像头索引
+     * @return 位置
+     */
+    static QString sessionLocation(const QString& path, int camera);
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_reader != nullptr; }
+    bool isPresent() const override;
+    GrabResult grab(CameraFrame& frame, int timeoutMs) override;
+    QString location() const override { return m_location; }
+    bool isReplay() const override { return true; }
+
+    /**
+     * @brief 跳转到指定时刻，下一次grab()从该时刻的帧开始输出
+     * @param offsetUs 相对会话开始的时间（微秒）
+     */
+    void seek(qint64 offsetUs);
+
+private:
+    /**
+     * @brief 把会话时间轴对齐到指定时刻，并定位到该时刻应输出的帧
+     * @param sessionUs 会话时间（与帧时间戳同一时钟）
+     * @param wallUs sessionUs对应的单调时钟时刻
+     */
+    void anchor(qint64 sessionUs, qint64 wallUs);
+
+    /**
+     * @brief 计算某一时刻对应的会话时间
+     * @param wallUs 单调时钟时刻
+     * @return 会话时间
+     */
+    qint64 sessionTimeAt(qint64 wallUs) const;
+
+    QString m_location;                         ///< 位置
+    QString m_path;                             ///< 会话文件路径
+    int m_camera;                               ///< 摄像头索引
+    FrameSourceConfig m_config;                 ///< 采集参数
+    std::shared_ptr<SessionReader> m_reader;    ///< 会话文件读取器，与交出的帧共享
+    int m_nextIndex;                            ///< 下一帧的序号
+    qint64 m_anchorFrameUs;                     ///< 会话时间轴的基准时间
+    qint64 m_anchorWallUs;                      ///< 基准时间对应的时刻（单调时钟，微秒）
+};
+
+#endif // SESSIONFRAMESOURCE_H
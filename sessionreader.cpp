@@ -0,0 +1,206 @@
+/**
+ * @file sessionreader.cpp
+ * @brief 录像会话文件读取器的实现文件
+ */
+#include "sessionreader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief SessionReader类的构造函数
+ */
+SessionReader::SessionReader()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_header(nullptr)
+    , m_cameras(nullptr)
+{
+}
+
+/**
+ * @brief SessionReader类的析构函数
+ */
+SessionReader::~SessionReader()
+{
+    close();
+}
+
+/**
+ * @brief 打开并映射会话文件
+ * @param path 文件路径
+ * @return 是否打开成功
+ *
+ * 所有偏移在这里一次性校验，之后的访问不再检查文件内容
+ */
+bool SessionReader::open(const QString& path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    m_size = m_file.size();
+    if (m_size < static_cast<qint64>(sizeof(SessionHeader))) {
+        close();
+        return false;
+    }
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        std::cerr << "会话文件映射失败: " << path.toStdString() << std::endl;
+        close();
+        return false;
+    }
+
+    const SessionHeader *header = reinterpret_cast<const SessionHeader*>(m_data);
+    if (std::memcmp(header->magic, kSessionMagic, sizeof(header->magic)) != 0
+        || header->version != kSessionVersion) {
+        std::cerr << "不是有效的会话文件: " << path.toStdString() << std::endl;
+        close();
+        return false;
+    }
+    if (header->cameraTableOffset == 0) {
+        std::cerr << "会话文件未正常结束，没有索引: " << path.toStdString() << std::endl;
+        close();
+        return false;
+    }
+
+    const quint64 size = static_cast<quint64>(m_size);
+    const quint64 tableBytes = static_cast<quint64>(header->cameraCount) * sizeof(SessionCameraEntry);
+    if (header->cameraTableOffset % alignof(SessionCameraEntry) != 0
+        || header->cameraTableOffset > size || tableBytes > size - header->cameraTableOffset) {
+        close();
+        return false;
+    }
+    const SessionCameraEntry *cameras = reinterpret_cast<const SessionCameraEntry*>(m_data + header->cameraTableOffset);
+
+    for (quint32 i = 0; i < header->cameraCount; ++i) {
+        const SessionCameraEntry& camera = cameras[i];
+        const quint64 indexBytes = static_cast<quint64>(camera.frameCount) * sizeof(SessionIndexEntry);
+        if (camera.indexOffset % alignof(SessionIndexEntry) != 0
+            || camera.indexOffset > size || indexBytes > size - camera.indexOffset) {
+            close();
+            return false;
+        }
+        const SessionIndexEntry *index = reinterpret_cast<const SessionIndexEntry*>(m_data + camera.indexOffset);
+        for (quint32 j = 0; j < camera.frameCount; ++j) {
+            if (index[j].offset > size || index[j].size > size - index[j].offset
+                || (j > 0 && index[j].timeUs < index[j - 1].timeUs)) {
+                std::cerr << "会话文件索引损坏: " << path.toStdString() << std::endl;
+                close();
+                return false;
+            }
+        }
+    }
+
+    m_header = header;
+    m_cameras = cameras;
+    return true;
+}
+
+/**
+ * @brief 解除映射并关闭文件
+ */
+void SessionReader::close()
+{
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+    m_header = nullptr;
+    m_cameras = nullptr;
+}
+
+/**
+ * @brief 获取摄像头名称
+ * @param camera 摄像头索引
+ * @return 名称
+ */
+QString SessionReader::cameraName(int camera) const
+{
+    if (camera < 0 || camera >= cameraCount())
+        return QString();
+    const char *name = m_cameras[camera].name;
+    return QString::fromUtf8(name, static_cast<int>(strnlen(name, sizeof(m_cameras[camera].name))));
+}
+
+/**
+ * @brief 获取摄像头的帧数
+ * @param camera 摄像头索引
+ * @return 帧数
+ */
+int SessionReader::frameCount(int camera) const
+{
+    if (camera < 0 || camera >= cameraCount())
+        return 0;
+    return static_cast<int>(m_cameras[camera].frameCount);
+}
+
+/**
+ * @brief 获取摄像头帧数据的像素格式
+ * @param camera 摄像头索引
+ * @return FOURCC
+ */
+quint32 SessionReader::fourcc(int camera) const
+{
+    if (camera < 0 || camera >= cameraCount())
+        return 0;
+    return m_cameras[camera].fourcc;
+}
+
+/**
+ * @brief 按时间定位
+ * @param camera 摄像头索引
+ * @param timeUs 时间戳
+ * @return 帧序号
+ */
+int SessionReader::seek(int camera, qint64 timeUs) const
+{
+    const SessionIndexEntry *index = indexOf(camera);
+    const int count = frameCount(camera);
+    if (!index || count == 0)
+        return -1;
+
+    const SessionIndexEntry *end = index + count;
+    const SessionIndexEntry *after = std::upper_bound(index, end, timeUs,
+        [](qint64 time, const SessionIndexEntry& entry) { return time < entry.timeUs; });
+    return after == index ? 0 : static_cast<int>(after - index) - 1;
+}
+
+/**
+ * @brief 获取一帧
+ * @param camera 摄像头索引
+ * @param index 帧序号
+ * @return 帧
+ */
+SessionReader::Frame SessionReader::frame(int camera, int index) const
+{
+    Frame result;
+    const SessionIndexEntry *entries = indexOf(camera);
+    if (!entries || index < 0 || index >= frameCount(camera))
+        return result;
+
+    const SessionIndexEntry& entry = entries[index];
+    result.data = m_data + entry.offset;
+    result.size = entry.size;
+    result.timeUs = entry.timeUs;
+    return result;
+}
+
+/**
+ * @brief 获取摄像头的索引数组
+ * @param camera 摄像头索引
+ * @return 索引首地址
+ */
+const SessionIndexEntry* SessionReader::indexOf(int camera) const
+{
+    if (camera < 0 || camera >= cameraCount())
+        return nullptr;
+    return reinterpret_cast<const SessionIndexEntry*>(m_data + m_cameras[camera].indexOffset);
+}
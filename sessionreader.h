@@ -0,0 +1,133 @@
+/**
+ * @file sessionreader.h
+ * @brief 录像会话文件读取器的头文件
+ */
+#ifndef SESSIONREADER_H
+#define SESSIONREADER_H
+
+#include <QFile>
+#include <QString>
+
+#include "sessionformat.h"
+
+/**
+ * @class SessionReader
+ * @brief 基于内存映射的录像会话文件读取器
+ *
+ * open()把整个文件映射到内存并校验文件头、摄像头表和索引的范围，
+ * 之后frame()返回的指针直接指向映射区，不经过read()拷贝，在close()之前一直有效。
+ * 打开后只读，可以被多个线程同时使用。
+ */
+class SessionReader
+{
+public:
+    /**
+     * @struct Frame
+     * @brief 映射区中的一帧
+     */
+    struct Frame
+    {
+        const uchar *data = nullptr;    ///< 帧数据首地址（指向映射区）
+        quint32 size = 0;               ///< 帧数据字节数
+        qint64 timeUs = 0;              ///< 采集时间戳（单调时钟，微秒）
+    };
+
+    SessionReader();
+
+    /**
+     * @brief 析构函数，解除映射并关闭文件
+     */
+    ~SessionReader();
+
+    SessionReader(const SessionReader&) = delete;
+    SessionReader& operator=(const SessionReader&) = delete;
+
+    /**
+     * @brief 打开并映射会话文件
+     * @param path 文件路径
+     * @return 是否打开成功，文件不完整或已损坏时返回false
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief 解除映射并关闭文件，之前返回的帧指针全部失效
+     */
+    void close();
+
+    /**
+     * @brief 文件是否已打开
+     * @return 是否已打开
+     */
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief 获取摄像头数量
+     * @return 摄像头数量
+     */
+    int cameraCount() const { return m_header ? static_cast<int>(m_header->cameraCount) : 0; }
+
+    /**
+     * @brief 获取摄像头名称
+     * @param camera 摄像头索引
+     * @return 名称
+     */
+    QString cameraName(int camera) const;
+
+    /**
+     * @brief 获取摄像头的帧数
+     * @param camera 摄像头索引
+     * @return 帧数
+     */
+    int frameCount(int camera) const;
+
+    /**
+     * @brief 获取摄像头帧数据的像素格式
+     * @param camera 摄像头索引
+     * @return FOURCC
+     */
+    quint32 fourcc(int camera) const;
+
+    /**
+     * @brief 获取最早一帧的时间戳
+     * @return 微秒
+     */
+    qint64 startTimeUs() const { return m_header ? m_header->startTimeUs : 0; }
+
+    /**
+     * @brief 获取最晚一帧的时间戳
+     * @return 微秒
+     */
+    qint64 endTimeUs() const { return m_header ? m_header->endTimeUs : 0; }
+
+    /**
+     * @brief 按时间定位，二分查找
+     * @param camera 摄像头索引
+     * @param timeUs 时间戳（与帧时间戳同一时钟）
+     * @return 时间戳不晚于timeUs的最后一帧的序号，timeUs早于第一帧时返回0，没有帧时返回-1
+     */
+    int seek(int camera, qint64 timeUs) const;
+
+    /**
+     * @brief 获取一帧
+     * @param camera 摄像头索引
+     * @param index 帧序号
+     * @return 帧，参数无效时data为nullptr
+     */
+    Frame frame(int camera, int index) const;
+
+private:
+    /**
+     * @brief 获取摄像头的索引数组
+     * @param camera 摄像头索引
+     * @return 索引首地址，参数无效时为nullptr
+     */
+    const SessionIndexEntry* indexOf(int camera) const;
+
+    QFile m_file;                           ///< 会话文件
+    uchar *m_data;                          ///< 映射区首地址
+    qint64 m_size;                          ///< 文件大小
+    const SessionHeader *m_header;          ///< 文件头（指向映射区）
+    const SessionCameraEntry *m_cameras;    ///< 摄像头表（指向映射区）
+};
+
+#endif // SESSIONREADER_H
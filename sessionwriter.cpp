@@ -0,0 +1,210 @@
+/**
+ * @file sessionwriter.cpp
+ * @brief 录像会话文件写入器的实现文件
+ */
+#include "sessionwriter.h"
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+// 写入块大小，文件偏移和每次写入的长度都是它的整数倍（最后一次除外）
+constexpr qint64 kWriteBlockBytes = 64 * 1024;
+
+// 暂存区达到该大小时写出
+constexpr qint64 kStagingBytes = 16 * kWriteBlockBytes;
+
+} // namespace
+
+/**
+ * @brief SessionWriter类的构造函数
+ */
+SessionWriter::SessionWriter()
+    : m_stagingOffset(0)
+    , m_startTimeUs(0)
+    , m_endTimeUs(0)
+    , m_createdMs(0)
+    , m_frameCount(0)
+    , m_failed(false)
+{
+}
+
+/**
+ * @brief SessionWriter类的析构函数
+ */
+SessionWriter::~SessionWriter()
+{
+    if (isOpen()) {
+        finish();
+    }
+}
+
+/**
+ * @brief 创建会话文件并写入文件头
+ * @param path 文件路径
+ * @param cameraNames 各摄像头的名称
+ * @return 是否创建成功
+ *
+ * 文件头的摄像头表偏移先写为0，finish()时回填
+ */
+bool SessionWriter::open(const QString& path, const QStringList& cameraNames)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+        return false;
+
+    m_cameraNames = cameraNames;
+    m_indexes.assign(cameraNames.size(), std::vector<SessionIndexEntry>());
+    m_fourcc.assign(cameraNames.size(), 0);
+    m_startTimeUs = std::numeric_limits<qint64>::max();
+    m_endTimeUs = std::numeric_limits<qint64>::min();
+    m_createdMs = QDateTime::currentMSecsSinceEpoch();
+    m_frameCount = 0;
+    m_failed = false;
+
+    // 文件头放在暂存区开头，与帧数据一起按整块写出
+    SessionHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kSessionMagic, sizeof(header.magic));
+    header.version = kSessionVersion;
+    header.cameraCount = static_cast<quint32>(cameraNames.size());
+    header.createdMs = m_createdMs;
+
+    m_staging.clear();
+    m_staging.reserve(static_cast<int>(kStagingBytes + kWriteBlockBytes));
+    m_staging.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_stagingOffset = 0;
+    return true;
+}
+
+/**
+ * @brief 添加一帧
+ * @param camera 摄像头索引
+ * @param timeUs 采集时间戳
+ * @param data 帧数据
+ * @param fourcc 帧数据的像素格式
+ * @return 是否成功
+ */
+bool SessionWriter::addFrame(int camera, qint64 timeUs, const QByteArray& data, quint32 fourcc)
+{
+    if (!isOpen() || m_failed || camera < 0 || camera >= static_cast<int>(m_indexes.size()) || data.isEmpty())
+        return false;
+
+    SessionIndexEntry entry;
+    entry.timeUs = timeUs;
+    entry.offset = m_stagingOffset + static_cast<quint64>(m_staging.size());
+    entry.size = static_cast<quint32>(data.size());
+    entry.reserved = 0;
+    m_indexes[camera].push_back(entry);
+    m_fourcc[camera] = fourcc;
+    m_startTimeUs = std::min(m_startTimeUs, timeUs);
+    m_endTimeUs = std::max(m_endTimeUs, timeUs);
+    ++m_frameCount;
+
+    m_staging.append(data);
+    if (m_staging.size() >= kStagingBytes) {
+        return flush(false);
+    }
+    return true;
+}
+
+/**
+ * @brief 写出剩余数据、索引和摄像头表，回填文件头后关闭文件
+ * @return 是否成功
+ */
+bool SessionWriter::finish()
+{
+    if (!isOpen())
+        return false;
+
+    if (!m_failed) {
+        // 索引和摄像头表接在帧数据之后，按8字节对齐
+        const qint64 padding = (8 - m_staging.size() % 8) % 8;
+        m_staging.append(QByteArray(static_cast<int>(padding), '\0'));
+
+        std::vector<SessionCameraEntry> table(m_indexes.size());
+        for (std::size_t i = 0; i < m_indexes.size(); ++i) {
+            // 同一摄像头的帧按时间顺序添加，这里只做防御性排序
+            std::vector<SessionIndexEntry>& index = m_indexes[i];
+            std::stable_sort(index.begin(), index.end(),
+                             [](const SessionIndexEntry& a, const SessionIndexEntry& b) { return a.timeUs < b.timeUs; });
+
+            SessionCameraEntry& entry = table[i];
+            std::memset(&entry, 0, sizeof(entry));
+            entry.indexOffset = m_stagingOffset + static_cast<quint64>(m_staging.size());
+            entry.frameCount = static_cast<quint32>(index.size());
+            entry.fourcc = m_fourcc[i];
+            const QByteArray name = m_cameraNames[static_cast<int>(i)].toUtf8().left(sizeof(entry.name) - 1);
+            std::memcpy(entry.name, name.constData(), static_cast<std::size_t>(name.size()));
+
+            m_staging.append(reinterpret_cast<const char*>(index.data()),
+                             static_cast<int>(index.size() * sizeof(SessionIndexEntry)));
+        }
+
+        const quint64 tableOffset = m_stagingOffset + static_cast<quint64>(m_staging.size());
+        m_staging.append(reinterpret_cast<const char*>(table.data()),
+                         static_cast<int>(table.size() * sizeof(SessionCameraEntry)));
+
+        if (flush(true)) {
+            SessionHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, kSessionMagic, sizeof(header.magic));
+            header.version = kSessionVersion;
+            header.cameraCount = static_cast<quint32>(m_indexes.size());
+            header.cameraTableOffset = tableOffset;
+            header.startTimeUs = m_frameCount ? m_startTimeUs : 0;
+            header.endTimeUs = m_frameCount ? m_endTimeUs : 0;
+            header.createdMs = m_createdMs;
+            m_failed = !m_file.seek(0) || !writeRaw(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+    }
+
+    if (m_failed) {
+        std::cerr << "会话文件写入失败: " << m_file.fileName().toStdString() << std::endl;
+    }
+    m_file.close();
+    m_staging.clear();
+    m_indexes.clear();
+    return !m_failed;
+}
+
+/**
+ * @brief 写出暂存区中凑满整块的部分
+ * @param all 是否全部写出
+ * @return 是否成功
+ */
+bool SessionWriter::flush(bool all)
+{
+    if (m_failed)
+        return false;
+
+    const qint64 size = all ? m_staging.size() : m_staging.size() / kWriteBlockBytes * kWriteBlockBytes;
+    if (size == 0)
+        return true;
+    if (!writeRaw(m_staging.constData(), size))
+        return false;
+
+    m_staging.remove(0, static_cast<int>(size));
+    m_stagingOffset += static_cast<quint64>(size);
+    return true;
+}
+
+/**
+ * @brief 直接写入文件
+ * @param data 数据首地址
+ * @param size 字节数
+ * @return 是否成功
+ */
+bool SessionWriter::writeRaw(const char *data, qint64 size)
+{
+    if (m_file.write(data, size) != size) {
+        m_failed = true;
+        return false;
+    }
+    return true;
+}
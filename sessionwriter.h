@@ -0,0 +1,109 @@
+/**
+ * @file sessionwriter.h
+ * @brief 录像会话文件写入器的头文件
+ */
+#ifndef SESSIONWRITER_H
+#define SESSIONWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+#include "sessionformat.h"
+
+/**
+ * @class SessionWriter
+ * @brief 录像会话文件写入器
+ *
+ * 帧数据先拼接到暂存区，凑满后按64KB对齐的整块写出，文件偏移和写入长度都是块大小的整数倍；
+ * 索引保存在内存中，finish()时写到文件末尾并回填文件头。
+ * 同一摄像头的帧必须按时间顺序添加。非线程安全，只在录像线程中使用。
+ */
+class SessionWriter
+{
+public:
+    SessionWriter();
+
+    /**
+     * @brief 析构函数，未结束的文件会先finish()
+     */
+    ~SessionWriter();
+
+    SessionWriter(const SessionWriter&) = delete;
+    SessionWriter& operator=(const SessionWriter&) = delete;
+
+    /**
+     * @brief 创建会话文件并写入文件头
+     * @param path 文件路径
+     * @param cameraNames 各摄像头的名称，数量即摄像头数量
+     * @return 是否创建成功
+     */
+    bool open(const QString& path, const QStringList& cameraNames);
+
+    /**
+     * @brief 添加一帧
+     * @param camera 摄像头索引
+     * @param timeUs 采集时间戳（单调时钟，微秒）
+     * @param data 帧数据
+     * @param fourcc 帧数据的像素格式
+     * @return 是否成功，写入出错后始终返回false
+     */
+    bool addFrame(int camera, qint64 timeUs, const QByteArray& data, quint32 fourcc);
+
+    /**
+     * @brief 写出剩余数据、索引和摄像头表，回填文件头后关闭文件
+     * @return 是否成功
+     */
+    bool finish();
+
+    /**
+     * @brief 文件是否已打开
+     * @return 是否已打开
+     */
+    bool isOpen() const { return m_file.isOpen(); }
+
+    /**
+     * @brief 获取文件路径
+     * @return 文件路径
+     */
+    QString fileName() const { return m_file.fileName(); }
+
+    /**
+     * @brief 获取已添加的帧数
+     * @return 帧数
+     */
+    quint64 frameCount() const { return m_frameCount; }
+
+private:
+    /**
+     * @brief 写出暂存区中凑满整块的部分
+     * @param all 是否连同不足一块的剩余部分一起写出
+     * @return 是否成功
+     */
+    bool flush(bool all);
+
+    /**
+     * @brief 直接写入文件
+     * @param data 数据首地址
+     * @param size 字节数
+     * @return 是否成功
+     */
+    bool writeRaw(const char *data, qint64 size);
+
+    QFile m_file;                                           ///< 会话文件（无缓冲）
+    QByteArray m_staging;                                   ///< 尚未写出的数据
+    quint64 m_stagingOffset;                                ///< 暂存区首字节的文件偏移
+    QStringList m_cameraNames;                              ///< 摄像头名称
+    std::vector<std::vector<SessionIndexEntry>> m_indexes;  ///< 各摄像头的索引
+    std::vector<quint32> m_fourcc;                          ///< 各摄像头的像素格式
+    qint64 m_startTimeUs;                                   ///< 最早一帧的时间戳
+    qint64 m_endTimeUs;                                     ///< 最晚一帧的时间戳
+    qint64 m_createdMs;                                     ///< 文件创建时间
+    quint64 m_frameCount;                                   ///< 已添加的帧数
+    bool m_failed;                                          ///< 是否写入出错
+};
+
+#endif // SESSIONWRITER_H
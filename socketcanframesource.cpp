@@ -0,0 +1,150 @@
+/**
+ * @file socketcanframesource.cpp
+ * @brief SocketCAN帧源的实现文件
+ */
+#include "socketcanframesource.h"
+#include "frametiming.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief 输出系统调用错误
+ * @param interfaceName 接口名
+ * @param what 出错的操作
+ */
+void reportError(const QString& interfaceName, const char *what)
+{
+    std::cerr << interfaceName.toStdString() << " " << what << " 失败: "
+              << std::strerror(errno) << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief SocketCanFrameSource类的构造函数
+ * @param interfaceName 接口名
+ */
+SocketCanFrameSource::SocketCanFrameSource(const QString& interfaceName)
+    : m_interfaceName(interfaceName)
+    , m_fd(-1)
+{
+}
+
+/**
+ * @brief SocketCanFrameSource类的析构函数
+ */
+SocketCanFrameSource::~SocketCanFrameSource()
+{
+    close();
+}
+
+/**
+ * @brief 打开原始CAN套接字并绑定到接口
+ * @return 是否打开成功
+ */
+bool SocketCanFrameSource::open()
+{
+    close();
+
+    m_fd = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if (m_fd < 0) {
+        reportError(m_interfaceName, "socket");
+        return false;
+    }
+
+    ifreq request;
+    std::memset(&request, 0, sizeof(request));
+    std::strncpy(request.ifr_name, m_interfaceName.toLocal8Bit().constData(), IFNAMSIZ - 1);
+    if (::ioctl(m_fd, SIOCGIFINDEX, &request) < 0) {
+        reportError(m_interfaceName, "SIOCGIFINDEX");
+        close();
+        return false;
+    }
+
+    sockaddr_can address;
+    std::memset(&address, 0, sizeof(address));
+    address.can_family = AF_CAN;
+    address.can_ifindex = request.ifr_ifindex;
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        reportError(m_interfaceName, "bind");
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 关闭套接字
+ */
+void SocketCanFrameSource::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+/**
+ * @brief 等待并读取下一帧
+ * @param frame 输出帧
+ * @param timeoutMs 最长等待时间（毫秒）
+ * @return 读取结果
+ *
+ * 套接字为非阻塞模式，接收缓冲区中有积压时不经poll()直接读取
+ */
+CanFrameSource::ReadResult SocketCanFrameSource::read(CanFrame& frame, int timeoutMs)
+{
+    if (m_fd < 0)
+        return ReadResult::Error;
+
+    can_frame raw;
+    ssize_t bytes = ::read(m_fd, &raw, sizeof(raw));
+    if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        pollfd descriptor;
+        descriptor.fd = m_fd;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+
+        const int ready = ::poll(&descriptor, 1, timeoutMs);
+        if (ready == 0)
+            return ReadResult::Timeout;
+        if (ready < 0)
+            return errno == EINTR ? ReadResult::Timeout : ReadResult::Error;
+        if (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            std::cerr << m_interfaceName.toStdString() << " 接口已断开" << std::endl;
+            return ReadResult::Error;
+        }
+        bytes = ::read(m_fd, &raw, sizeof(raw));
+    }
+
+    if (bytes < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return ReadResult::Timeout;
+        reportError(m_interfaceName, "read");
+        return ReadResult::Error;
+    }
+
+    // 错误帧和远程帧不携带信号数据
+    if (bytes != static_cast<ssize_t>(sizeof(raw)) || (raw.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)))
+        return ReadResult::Timeout;
+
+    frame.extended = (raw.can_id & CAN_EFF_FLAG) != 0;
+    frame.id = raw.can_id & (frame.extended ? CAN_EFF_MASK : CAN_SFF_MASK);
+    frame.length = qMin<quint8>(raw.can_dlc, 8);
+    std::memcpy(frame.data, raw.data, sizeof(frame.data));
+    frame.timeUs = monotonicNowUs();
+    return ReadResult::Frame;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file socketcanframesource.h
+ * @brief SocketCAN帧源的头文件（仅Linux）
+ */
+#ifndef SOCKETCANFRAMESOURCE_H
+#define SOCKETCANFRAMESOURCE_H
+
+#include "canframesource.h"
+
+/**
+ * @class SocketCanFrameSource
+ * @brief 从SocketCAN原始套接字读取CAN帧
+ *
+ * 支持真实的CAN接口和用于测试的vcan虚拟接口。CAN FD帧和错误帧被过滤，
+ * 接收时刻为读取时的单调时钟
+ */
+class SocketCanFrameSource : public CanFrameSource
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param interfaceName 接口名，如can0、vcan0
+     */
+    explicit SocketCanFrameSource(const QString& interfaceName);
+
+    /**
+     * @brief 析构函数，关闭套接字
+     */
+    ~SocketCanFrameSource() override;
+
+    bool open() override;
+    void close() override;
+    ReadResult read(CanFrame& frame, int timeoutMs) override;
+    QString location() const override { return QStringLiteral("can:") + m_interfaceName; }
+
+private:
+    QString m_interfaceName;    ///< 接口名
+    int m_fd;                   ///< 套接字描述符，未打开时为-1
+};
+
+#endif // SOCKETCANFRAMESOURCE_H
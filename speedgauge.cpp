@@ -0,0 +1,200 @@
+/**
+ * @file speedgauge.cpp
+ * @brief 车速表控件的实现文件
+ */
+#include "speedgauge.h"
+#include "styles.h"
+
+#include <QPainter>
+#include <QVector>
+#include <QtMath>
+
+#include <cmath>
+
+namespace {
+
+// 刻度数量
+constexpr int kTickCount = 10;
+
+// 控件四周的留白
+constexpr int kMargin = 4;
+
+/**
+ * @brief 计算圆上一点
+ * @param center 圆心
+ * @param radius 半径
+ * @param degrees 角度（Qt约定）
+ * @return 点
+ */
+QPointF pointOnCircle(const QPointF& center, double radius, double degrees)
+{
+    const double radians = qDegreesToRadians(degrees);
+    return QPointF(center.x() + radius * std::cos(radians), center.y() - radius * std::sin(radians));
+}
+
+} // namespace
+
+/**
+ * @brief SpeedGauge类的构造函数
+ * @param parent 父窗口指针
+ */
+SpeedGauge::SpeedGauge(QWidget *parent)
+    : GaugeWidget(parent)
+    , m_radius(1.0)
+    , m_thickness(4.0)
+{
+    m_valueText.setTextFormat(Qt::PlainText);
+    setRange(0, 200);
+    setMinimumHeight(50);
+}
+
+/**
+ * @brief 推荐尺寸
+ * @return 尺寸
+ */
+QSize SpeedGauge::sizeHint() const
+{
+    return QSize(160, 80);
+}
+
+/**
+ * @brief 值对应的角度
+ * @param value 值
+ * @return 角度
+ */
+double SpeedGauge::angleForValue(int value) const
+{
+    return 180.0 - 180.0 * fraction(value);
+}
+
+/**
+ * @brief 按新尺寸计算圆心、半径和数字区域
+ */
+void SpeedGauge::layoutChanged()
+{
+    const QRectF area = QRectF(rect()).adjusted(kMargin, kMargin, -kMargin, -kMargin);
+    const double outer = qMax(2.0, qMin(area.width() / 2.0, area.height()));
+    m_thickness = qMax(3.0, outer / 8.0);
+    m_radius = qMax(1.0, outer - m_thickness / 2.0);
+    m_center = QPointF(area.center().x(), area.bottom());
+
+    m_valueFont = font();
+    m_valueFont.setBold(true);
+    m_valueFont.setPixelSize(qMax(8, static_cast<int>(m_radius * 0.45)));
+
+    const double textWidth = m_radius * 1.2;
+    const double textHeight = m_valueFont.pixelSize() * 1.3;
+    m_textRect = QRectF(m_center.x() - textWidth / 2.0, m_center.y() - m_radius * 0.3 - textHeight,
+                        textWidth, textHeight).toAlignedRect();
+
+    valueChanged();
+}
+
+/**
+ * @brief 值变化时重新排版数字
+ */
+void SpeedGauge::valueChanged()
+{
+    m_valueText.setText(QString::number(value()));
+    m_valueText.prepare(QTransform(), m_valueFont);
+}
+
+/**
+ * @brief 绘制刻度、刻度数字、单位和底色弧带
+ * @param painter 缓存位图的绘制器
+ */
+void SpeedGauge::paintBackground(QPainter& painter)
+{
+    const QRectF arcRect(m_center.x() - m_radius, m_center.y() - m_radius, m_radius * 2.0, m_radius * 2.0);
+    painter.setPen(QPen(GAUGE_TRACK_COLOR, m_thickness, Qt::SolidLine, Qt::FlatCap));
+    painter.drawArc(arcRect, 0, 180 * 16);
+
+    // 刻度线在弧带内侧
+    const double tickOuter = m_radius - m_thickness / 2.0 - 1.0;
+    const double tickInner = tickOuter - m_thickness * 0.6;
+    painter.setPen(QPen(TEXT_COLOR, 1.0));
+    for (int i = 0; i <= kTickCount; ++i) {
+        const double degrees = 180.0 - 180.0 * i / kTickCount;
+        painter.drawLine(pointOnCircle(m_center, tickOuter, degrees), pointOnCircle(m_center, tickInner, degrees));
+    }
+
+    // 两端和中间的刻度数字
+    QFont labelFont = font();
+    labelFont.setPixelSize(qMax(7, static_cast<int>(m_thickness * 1.1)));
+    painter.setFont(labelFont);
+    const double labelRadius = tickInner - labelFont.pixelSize();
+    const int labels[] = {minimum(), (minimum() + maximum()) / 2, maximum()};
+    for (int label : labels) {
+        QStaticText text(QString::number(label));
+        text.prepare(QTransform(), labelFont);
+        const QPointF anchor = pointOnCircle(m_center, labelRadius, angleForValue(label));
+        painter.drawStaticText(QPointF(anchor.x() - text.size().width() / 2.0,
+                                       qMin(anchor.y(), m_center.y()) - text.size().height() / 2.0), text);
+    }
+
+    QStaticText unit("km/h");
+    unit.prepare(QTransform(), labelFont);
+    painter.drawStaticText(QPointF(m_center.x() - unit.size().width() / 2.0,
+                                   m_center.y() - unit.size().height()), unit);
+}
+
+/**
+ * @brief 绘制指示弧和数字
+ * @param painter 控件的绘制器
+ */
+void SpeedGauge::paintValue(QPainter& painter)
+{
+    const double span = angleForValue(value()) - 180.0;
+    if (span < 0.0) {
+        const QRectF arcRect(m_center.x() - m_radius, m_center.y() - m_radius, m_radius * 2.0, m_radius * 2.0);
+        painter.setPen(QPen(GAUGE_VALUE_COLOR, m_thickness, Qt::SolidLine, Qt::FlatCap));
+        painter.drawArc(arcRect, 180 * 16, qRound(span * 16.0));
+    }
+
+    const QSizeF size = m_valueText.size();
+    painter.setPen(TEXT_COLOR);
+    painter.setFont(m_valueFont);
+    painter.drawStaticText(QPointF(m_textRect.center().x() - size.width() / 2.0,
+                                   m_textRect.center().y() - size.height() / 2.0), m_valueText);
+}
+
+/**
+ * @brief 计算值变化时需要重绘的区域
+ * @param oldValue 旧值
+ * @param newValue 新值
+ * @return 新旧角度之间弧带的包围盒加上数字区域
+ */
+QRegion SpeedGauge::changedRegion(int oldValue, int newValue) const
+{
+    QRegion region(m_textRect);
+    region += arcBounds(angleForValue(oldValue), angleForValue(newValue));
+    return region;
+}
+
+/**
+ * @brief 计算两个角度之间的弧带的包围盒
+ * @param fromDegrees 起始角度
+ * @param toDegrees 结束角度
+ * @return 包围盒
+ *
+ * 弧带的极值点只可能在两端或经过正上方（90度）时出现
+ */
+QRect SpeedGauge::arcBounds(double fromDegrees, double toDegrees) const
+{
+    const double low = qMin(fromDegrees, toDegrees);
+    const double high = qMax(fromDegrees, toDegrees);
+    QVector<double> angles = {low, high};
+    if (low < 90.0 && high > 90.0) {
+        angles.append(90.0);
+    }
+
+    QRectF bounds;
+    for (double degrees : angles) {
+        for (double radius : {m_radius - m_thickness / 2.0, m_radius + m_thickness / 2.0}) {
+            const QPointF point = pointOnCircle(m_center, radius, degrees);
+            bounds |= QRectF(point, QSizeF(0.001, 0.001));
+        }
+    }
+    // 抗锯齿边缘
+    return bounds.toAlignedRect().adjusted(-2, -2, 2, 2);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file speedgauge.h
+ * @brief 车速表控件的头文件
+ */
+#ifndef SPEEDGAUGE_H
+#define SPEEDGAUGE_H
+
+#include <QRectF>
+#include <QStaticText>
+
+#include "gaugewidget.h"
+
+/**
+ * @class SpeedGauge
+ * @brief 半圆形车速表
+ *
+ * 刻度、刻度数字和单位缓存在底图中；值变化时只重绘新旧指示弧之间的扇区包围盒和中央的数字。
+ * 数字使用QStaticText，只在整数车速变化时重新排版一次
+ */
+class SpeedGauge : public GaugeWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父窗口指针，默认为nullptr
+     */
+    explicit SpeedGauge(QWidget *parent = nullptr);
+
+    /**
+     * @brief 推荐尺寸
+     * @return 尺寸
+     */
+    QSize sizeHint() const override;
+
+protected:
+    void paintBackground(QPainter& painter) override;
+    void paintValue(QPainter& painter) override;
+    QRegion changedRegion(int oldValue, int newValue) const override;
+    void valueChanged() override;
+    void layoutChanged() override;
+
+private:
+    /**
+     * @brief 值对应的角度
+     * @param value 值
+     * @return 角度（度，Qt约定：3点钟方向为0，逆时针为正），最小值为180，最大值为0
+     */
+    double angleForValue(int value) const;
+
+    /**
+     * @brief 计算两个角度之间的弧带的包围盒
+     * @param fromDegrees 起始角度
+     * @param toDegrees 结束角度
+     * @return 包围盒（控件坐标）
+     */
+    QRect arcBounds(double fromDegrees, double toDegrees) const;
+
+    QPointF m_center;           ///< 圆心
+    double m_radius;            ///< 弧带中心线的半径
+    double m_thickness;         ///< 弧带宽度
+    QRect m_textRect;           ///< 数字区域
+    QFont m_valueFont;          ///< 数字字体
+    QStaticText m_valueText;    ///< 当前数字
+};
+
+#endif // SPEEDGAUGE_H
@@ -0,0 +1,127 @@
+/**
+ * @file stageprofiler.cpp
+ * @brief 帧处理各阶段CPU时间统计的实现文件
+ */
+#include "stageprofiler.h"
+
+#include <atomic>
+#include <chrono>
+
+#ifdef Q_OS_UNIX
+#include <ctime>
+#endif
+
+namespace {
+
+constexpr int kStageCount = static_cast<int>(StageProfiler::Stage::Count);
+
+// 计数只用于统计，使用relaxed顺序即可
+std::atomic<bool> g_enabled{false};
+std::atomic<qint64> g_cpuUs[kStageCount];
+std::atomic<quint64> g_calls[kStageCount];
+
+} // namespace
+
+/**
+ * @brief Scope类的构造函数
+ * @param stage 阶段
+ */
+StageProfiler::Scope::Scope(Stage stage)
+    : m_stage(stage)
+    , m_startUs(g_enabled.load(std::memory_order_relaxed) ? threadCpuTimeUs() : -1)
+{
+}
+
+/**
+ * @brief Scope类的析构函数
+ */
+StageProfiler::Scope::~Scope()
+{
+    if (m_startUs >= 0) {
+        add(m_stage, threadCpuTimeUs() - m_startUs);
+    }
+}
+
+/**
+ * @brief 启用或关闭统计
+ * @param enabled 是否启用
+ */
+void StageProfiler::setEnabled(bool enabled)
+{
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 统计是否启用
+ * @return 是否启用
+ */
+bool StageProfiler::isEnabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 获取当前线程已消耗的CPU时间
+ * @return 微秒
+ */
+qint64 StageProfiler::threadCpuTimeUs()
+{
+#ifdef Q_OS_UNIX
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 累计一个阶段的CPU时间
+ * @param stage 阶段
+ * @param cpuUs CPU时间（微秒）
+ */
+void StageProfiler::add(Stage stage, qint64 cpuUs)
+{
+    const int index = static_cast<int>(stage);
+    g_cpuUs[index].fetch_add(cpuUs, std::memory_order_relaxed);
+    g_calls[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 获取当前统计
+ * @return 统计快照
+ */
+StageProfiler::Snapshot StageProfiler::snapshot()
+{
+    Snapshot result;
+    for (int i = 0; i < kStageCount; ++i) {
+        result.cpuUs[i] = g_cpuUs[i].load(std::memory_order_relaxed);
+        result.calls[i] = g_calls[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+/**
+ * @brief 获取阶段名称
+ * @param stage 阶段
+ * @return 名称字符串
+ */
+const char* StageProfiler::stageName(Stage stage)
+{
+    switch (stage) {
+    case Stage::Capture:
+        return "capture";
+    case Stage::Decode:
+        return "decode";
+    case Stage::Scale:
+        return "scale";
+    case Stage::Present:
+        return "present";
+    case Stage::Paint:
+        return "paint";
+    case Stage::Count:
+        break;
+    }
+    return "unknown";
+}
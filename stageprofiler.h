@@ -0,0 +1,109 @@
+/**
+ * @file stageprofiler.h
+ * @brief 帧处理各阶段CPU时间统计的头文件
+ *
+ * 该文件定义了StageProfiler类，按阶段累计采集、解码、缩放、取帧和绘制
+ * 实际消耗的线程CPU时间，阻塞等待的时间不计入，用于无界面运行时的性能报告。
+ */
+#ifndef STAGEPROFILER_H
+#define STAGEPROFILER_H
+
+#include <QtGlobal>
+
+/**
+ * @class StageProfiler
+ * @brief 全局的分阶段CPU时间统计
+ *
+ * 所有接口均为静态且线程安全。默认关闭，关闭时Scope只读取一个原子变量
+ */
+class StageProfiler
+{
+public:
+    /**
+     * @brief 帧处理阶段
+     */
+    enum class Stage {
+        Capture,    ///< 采集线程取帧（含合成画面生成和录像解码）
+        Decode,     ///< 线程池中的MJPEG/YUYV解码
+        Scale,      ///< 线程池中的颜色转换和缩放
+        Present,    ///< 界面线程从信箱取帧并交给控件
+        Paint,      ///< 界面线程绘制画面
+        Count       ///< 阶段数量
+    };
+
+    /**
+     * @struct Snapshot
+     * @brief 统计快照
+     */
+    struct Snapshot
+    {
+        qint64 cpuUs[static_cast<int>(Stage::Count)] = {};     ///< 各阶段累计CPU时间（微秒）
+        quint64 calls[static_cast<int>(Stage::Count)] = {};    ///< 各阶段执行次数
+    };
+
+    /**
+     * @class Scope
+     * @brief 统计所在作用域消耗的线程CPU时间
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief 构造函数，记录起始CPU时间
+         * @param stage 阶段
+         */
+        explicit Scope(Stage stage);
+
+        /**
+         * @brief 析构函数，累计本作用域的CPU时间
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Stage m_stage;          ///< 阶段
+        qint64 m_startUs;       ///< 起始CPU时间，未启用时为-1
+    };
+
+    /**
+     * @brief 启用或关闭统计
+     * @param enabled 是否启用
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief 统计是否启用
+     * @return 是否启用
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief 获取当前线程已消耗的CPU时间
+     * @return 微秒，不支持线程CPU时钟的平台返回单调时钟时间
+     */
+    static qint64 threadCpuTimeUs();
+
+    /**
+     * @brief 累计一个阶段的CPU时间
+     * @param stage 阶段
+     * @param cpuUs CPU时间（微秒）
+     */
+    static void add(Stage stage, qint64 cpuUs);
+
+    /**
+     * @brief 获取当前统计
+     * @return 统计快照
+     */
+    static Snapshot snapshot();
+
+    /**
+     * @brief 获取阶段名称
+     * @param stage 阶段
+     * @return 名称字符串
+     */
+    static const char* stageName(Stage stage);
+};
+
+#endif // STAGEPROFILER_H
@@ -0,0 +1,130 @@
+/**
+ * @file startuptimeline.cpp
+ * @brief 启动时间线记录器的实现文件
+ */
+#include "startuptimeline.h"
+#include "frametiming.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QVector>
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef Q_OS_LINUX
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<qint64> g_processStartUs{0};        ///< 进程启动时刻（单调时钟，微秒）
+QMutex g_eventMutex;                            ///< 保护事件列表
+QVector<QPair<QString, qint64>> g_events;       ///< 已记录的事件及其时间
+
+/**
+ * @brief 计算进程已经运行了多久
+ * @return 微秒，无法获取时返回0
+ */
+qint64 processAgeUs()
+{
+#ifdef Q_OS_LINUX
+    // 第22个字段starttime是进程启动时相对开机的时钟滴答数
+    std::ifstream file("/proc/self/stat");
+    std::string content;
+    if (!std::getline(file, content))
+        return 0;
+
+    // 第2个字段comm可能含空格，从最后一个')'之后开始解析（第3个字段起）
+    const std::string::size_type end = content.rfind(')');
+    if (end == std::string::npos)
+        return 0;
+
+    std::istringstream fields(content.substr(end + 2));
+    std::string field;
+    unsigned long long startTicks = 0;
+    for (int i = 3; i <= 22 && fields >> field; ++i) {
+        if (i == 22)
+            startTicks = std::stoull(field);
+    }
+
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    timespec now;
+    if (startTicks == 0 || ticksPerSecond <= 0 || clock_gettime(CLOCK_BOOTTIME, &now) != 0)
+        return 0;
+
+    const qint64 nowUs = static_cast<qint64>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+    const qint64 startUs = static_cast<qint64>(startTicks * 1000000ULL / static_cast<unsigned long long>(ticksPerSecond));
+    return qMax<qint64>(0, nowUs - startUs);
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief 记录进程启动时刻
+ */
+void StartupTimeline::markProcessStart()
+{
+    const qint64 nowUs = monotonicNowUs();
+    const qint64 ageUs = processAgeUs();
+    g_processStartUs.store(nowUs - ageUs, std::memory_order_relaxed);
+    mark("进入main");
+}
+
+/**
+ * @brief 记录一个启动事件
+ * @param event 事件名称
+ * @return 是否首次记录该事件
+ */
+bool StartupTimeline::mark(const QString& event)
+{
+    const qint64 timeUs = elapsedUs();
+
+    QMutexLocker locker(&g_eventMutex);
+    for (const QPair<QString, qint64>& existing : g_events) {
+        if (existing.first == event)
+            return false;
+    }
+    g_events.append(qMakePair(event, timeUs));
+    return true;
+}
+
+/**
+ * @brief 获取从进程启动到现在的时间
+ * @return 微秒
+ */
+qint64 StartupTimeline::elapsedUs()
+{
+    return monotonicNowUs() - g_processStartUs.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 生成启动报告
+ * @return 报告文本
+ */
+QString StartupTimeline::report()
+{
+    QVector<QPair<QString, qint64>> events;
+    {
+        QMutexLocker locker(&g_eventMutex);
+        events = g_events;
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const QPair<QString, qint64>& a, const QPair<QString, qint64>& b) {
+                         return a.second < b.second;
+                     });
+
+    QString text;
+    for (const QPair<QString, qint64>& event : events) {
+        text += QString("%1 ms  %2\n").arg(event.second / 1000.0, 8, 'f', 1).arg(event.first);
+    }
+    return text;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file startuptimeline.h
+ * @brief 启动时间线记录器的头文件
+ *
+ * 该文件定义了StartupTimeline类，记录从进程启动到窗口显示、
+ * 各摄像头设备打开和首帧显示的时间，用于验证点火到出画面的时间要求。
+ */
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @class StartupTimeline
+ * @brief 全局的启动时间线
+ *
+ * 所有接口均为静态且线程安全。同名事件只记录第一次，
+ * 时间以进程启动为零点，单位为微秒。
+ */
+class StartupTimeline
+{
+public:
+    /**
+     * @brief 记录进程启动时刻，应在main()的第一行调用
+     *
+     * Linux下从/proc/self/stat读取内核记录的进程启动时间，
+     * 因此动态库加载等main()之前的耗时也计算在内
+     */
+    static void markProcessStart();
+
+    /**
+     * @brief 记录一个启动事件
+     * @param event 事件名称
+     * @return 是否首次记录该事件
+     */
+    static bool mark(const QString& event);
+
+    /**
+     * @brief 获取从进程启动到现在的时间
+     * @return 微秒
+     */
+    static qint64 elapsedUs();
+
+    /**
+     * @brief 生成按时间排序的启动报告
+     * @return 报告文本，每行一个事件
+     */
+    static QString report();
+};
+
+#endif // STARTUPTIMELINE_H
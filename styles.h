@@ -1,8 +1,34 @@
 #ifndef STYLES_H
 #define STYLES_H
 
+#include <QColor>
+#include <QPalette>
 #include <QString>
 
+// 文字颜色不写在样式表中，而是通过调色板设置：切换状态颜色时只替换调色板，
+// 不会触发样式表的重新解析和控件的重新polish
+const QColor TEXT_COLOR(0xec, 0xf0, 0xf1);              ///< 普通文字
+const QColor STATUS_OK_COLOR(0x2e, 0xcc, 0x71);         ///< 正常状态
+const QColor STATUS_WARNING_COLOR(0xf3, 0x9c, 0x12);    ///< 注意状态
+const QColor STATUS_DANGER_COLOR(0xe7, 0x4c, 0x3c);     ///< 警告状态
+
+// 自绘仪表（GaugeWidget）不经过样式表，颜色与DATA_PANEL_STYLE保持一致
+const QColor PANEL_COLOR(0x2c, 0x3e, 0x50);             ///< 面板底色
+const QColor GAUGE_TRACK_COLOR(0x34, 0x49, 0x5e);       ///< 仪表未点亮部分
+const QColor GAUGE_VALUE_COLOR(0x34, 0x98, 0xdb);       ///< 仪表指示部分
+
+/**
+ * @brief 创建只指定文字颜色的调色板，其余颜色从父控件继承
+ * @param color 文字颜色
+ * @return 调色板
+ */
+inline QPalette textPalette(const QColor& color)
+{
+    QPalette palette;
+    palette.setColor(QPalette::WindowText, color);
+    return palette;
+}
+
 // 主样式
 const QString MAIN_STYLE = R"(
 QMainWindow {
@@ -16,7 +42,6 @@ QFrame {
 }
 
 QLabel {
-    color: #ecf0f1;
     font-size: 12px;
 }
 
@@ -80,7 +105,6 @@ QFrame#statusPanel {
 }
 
 QLabel {
-    color: #ecf0f1;
     font-size: 11px;
 }
 
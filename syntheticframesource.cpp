@@ -0,0 +1,368 @@
+/**
+ * @file syntheticframesource.cpp
+ * @brief 合成测试画面帧源的实现文件
+ */
+#include "syntheticframesource.h"
+#include "frametiming.h"
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QPainter>
+#include <QPen>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// 图案按640x480设计，按比例缩放到实际分辨率
+constexpr double kDesignWidth = 640.0;
+constexpr double kDesignHeight = 480.0;
+constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * @brief 把RGB888格式的QImage转换为BGR的Mat
+ * @param image QImage
+ * @return 独立持有数据的Mat
+ */
+cv::Mat bgrFromImage(const QImage& image)
+{
+    const cv::Mat view(image.height(), image.width(), CV_8UC3,
+                       const_cast<uchar*>(image.constBits()), static_cast<size_t>(image.bytesPerLine()));
+    cv::Mat bgr;
+    cv::cvtColor(view, bgr, cv::COLOR_RGB2BGR);
+    return bgr;
+}
+
+/**
+ * @brief 创建绘制静态背景用的画布
+ * @param width 宽度
+ * @param height 高度
+ * @return 填充了深灰色的画布
+ */
+QImage createCanvas(int width, int height)
+{
+    QImage canvas(width, height, QImage::Format_RGB888);
+    canvas.fill(QColor(30, 30, 30));
+    return canvas;
+}
+
+/**
+ * @brief 在画布中央绘制说明文字
+ * @param canvas 画布
+ * @param text 文字
+ * @param scale 相对设计尺寸的缩放比例
+ */
+void drawCaption(QImage& canvas, const QString& text, double scale)
+{
+    QPainter painter(&canvas);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    QFont font("Arial");
+    font.setPixelSize(qMax(8, qRound(27 * scale)));
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    painter.drawText(canvas.rect(), Qt::AlignCenter, text);
+}
+
+} // namespace
+
+/**
+ * @brief SyntheticFrameSource类的构造函数
+ * @param location 位置
+ * @param config 采集参数
+ */
+SyntheticFrameSource::SyntheticFrameSource(const QString& location, const FrameSourceConfig& config)
+    : m_location(location)
+    , m_config(config)
+    , m_pattern(Pattern::Bars)
+    , m_open(false)
+    , m_frameIndex(0)
+    , m_frameIntervalUs(0)
+    , m_nextFrameTimeUs(0)
+{
+    const QString name = location.section(':', 1).trimmed().toLower();
+    if (name == "vehicle") {
+        m_pattern = Pattern::Vehicle;
+    } else if (name == "driver") {
+        m_pattern = Pattern::Driver;
+    } else if (name == "road") {
+        m_pattern = Pattern::Road;
+    }
+}
+
+/**
+ * @brief 判断位置是否表示合成帧源
+ * @param location 位置
+ * @return 是否为合成帧源
+ */
+bool SyntheticFrameSource::isSyntheticLocation(const QString& location)
+{
+    return location.startsWith("synthetic:");
+}
+
+/**
+ * @brief 打开帧源，预先绘制所有图层
+ * @return 是否打开成功
+ */
+bool SyntheticFrameSource::open()
+{
+    if (m_config.width <= 0 || m_config.height <= 0)
+        return false;
+
+    buildLayers();
+    m_frameIndex = 0;
+    m_frameIntervalUs = 1000000 / qMax(1, m_config.fps);
+    m_nextFrameTimeUs = monotonicNowUs();
+    m_open = true;
+    return true;
+}
+
+/**
+ * @brief 关闭帧源，释放图层
+ */
+void SyntheticFrameSource::close()
+{
+    m_background.release();
+    m_sprites.clear();
+    m_open = false;
+}
+
+/**
+ * @brief 按节奏生成下一帧
+ * @param frame 输出帧
+ * @param timeoutMs 最长等待时间（毫秒）
+ * @return 取帧结果
+ */
+FrameSource::GrabResult SyntheticFrameSource::grab(CameraFrame& frame, int timeoutMs)
+{
+    if (!m_open)
+        return GrabResult::Error;
+
+    const qint64 waitUs = m_nextFrameTimeUs - monotonicNowUs();
+    if (waitUs > static_cast<qint64>(timeoutMs) * 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+        return GrabResult::Timeout;
+    }
+    if (waitUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+    }
+
+    renderFrame(frame.image);
+    ++m_frameIndex;
+
+    const qint64 now = monotonicNowUs();
+    // 落后太多时重新对齐节奏，而不是连续追帧
+    m_nextFrameTimeUs = qMax(m_nextFrameTimeUs + m_frameIntervalUs, now - m_frameIntervalUs);
+
+    frame.releaseRaw();
+    frame.deviceTimestampUs = now;
+    return GrabResult::Frame;
+}
+
+/**
+ * @brief 绘制背景和图层
+ *
+ * 使用QPainter在采集线程中绘制QImage，完成后转换为BGR的Mat，之后每帧不再绘制文字和轮廓
+ */
+void SyntheticFrameSource::buildLayers()
+{
+    const int width = m_config.width;
+    const int height = m_config.height;
+    const double scale = qMin(width / kDesignWidth, height / kDesignHeight);
+    const qreal penWidth = qMax(1.0, 2.0 * scale);
+
+    m_sprites.clear();
+
+    // 图层在透明画布上绘制，再拆分为BGR图像和alpha掩码
+    auto makeSprite = [&](double designWidth, double designHeight, const std::function<void(QPainter&)>& draw) {
+        QImage canvas(qMax(1, qRound(designWidth * scale)), qMax(1, qRound(designHeight * scale)),
+                      QImage::Format_ARGB32);
+        canvas.fill(Qt::transparent);
+        {
+            QPainter painter(&canvas);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.scale(scale, scale);
+            draw(painter);
+        }
+        // Format_ARGB32在小端机器上的字节顺序为B、G、R、A
+        const cv::Mat bgra(canvas.height(), canvas.width(), CV_8UC4,
+                           canvas.bits(), static_cast<size_t>(canvas.bytesPerLine()));
+        Sprite sprite;
+        cv::cvtColor(bgra, sprite.image, cv::COLOR_BGRA2BGR);
+        cv::extractChannel(bgra, sprite.mask, 3);
+        m_sprites.append(sprite);
+    };
+
+    switch (m_pattern) {
+    case Pattern::Vehicle: {
+        QImage canvas = createCanvas(width, height);
+        drawCaption(canvas, "车辆检测\n(模拟数据)", scale);
+        m_background = bgrFromImage(canvas);
+
+        // 车辆轮廓，原点对应设计坐标(218, 228)
+        makeSprite(204, 196, [&](QPainter& painter) {
+            painter.setPen(QPen(Qt::red, penWidth / scale));
+            painter.translate(-218, -228);
+            painter.drawRect(220, 280, 200, 100);
+            painter.drawRect(250, 230, 140, 50);
+            painter.drawEllipse(250, 380, 40, 40); // 左前轮
+            painter.drawEllipse(350, 380, 40, 40); // 右前轮
+        });
+        break;
+    }
+    case Pattern::Driver: {
+        QImage canvas = createCanvas(width, height);
+        drawCaption(canvas, "驾驶员监测\n(模拟数据)", scale);
+        m_background = bgrFromImage(canvas);
+
+        // 人脸轮廓，第一个图层睁眼，第二个图层闭眼，原点对应设计坐标(216, 116)
+        for (int closed = 0; closed < 2; ++closed) {
+            makeSprite(208, 248, [&](QPainter& painter) {
+                painter.setPen(QPen(Qt::green, penWidth / scale));
+                painter.translate(-216, -116);
+                painter.drawEllipse(QPoint(320, 240), 100, 120);
+                if (closed) {
+                    painter.drawLine(260, 210, 300, 210); // 左眼
+                    painter.drawLine(340, 210, 380, 210); // 右眼
+                } else {
+                    painter.drawEllipse(QPoint(280, 210), 20, 20); // 左眼
+                    painter.drawEllipse(QPoint(360, 210), 20, 20); // 右眼
+                }
+                painter.drawArc(270, 260, 100, 50, 0, 180 * 16); // 微笑
+            });
+        }
+        break;
+    }
+    case Pattern::Road: {
+        // 地平线在设计坐标y=240处，上方为天空，下方为路面；车道线每帧按透视绘制，没有图层
+        QImage canvas = createCanvas(width, height);
+        {
+            const int horizon = qRound(height / 2.0);
+            QPainter painter(&canvas);
+            painter.fillRect(0, 0, width, horizon, QColor(70, 90, 120));
+            painter.fillRect(0, horizon, width, height - horizon, QColor(70, 70, 70));
+        }
+        drawCaption(canvas, "车道线检测\n(模拟数据)", scale);
+        m_background = bgrFromImage(canvas);
+        break;
+    }
+    case Pattern::Bars: {
+        // 75%亮度彩条：白、黄、青、绿、品红、红、蓝
+        static const QColor colors[] = {
+            QColor(191, 191, 191), QColor(191, 191, 0), QColor(0, 191, 191), QColor(0, 191, 0),
+            QColor(191, 0, 191), QColor(191, 0, 0), QColor(0, 0, 191)
+        };
+        constexpr int barCount = sizeof(colors) / sizeof(colors[0]);
+
+        QImage canvas = createCanvas(width, height);
+        {
+            QPainter painter(&canvas);
+            for (int i = 0; i < barCount; ++i) {
+                const int x0 = width * i / barCount;
+                const int x1 = width * (i + 1) / barCount;
+                painter.fillRect(x0, 0, x1 - x0, height * 3 / 4, colors[i]);
+            }
+        }
+        drawCaption(canvas, QString("合成测试画面\n%1x%2 @ %3fps").arg(width).arg(height).arg(m_config.fps), scale);
+        m_background = bgrFromImage(canvas);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief 生成一帧画面
+ * @param out 输出图像
+ *
+ * 每帧只做一次背景拷贝加少量图层贴图，动画由帧序号决定，与实际耗时无关
+ */
+void SyntheticFrameSource::renderFrame(cv::Mat& out)
+{
+    m_background.copyTo(out);
+
+    const double t = static_cast<double>(m_frameIndex) / qMax(1, m_config.fps);
+    const int width = out.cols;
+    const int height = out.rows;
+    const double scale = qMin(width / kDesignWidth, height / kDesignHeight);
+    // 设计坐标到实际坐标的映射，以画面中心为基准
+    auto mapX = [&](double x) { return qRound(width / 2.0 + (x - kDesignWidth / 2) * scale); };
+    auto mapY = [&](double y) { return qRound(height / 2.0 + (y - kDesignHeight / 2) * scale); };
+
+    switch (m_pattern) {
+    case Pattern::Vehicle: {
+        // 车辆左右缓慢移动，周期4秒
+        const double offset = 60.0 * std::sin(2.0 * kPi * t / 4.0);
+        blit(m_sprites[0], out, mapX(218 + offset), mapY(228));
+        break;
+    }
+    case Pattern::Driver: {
+        // 每3秒眨眼一次，头部轻微摆动
+        const bool blink = std::fmod(t, 3.0) < 0.15;
+        const double sway = 10.0 * std::sin(2.0 * kPi * t / 5.0);
+        blit(m_sprites[blink ? 1 : 0], out, mapX(216 + sway), mapY(116));
+        break;
+    }
+    case Pattern::Road: {
+        // 消失点在设计坐标(320, 240)，s为到地平线的相对距离（1为画面底部），纵向距离与1/s成正比；
+        // 车辆在车道内左右摆动，周期6秒，右侧虚线以固定车速向后移动
+        const double sway = 40.0 * std::sin(2.0 * kPi * t / 6.0);
+        auto drawStripe = [&](double bottomX, double s0, double s1, const cv::Scalar& color) {
+            auto edge = [&](double s, double side) {
+                const double x = 320.0 + (bottomX - sway - 320.0) * s + side * 6.0 * s;
+                return cv::Point(mapX(x), mapY(240.0 + 240.0 * s));
+            };
+            const cv::Point stripe[] = {edge(s0, -1), edge(s0, 1), edge(s1, 1), edge(s1, -1)};
+            cv::fillConvexPoly(out, stripe, 4, color, cv::LINE_AA);
+        };
+
+        drawStripe(120.0, 0.1, 1.0, cv::Scalar(0, 200, 255));  // 左侧黄色实线
+
+        constexpr double dashPeriod = 2.0;
+        constexpr double dashLength = 1.0;
+        const double travelled = std::fmod(t * 4.0, dashPeriod);
+        for (double z = 1.0 - travelled; z < 10.0; z += dashPeriod) {
+            const double nearZ = qMax(1.0, z);
+            const double farZ = z + dashLength;
+            if (farZ > nearZ) {
+                drawStripe(520.0, 1.0 / farZ, 1.0 / nearZ, cv::Scalar(255, 255, 255));  // 右侧白色虚线
+            }
+        }
+        break;
+    }
+    case Pattern::Bars: {
+        // 白色光带每2秒扫过一次，便于肉眼判断是否掉帧
+        const int bandWidth = qMax(2, width / 40);
+        const int x = static_cast<int>(std::fmod(t / 2.0, 1.0) * (width + bandWidth)) - bandWidth;
+        const cv::Rect band = cv::Rect(x, 0, bandWidth, height) & cv::Rect(0, 0, width, height);
+        if (band.area() > 0) {
+            out(band).setTo(cv::Scalar(255, 255, 255));
+        }
+        cv::putText(out, cv::format("#%llu", static_cast<unsigned long long>(m_frameIndex)),
+                    cv::Point(qRound(10 * scale), height - qRound(20 * scale)),
+                    cv::FONT_HERSHEY_SIMPLEX, scale, cv::Scalar(255, 255, 255), qMax(1, qRound(2 * scale)));
+        break;
+    }
+    }
+}
+
+/**
+ * @brief 把图层贴到画面上
+ * @param sprite 图层
+ * @param out 画面
+ * @param x 图层左上角横坐标
+ * @param y 图层左上角纵坐标
+ */
+void SyntheticFrameSource::blit(const Sprite& sprite, cv::Mat& out, int x, int y)
+{
+    const cv::Rect target = cv::Rect(x, y, sprite.image.cols, sprite.image.rows) & cv::Rect(0, 0, out.cols, out.rows);
+    if (target.area() <= 0)
+        return;
+
+    const cv::Rect source(target.x - x, target.y - y, target.width, target.height);
+    sprite.image(source).copyTo(out(target), sprite.mask(source));
+}
@@ -0,0 +1,99 @@
+/**
+ * @file syntheticframesource.h
+ * @brief 合成测试画面帧源的头文件
+ *
+ * 该文件定义了SyntheticFrameSource类，在采集线程中按配置的分辨率和帧率
+ * 生成动画测试画面，用于演示和在没有摄像头的机器上做多路压力测试。
+ */
+#ifndef SYNTHETICFRAMESOURCE_H
+#define SYNTHETICFRAMESOURCE_H
+
+#include <QVector>
+
+#include "framesource.h"
+
+/**
+ * @class SyntheticFrameSource
+ * @brief 合成测试画面帧源
+ *
+ * 位置写作"synthetic:<图案>"，图案可选bars（彩条，默认）、vehicle（车辆检测）、
+ * driver（驾驶员监测）、road（车道线检测）。背景和文字、轮廓等图层只在open()时用QPainter绘制一次，
+ * 每帧只拷贝背景并贴上移动的图层，界面线程不做任何绘制
+ */
+class SyntheticFrameSource : public FrameSource
+{
+public:
+    /**
+     * @brief 测试图案
+     */
+    enum class Pattern {
+        Bars,       ///< 彩条加移动光带和帧计数，用于压力测试
+        Vehicle,    ///< 车辆检测演示画面
+        Driver,     ///< 驾驶员监测演示画面
+        Road        ///< 车道线检测演示画面
+    };
+
+    /**
+     * @brief 构造函数
+     * @param location 位置，如"synthetic:vehicle"
+     * @param config 采集参数，使用width、height和fps字段
+     */
+    SyntheticFrameSource(const QString& location, const FrameSourceConfig& config);
+
+    /**
+     * @brief 判断位置是否表示合成帧源
+     * @param location 位置
+     * @return 是否以"synthetic:"开头
+     */
+    static bool isSyntheticLocation(const QString& location);
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_open; }
+    bool isPresent() const override { return true; }
+    GrabResult grab(CameraFrame& frame, int timeoutMs) override;
+    QString location() const override { return m_location; }
+
+private:
+    /**
+     * @struct Sprite
+     * @brief 预先绘制好的图层及其不透明区域
+     */
+    struct Sprite
+    {
+        cv::Mat image;  ///< BGR图像
+        cv::Mat mask;   ///< 不透明区域掩码
+    };
+
+    /**
+     * @brief 绘制背景和图层，只在open()时调用
+     */
+    void buildLayers();
+
+    /**
+     * @brief 生成一帧画面
+     * @param out 输出图像，尺寸一致时复用其缓冲区
+     */
+    void renderFrame(cv::Mat& out);
+
+    /**
+     * @brief 把图层贴到画面上，超出画面的部分被裁掉
+     * @param sprite 图层
+     * @param out 画面
+     * @param x 图层左上角横坐标
+     * @param y 图层左上角纵坐标
+     */
+    static void blit(const Sprite& sprite, cv::Mat& out, int x, int y);
+
+    QString m_location;             ///< 位置
+    FrameSourceConfig m_config;     ///< 采集参数
+    Pattern m_pattern;              ///< 测试图案
+    bool m_open;                    ///< 是否已打开
+    cv::Mat m_background;           ///< 静态背景（含文字）
+    QVector<Sprite> m_sprites;      ///< 运动图层，含义由图案决定
+    quint64 m_frameIndex;           ///< 已生成的帧数
+    qint64 m_frameIntervalUs;       ///< 帧间隔（微秒）
+    qint64 m_nextFrameTimeUs;       ///< 下一帧的计划输出时刻（单调时钟，微秒）
+};
+
+#endif // SYNTHETICFRAMESOURCE_H
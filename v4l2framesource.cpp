@@ -0,0 +1,364 @@
+/**
+ * @file v4l2framesource.cpp
+ * @brief 原生V4L2内存映射帧源的实现文件
+ */
+#include "v4l2framesource.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @struct V4l2Device
+ * @brief 已打开的V4L2设备及其映射的缓冲区
+ *
+ * 由帧源和所有尚未释放的帧共同持有；最后一个持有者释放时才解除映射并关闭设备，
+ * 因此帧源关闭后仍在使用的帧数据保持有效。
+ */
+struct V4l2Device
+{
+    struct MappedBuffer
+    {
+        void *start = MAP_FAILED;   ///< 映射地址
+        size_t length = 0;          ///< 映射长度
+    };
+
+    int fd = -1;                        ///< 设备文件描述符
+    std::vector<MappedBuffer> buffers;  ///< 映射的驱动缓冲区
+    std::mutex mutex;                   ///< 保护streaming和QBUF
+    bool streaming = false;             ///< 是否正在采集
+
+    ~V4l2Device()
+    {
+        for (const MappedBuffer& buffer : buffers) {
+            if (buffer.start != MAP_FAILED) {
+                munmap(buffer.start, buffer.length);
+            }
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief 把缓冲区归还给驱动，可在任意线程调用
+     * @param index 缓冲区索引
+     */
+    void requeue(unsigned index);
+};
+
+namespace {
+
+/**
+ * @brief 被EINTR打断时自动重试的ioctl
+ */
+int xioctl(int fd, unsigned long request, void *arg)
+{
+    int result;
+    do {
+        result = ioctl(fd, request, arg);
+    } while (result < 0 && errno == EINTR);
+    return result;
+}
+
+/**
+ * @struct V4l2BufferLease
+ * @brief 交给帧的缓冲区租约，销毁时归还缓冲区
+ */
+struct V4l2BufferLease
+{
+    std::shared_ptr<V4l2Device> device;
+    unsigned index;
+};
+
+/**
+ * @brief 创建缓冲区租约
+ * @param device 设备
+ * @param index 缓冲区索引
+ * @return 作为CameraFrame::buffer的持有者
+ */
+std::shared_ptr<const void> makeLease(const std::shared_ptr<V4l2Device>& device, unsigned index)
+{
+    return std::shared_ptr<const void>(new V4l2BufferLease{device, index}, [](const void *p) {
+        const V4l2BufferLease *lease = static_cast<const V4l2BufferLease*>(p);
+        lease->device->requeue(lease->index);
+        delete lease;
+    });
+}
+
+/**
+ * @brief 打印带errno说明的错误信息
+ */
+void reportError(const QString& devicePath, const char *what)
+{
+    std::cerr << devicePath.toStdString() << " " << what << "失败: " << std::strerror(errno) << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 把缓冲区归还给驱动
+ * @param index 缓冲区索引
+ */
+void V4l2Device::requeue(unsigned index)
+{
+    std::lock_guard<std::mutex> locker(mutex);
+    if (!streaming)
+        return;
+
+    v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    xioctl(fd, VIDIOC_QBUF, &buf);
+}
+
+/**
+ * @brief V4l2FrameSource类的构造函数
+ * @param devicePath 设备路径
+ * @param config 采集参数
+ */
+V4l2FrameSource::V4l2FrameSource(const QString& devicePath, const FrameSourceConfig& config)
+    : m_devicePath(devicePath)
+    , m_config(config)
+    , m_pixelFormat(0)
+    , m_width(0)
+    , m_height(0)
+    , m_bytesPerLine(0)
+{
+}
+
+/**
+ * @brief V4l2FrameSource类的析构函数
+ */
+V4l2FrameSource::~V4l2FrameSource()
+{
+    close();
+}
+
+/**
+ * @brief 打开设备、申请并映射缓冲区、开始采集
+ * @return 是否打开成功
+ */
+bool V4l2FrameSource::open()
+{
+    close();
+
+    auto device = std::make_shared<V4l2Device>();
+    device->fd = ::open(m_devicePath.toLocal8Bit().constData(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (device->fd < 0) {
+        reportError(m_devicePath, "打开设备");
+        return false;
+    }
+
+    v4l2_capability capability;
+    std::memset(&capability, 0, sizeof(capability));
+    if (xioctl(device->fd, VIDIOC_QUERYCAP, &capability) < 0) {
+        reportError(m_devicePath, "VIDIOC_QUERYCAP");
+        return false;
+    }
+    const quint32 caps = (capability.capabilities & V4L2_CAP_DEVICE_CAPS)
+                             ? capability.device_caps : capability.capabilities;
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING)) {
+        std::cerr << m_devicePath.toStdString() << " 不支持流式视频采集" << std::endl;
+        return false;
+    }
+
+    if (!configureFormat(device->fd))
+        return false;
+
+    // 申请驱动缓冲区
+    v4l2_requestbuffers request;
+    std::memset(&request, 0, sizeof(request));
+    request.count = static_cast<quint32>(qMax(2, m_config.bufferCount));
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(device->fd, VIDIOC_REQBUFS, &request) < 0 || request.count < 2) {
+        reportError(m_devicePath, "VIDIOC_REQBUFS");
+        return false;
+    }
+
+    // 映射并入队所有缓冲区
+    device->buffers.resize(request.count);
+    for (unsigned i = 0; i < request.count; ++i) {
+        v4l2_buffer buf;
+        std::memset(&buf, 0, sizeof(buf));
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = i;
+        if (xioctl(device->fd, VIDIOC_QUERYBUF, &buf) < 0) {
+            reportError(m_devicePath, "VIDIOC_QUERYBUF");
+            return false;
+        }
+
+        V4l2Device::MappedBuffer& mapped = device->buffers[i];
+        mapped.length = buf.length;
+        mapped.start = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                            device->fd, buf.m.offset);
+        if (mapped.start == MAP_FAILED) {
+            reportError(m_devicePath, "mmap");
+            return false;
+        }
+
+        if (xioctl(device->fd, VIDIOC_QBUF, &buf) < 0) {
+            reportError(m_devicePath, "VIDIOC_QBUF");
+            return false;
+        }
+    }
+
+    v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(device->fd, VIDIOC_STREAMON, &type) < 0) {
+        reportError(m_devicePath, "VIDIOC_STREAMON");
+        return false;
+    }
+
+    device->streaming = true;
+    m_device = device;
+    return true;
+}
+
+/**
+ * @brief 停止采集
+ *
+ * 设备和映射由仍持有帧的使用者共同持有，全部释放后才真正关闭
+ */
+void V4l2FrameSource::close()
+{
+    if (!m_device)
+        return;
+
+    {
+        std::lock_guard<std::mutex> locker(m_device->mutex);
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(m_device->fd, VIDIOC_STREAMOFF, &type);
+        m_device->streaming = false;
+    }
+    m_device.reset();
+}
+
+/**
+ * @brief 等待并取出下一帧
+ * @param frame 输出帧，raw直接指向内核缓冲区
+ * @param timeoutMs 最长等待时间（毫秒）
+ * @return 取帧结果
+ */
+FrameSource::GrabResult V4l2FrameSource::grab(CameraFrame& frame, int timeoutMs)
+{
+    if (!m_device)
+        return GrabResult::Error;
+
+    pollfd descriptor;
+    descriptor.fd = m_device->fd;
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+
+    const int ready = ::poll(&descriptor, 1, timeoutMs);
+    if (ready == 0)
+        return GrabResult::Timeout;
+    if (ready < 0)
+        return errno == EINTR ? GrabResult::Timeout : GrabResult::Error;
+    if (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+        std::cerr << m_devicePath.toStdString() << " 设备已断开" << std::endl;
+        return GrabResult::Error;
+    }
+
+    v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(m_device->fd, VIDIOC_DQBUF, &buf) < 0) {
+        if (errno == EAGAIN)
+            return GrabResult::Timeout;
+        reportError(m_devicePath, "VIDIOC_DQBUF");
+        return GrabResult::Error;
+    }
+
+    // 驱动标记为损坏的帧直接归还
+    if ((buf.flags & V4L2_BUF_FLAG_ERROR) || buf.bytesused == 0) {
+        m_device->requeue(buf.index);
+        return GrabResult::Timeout;
+    }
+
+    uchar *data = static_cast<uchar*>(m_device->buffers[buf.index].start);
+    if (m_pixelFormat == FOURCC_MJPG) {
+        frame.raw = cv::Mat(1, static_cast<int>(buf.bytesused), CV_8UC1, data);
+    } else {
+        frame.raw = cv::Mat(m_height, m_width, CV_8UC2, data, static_cast<size_t>(m_bytesPerLine));
+    }
+    frame.rawFormat = m_pixelFormat;
+    frame.buffer = makeLease(m_device, buf.index);
+
+    // UVC驱动的时间戳使用CLOCK_MONOTONIC，与std::chrono::steady_clock一致
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+        frame.deviceTimestampUs = static_cast<qint64>(buf.timestamp.tv_sec) * 1000000
+                                  + buf.timestamp.tv_usec;
+    } else {
+        frame.deviceTimestampUs = 0;
+    }
+    return GrabResult::Frame;
+}
+
+/**
+ * @brief 设置采集格式和帧率
+ * @param fd 设备文件描述符
+ * @return 是否成功
+ *
+ * 驱动不支持请求的格式时退回YUYV，两者都不支持则失败
+ */
+bool V4l2FrameSource::configureFormat(int fd)
+{
+    m_pixelFormat = 0;
+    const quint32 candidates[] = {m_config.pixelFormat, FOURCC_YUYV};
+    for (quint32 candidate : candidates) {
+        v4l2_format format;
+        std::memset(&format, 0, sizeof(format));
+        format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        format.fmt.pix.width = static_cast<quint32>(m_config.width);
+        format.fmt.pix.height = static_cast<quint32>(m_config.height);
+        format.fmt.pix.pixelformat = candidate;
+        format.fmt.pix.field = V4L2_FIELD_ANY;
+        if (xioctl(fd, VIDIOC_S_FMT, &format) < 0) {
+            reportError(m_devicePath, "VIDIOC_S_FMT");
+            return false;
+        }
+
+        const quint32 actual = format.fmt.pix.pixelformat;
+        if (actual == FOURCC_MJPG || actual == FOURCC_YUYV) {
+            m_pixelFormat = actual;
+            m_width = static_cast<int>(format.fmt.pix.width);
+            m_height = static_cast<int>(format.fmt.pix.height);
+            m_bytesPerLine = static_cast<int>(format.fmt.pix.bytesperline);
+            if (m_bytesPerLine == 0) {
+                m_bytesPerLine = m_width * 2;
+            }
+            break;
+        }
+    }
+
+    if (m_pixelFormat == 0) {
+        std::cerr << m_devicePath.toStdString() << " 不支持MJPG或YUYV格式" << std::endl;
+        return false;
+    }
+
+    // 帧率设置失败不影响采集
+    v4l2_streamparm parm;
+    std::memset(&parm, 0, sizeof(parm));
+    parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(fd, VIDIOC_G_PARM, &parm) == 0
+        && (parm.parm.capture.capability & V4L2_CAP_TIMEPERFRAME) && m_config.fps > 0) {
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator = static_cast<quint32>(m_config.fps);
+        xioctl(fd, VIDIOC_S_PARM, &parm);
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file v4l2framesource.h
+ * @brief 原生V4L2内存映射帧源的头文件
+ *
+ * 该文件定义了V4l2FrameSource类，直接使用V4L2的mmap流式I/O采集，
+ * 自行管理缓冲区队列，帧数据不经过任何拷贝直接交给调用者。
+ */
+#ifndef V4L2FRAMESOURCE_H
+#define V4L2FRAMESOURCE_H
+
+#include <memory>
+
+#include "framesource.h"
+
+struct V4l2Device;
+
+/**
+ * @class V4l2FrameSource
+ * @brief 原生V4L2内存映射帧源
+ *
+ * 打开时通过REQBUFS申请驱动缓冲区并mmap到进程，grab()用poll等待后DQBUF，
+ * CameraFrame::raw直接指向内核缓冲区；CameraFrame::buffer释放时自动QBUF归还。
+ * 帧中携带驱动的采集时间戳。
+ */
+class V4l2FrameSource : public FrameSource
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param devicePath 设备路径，如/dev/video0
+     * @param config 采集参数
+     */
+    V4l2FrameSource(const QString& devicePath, const FrameSourceConfig& config);
+
+    /**
+     * @brief 析构函数，停止采集
+     */
+    ~V4l2FrameSource() override;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return m_device != nullptr; }
+    GrabResult grab(CameraFrame& frame, int timeoutMs) override;
+    QString location() const override { return m_devicePath; }
+
+    /**
+     * @brief 获取驱动实际采用的像素格式
+     * @return FOURCC
+     */
+    quint32 pixelFormat() const { return m_pixelFormat; }
+
+private:
+    /**
+     * @brief 设置采集格式和帧率
+     * @param fd 设备文件描述符
+     * @return 是否成功
+     */
+    bool configureFormat(int fd);
+
+    QString m_devicePath;                   ///< 设备路径
+    FrameSourceConfig m_config;             ///< 采集参数
+    std::shared_ptr<V4l2Device> m_device;   ///< 设备与缓冲区，由交出的帧共同持有
+    quint32 m_pixelFormat;                  ///< 实际像素格式
+    int m_width;                            ///< 实际宽度
+    int m_height;                           ///< 实际高度
+    int m_bytesPerLine;                     ///< 实际每行字节数
+};
+
+#endif // V4L2FRAMESOURCE_H
@@ -0,0 +1,577 @@
+/**
+ * @file vehicledetector.cpp
+ * @brief 车辆/行人检测线程的实现文件
+ */
+#include "vehicledetector.h"
+#include "framemailbox.h"
+#include "frametiming.h"
+#include "inferencescheduler.h"
+#include "objecttracker.h"
+#include "overlaylayer.h"
+#include "perfreport.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+
+#include <iostream>
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// 等待的最长时间，保证停止请求能及时得到响应
+constexpr int kWaitTimeoutMs = 200;
+
+// 请求采样后等待各摄像头送来画面的最长时间，覆盖20fps以上摄像头的一个帧间隔
+constexpr qint64 kGatherTimeoutUs = 50000;
+
+// 采样画面早于请求时刻超过该值时视为过期，不参与本次推理
+constexpr qint64 kMaxSampleAgeUs = 100000;
+
+// 候选框的最低置信度和非极大值抑制的IoU阈值
+constexpr float kScoreThreshold = 0.35f;
+constexpr float kNmsThreshold = 0.45f;
+
+// 模型输入的填充颜色，与YOLO训练时的letterbox一致
+const cv::Scalar kPadColor(114, 114, 114);
+
+/**
+ * @struct CocoClass
+ * @brief 保留的COCO类别
+ */
+struct CocoClass
+{
+    int cocoId;                 ///< COCO类别编号
+    ObjectClass objectClass;    ///< 对应的目标类别
+};
+
+const CocoClass kCocoClasses[] = {
+    {0, ObjectClass::Person},
+    {1, ObjectClass::Bicycle},
+    {2, ObjectClass::Car},
+    {3, ObjectClass::Motorcycle},
+    {5, ObjectClass::Bus},
+    {7, ObjectClass::Truck},
+};
+
+// 模型输出中需要的最少通道数：4个框坐标加到卡车为止的类别分数
+constexpr int kMinOutputChannels = 4 + 8;
+
+// 目标框的颜色，行人比车辆更醒目
+const QColor kVehicleBoxColor(0x34, 0x98, 0xdb);
+const QColor kPersonBoxColor(0xf3, 0x9c, 0x12);
+
+/**
+ * @brief 把跟踪目标转换为叠加图元
+ * @param objects 跟踪目标
+ * @param timeUs 采集时刻
+ * @return 叠加场景，每个目标一个带标签和速度的框
+ */
+OverlayScene detectionScene(const DetectedObjects& objects, qint64 timeUs)
+{
+    OverlayScene scene;
+    scene.timeUs = timeUs;
+    scene.items.reserve(objects.size());
+    for (const DetectedObject& object : objects) {
+        OverlayItem item;
+        item.shape = OverlayItem::Shape::Box;
+        item.rect = object.box;
+        item.text = QString("%1 %2%").arg(objectClassName(object.objectClass))
+                                       .arg(qRound(object.confidence * 100));
+        item.color = object.objectClass == ObjectClass::Person ? kPersonBoxColor : kVehicleBoxColor;
+        item.velocity = object.velocity;
+        item.timeUs = object.timeUs;
+        scene.items.append(item);
+    }
+    return scene;
+}
+
+} // namespace
+
+/**
+ * @class VehicleDetector::CameraInput
+ * @brief 一个摄像头的采样信箱、跟踪器和叠加层通道
+ */
+class VehicleDetector::CameraInput : public FrameAnalyzer
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param detector 所属的检测线程
+     * @param overlay 画面块叠加层的通道
+     */
+    CameraInput(VehicleDetector *detector, OverlayChannel *overlay)
+        : detector(detector)
+        , overlay(overlay)
+        , sampleRequested(false)
+        , delivering(true)
+    {
+    }
+
+    /**
+     * @brief 提交一帧画面，只有检测线程请求了采样时才处理
+     * @param frame 已解码的帧
+     */
+    void submit(const CameraFrame& frame) override
+    {
+        if (frame.image.empty() || !sampleRequested.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        ModelInput& slot = samples.writeSlot();
+        try {
+            prepareInput(frame.image, slot);
+        } catch (const cv::Exception& e) {
+            std::cerr << "目标检测帧转换异常: " << e.what() << std::endl;
+            return;
+        }
+        // 与显示端使用同一个时间基准，目标框才能外推到显示帧的采集时刻
+        slot.captureTimeUs = frame.deviceTimestampUs > 0 ? frame.deviceTimestampUs : frame.captureTimeUs;
+        samples.publish();
+        detector->sampleArrived();
+    }
+
+    VehicleDetector *detector;              ///< 所属的检测线程
+    OverlayChannel *overlay;                ///< 画面块叠加层的通道（可为空）
+    FrameMailbox<ModelInput> samples;       ///< 采样信箱
+    std::atomic<bool> sampleRequested;      ///< 检测线程是否在等待采样
+
+    // 以下仅检测线程访问
+    ObjectTracker tracker;                  ///< 目标跟踪器
+    bool delivering;                        ///< 上一轮是否按时送来了采样
+};
+
+/**
+ * @brief VehicleDetector类的构造函数
+ * @param parent 父对象指针
+ */
+VehicleDetector::VehicleDetector(QObject *parent)
+    : QThread(parent)
+    , m_modelLoaded(false)
+    , m_batchSupported(true)
+    , m_cpuBudget(1.0)
+    , m_arrivals(0)
+    , m_inferences(0)
+    , m_inferredImages(0)
+    , m_detectedObjects(0)
+    , m_inferenceCpuUs(0)
+    , m_inferenceWallUs(0)
+    , m_intervalUs(0)
+{
+}
+
+/**
+ * @brief VehicleDetector类的析构函数
+ */
+VehicleDetector::~VehicleDetector()
+{
+    stop();
+}
+
+/**
+ * @brief 模型的默认查找目录
+ * @return 目录列表
+ */
+QStringList VehicleDetector::defaultModelDirectories()
+{
+    return {
+        QCoreApplication::applicationDirPath() + "/models",
+        "/usr/share/adas/models",
+        "/usr/local/share/adas/models",
+    };
+}
+
+/**
+ * @brief 加载检测模型
+ * @param path 模型文件路径
+ * @return 是否加载成功
+ */
+bool VehicleDetector::loadModel(const QString& path)
+{
+    m_modelLoaded = false;
+    m_batchSupported = true;
+
+    QStringList candidates;
+    if (path.isEmpty()) {
+        for (const QString& directory : defaultModelDirectories()) {
+            candidates.append(QDir(directory).filePath(kModelFile));
+        }
+    } else {
+        candidates.append(path);
+    }
+
+    for (const QString& candidate : candidates) {
+        if (!QFile::exists(candidate))
+            continue;
+        try {
+            m_net = cv::dnn::readNet(candidate.toStdString());
+            if (m_net.empty())
+                continue;
+            m_net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+            m_net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+            m_modelLoaded = true;
+            std::cout << "目标检测模型: " << candidate.toStdString() << std::endl;
+            return true;
+        } catch (const cv::Exception& e) {
+            std::cerr << "加载目标检测模型失败: " << e.what() << std::endl;
+        }
+    }
+
+    std::cerr << "未找到目标检测模型（" << kModelFile << "），车辆检测未启用" << std::endl;
+    return false;
+}
+
+/**
+ * @brief 添加一个参与检测的摄像头
+ * @param overlay 画面块叠加层的通道
+ * @return 帧分析器
+ */
+FrameAnalyzer* VehicleDetector::addCamera(OverlayChannel *overlay)
+{
+    m_inputs.emplace_back(new CameraInput(this, overlay));
+    return m_inputs.back().get();
+}
+
+/**
+ * @brief 设置推理可以使用的CPU预算
+ * @param cores 核数
+ */
+void VehicleDetector::setCpuBudget(double cores)
+{
+    m_cpuBudget.store(cores, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 停止线程
+ */
+void VehicleDetector::stop()
+{
+    requestInterruption();
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        m_wake.wakeAll();
+    }
+    wait();
+}
+
+/**
+ * @brief 采样到达
+ */
+void VehicleDetector::sampleArrived()
+{
+    QMutexLocker locker(&m_wakeMutex);
+    ++m_arrivals;
+    m_wake.wakeOne();
+}
+
+/**
+ * @brief 获取平均每批画面数
+ * @return 画面数
+ */
+double VehicleDetector::meanBatchSize() const
+{
+    const quint64 count = inferences();
+    return count > 0 ? static_cast<double>(inferredImages()) / count : 0.0;
+}
+
+/**
+ * @brief 获取平均每次推理的耗时
+ * @return 毫秒
+ */
+double VehicleDetector::meanInferenceMs() const
+{
+    const quint64 count = inferences();
+    return count > 0 ? m_inferenceWallUs.load(std::memory_order_relaxed) / 1000.0 / count : 0.0;
+}
+
+/**
+ * @brief 获取每核每秒推理的画面数
+ * @return 画面数
+ */
+double VehicleDetector::imagesPerCoreSecond() const
+{
+    const qint64 cpuUs = inferenceCpuUs();
+    return cpuUs > 0 ? inferredImages() * 1000000.0 / cpuUs : 0.0;
+}
+
+/**
+ * @brief 获取每核每秒检测到的目标数
+ * @return 目标数
+ */
+double VehicleDetector::detectionsPerCoreSecond() const
+{
+    const qint64 cpuUs = inferenceCpuUs();
+    return cpuUs > 0 ? detectedObjects() * 1000000.0 / cpuUs : 0.0;
+}
+
+/**
+ * @brief 获取当前每个摄像头的采样频率
+ * @return 每秒采样次数
+ */
+double VehicleDetector::sampleRateHz() const
+{
+    const qint64 intervalUs = m_intervalUs.load(std::memory_order_relaxed);
+    return intervalUs > 0 ? 1000000.0 / intervalUs : 0.0;
+}
+
+/**
+ * @brief 把一帧画面等比缩放并填充为模型输入
+ * @param image BGR画面
+ * @param input 模型输入
+ *
+ * 与训练时的letterbox一致：长边缩放到kInputSize，短边两侧用灰色填充
+ */
+void VehicleDetector::prepareInput(const cv::Mat& image, ModelInput& input)
+{
+    input.frameSize = image.size();
+    input.scale = qMin(static_cast<double>(kInputSize) / image.cols, static_cast<double>(kInputSize) / image.rows);
+    const int width = qBound(1, qRound(image.cols * input.scale), kInputSize);
+    const int height = qBound(1, qRound(image.rows * input.scale), kInputSize);
+    input.padX = (kInputSize - width) / 2;
+    input.padY = (kInputSize - height) / 2;
+
+    cv::resize(image, input.resized, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+    cv::copyMakeBorder(input.resized, input.image, input.padY, kInputSize - height - input.padY,
+                       input.padX, kInputSize - width - input.padX, cv::BORDER_CONSTANT, kPadColor);
+}
+
+/**
+ * @brief 对一批输入做一次前向推理
+ * @param inputs 模型输入
+ * @return 每个输入的检测结果
+ *
+ * 模型的批大小固定为1时，第一次批量推理会失败，之后改为逐帧推理
+ */
+QVector<DetectedObjects> VehicleDetector::infer(const std::vector<const ModelInput*>& inputs)
+{
+    QVector<DetectedObjects> results(static_cast<int>(inputs.size()));
+    if (!m_modelLoaded || inputs.empty())
+        return results;
+
+    auto forward = [this](const std::vector<cv::Mat>& images) {
+        cv::dnn::blobFromImages(images, m_blob, 1.0 / 255.0, cv::Size(), cv::Scalar(), true, false, CV_32F);
+        m_net.setInput(m_blob);
+        return m_net.forward();
+    };
+
+    std::vector<cv::Mat> images;
+    images.reserve(inputs.size());
+    for (const ModelInput *input : inputs) {
+        images.push_back(input->image);
+    }
+
+    if (m_batchSupported && images.size() > 1) {
+        try {
+            const cv::Mat output = forward(images);
+            if (output.dims == 3 && output.size[0] == static_cast<int>(images.size())) {
+                for (int i = 0; i < results.size(); ++i) {
+                    results[i] = decode(output, i, *inputs[i]);
+                }
+                return results;
+            }
+        } catch (const cv::Exception& e) {
+            std::cerr << "模型不支持批量推理，改为逐帧推理: " << e.what() << std::endl;
+        }
+        m_batchSupported = false;
+    }
+
+    try {
+        for (int i = 0; i < results.size(); ++i) {
+            const cv::Mat output = forward({images[i]});
+            results[i] = decode(output, 0, *inputs[i]);
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "目标检测推理异常: " << e.what() << std::endl;
+    }
+    return results;
+}
+
+/**
+ * @brief 解析一个输入的模型输出
+ * @param output 模型输出
+ * @param batchIndex 输入在批中的位置
+ * @param input 模型输入
+ * @return 检测结果
+ *
+ * 每个锚点只看保留的六个类别，最高分低于阈值的锚点直接跳过；
+ * 候选框按类别错开后做一次非极大值抑制，不同类别的框互不抑制
+ */
+DetectedObjects VehicleDetector::decode(const cv::Mat& output, int batchIndex, const ModelInput& input)
+{
+    DetectedObjects objects;
+    if (output.dims != 3 || output.type() != CV_32F)
+        return objects;
+
+    // 标准导出为[批, 通道, 锚点]，部分导出工具会转置为[批, 锚点, 通道]
+    const bool channelsFirst = output.size[1] < output.size[2];
+    const int channels = channelsFirst ? output.size[1] : output.size[2];
+    const int anchors = channelsFirst ? output.size[2] : output.size[1];
+    if (channels < kMinOutputChannels)
+        return objects;
+
+    const float *data = output.ptr<float>(batchIndex);
+    auto at = [&](int channel, int anchor) {
+        return channelsFirst ? data[channel * anchors + anchor] : data[anchor * channels + channel];
+    };
+
+    m_boxes.clear();
+    m_nmsBoxes.clear();
+    m_scores.clear();
+    m_classes.clear();
+    for (int i = 0; i < anchors; ++i) {
+        float best = 0.0f;
+        int bestClass = -1;
+        for (int c = 0; c < static_cast<int>(sizeof(kCocoClasses) / sizeof(kCocoClasses[0])); ++c) {
+            const float score = at(4 + kCocoClasses[c].cocoId, i);
+            if (score > best) {
+                best = score;
+                bestClass = c;
+            }
+        }
+        if (best < kScoreThreshold)
+            continue;
+
+        const float width = at(2, i);
+        const float height = at(3, i);
+        const cv::Rect box(qRound(at(0, i) - width / 2), qRound(at(1, i) - height / 2), qRound(width), qRound(height));
+        m_boxes.push_back(box);
+        m_nmsBoxes.push_back(box + cv::Point(bestClass * kInputSize * 2, 0));
+        m_scores.push_back(best);
+        m_classes.push_back(bestClass);
+    }
+    if (m_boxes.empty())
+        return objects;
+
+    cv::dnn::NMSBoxes(m_nmsBoxes, m_scores, kScoreThreshold, kNmsThreshold, m_keep);
+
+    // 从模型输入坐标换算回相对原始画面的比例
+    const double frameWidth = input.frameSize.width * input.scale;
+    const double frameHeight = input.frameSize.height * input.scale;
+    const QRectF bounds(0.0, 0.0, 1.0, 1.0);
+    objects.reserve(static_cast<int>(m_keep.size()));
+    for (int index : m_keep) {
+        const cv::Rect& box = m_boxes[index];
+        DetectedObject object;
+        object.objectClass = kCocoClasses[m_classes[index]].objectClass;
+        object.confidence = m_scores[index];
+        object.box = QRectF((box.x - input.padX) / frameWidth, (box.y - input.padY) / frameHeight,
+                            box.width / frameWidth, box.height / frameHeight).intersected(bounds);
+        object.timeUs = input.captureTimeUs;
+        if (!object.box.isEmpty()) {
+            objects.append(object);
+        }
+    }
+    return objects;
+}
+
+/**
+ * @brief 线程主函数
+ *
+ * 每轮：等到调度时刻 → 向所有摄像头请求采样 → 等待上一轮按时送达的摄像头全部送达或超时 →
+ * 批量推理 → 更新各摄像头的跟踪并发布。没有画面的摄像头不会让每一轮都等到超时
+ */
+void VehicleDetector::run()
+{
+    if (!m_modelLoaded || m_inputs.empty())
+        return;
+
+    InferenceScheduler scheduler(m_cpuBudget.load(std::memory_order_relaxed));
+    m_intervalUs.store(scheduler.intervalUs(), std::memory_order_relaxed);
+    for (const std::unique_ptr<CameraInput>& input : m_inputs) {
+        input->delivering = true;
+        input->tracker.reset();
+    }
+
+    qint64 nextUs = monotonicNowUs();
+    std::vector<CameraInput*> batch;
+    std::vector<const ModelInput*> samples;
+    while (!isInterruptionRequested()) {
+        // 等到调度时刻，并请求采样
+        int expected = 0;
+        {
+            QMutexLocker locker(&m_wakeMutex);
+            qint64 remainingUs = nextUs - monotonicNowUs();
+            while (remainingUs > 0 && !isInterruptionRequested()) {
+                m_wake.wait(&m_wakeMutex, static_cast<unsigned long>(qMin<qint64>(remainingUs / 1000 + 1, kWaitTimeoutMs)));
+                remainingUs = nextUs - monotonicNowUs();
+            }
+            m_arrivals = 0;
+        }
+        if (isInterruptionRequested())
+            break;
+
+        const qint64 requestUs = monotonicNowUs();
+        for (const std::unique_ptr<CameraInput>& input : m_inputs) {
+            input->sampleRequested.store(true, std::memory_order_release);
+            if (input->delivering) {
+                ++expected;
+            }
+        }
+
+        {
+            QMutexLocker locker(&m_wakeMutex);
+            const qint64 deadlineUs = requestUs + kGatherTimeoutUs;
+            qint64 remainingUs = deadlineUs - monotonicNowUs();
+            while (m_arrivals < expected && remainingUs > 0 && !isInterruptionRequested()) {
+                m_wake.wait(&m_wakeMutex, static_cast<unsigned long>(remainingUs / 1000 + 1));
+                remainingUs = deadlineUs - monotonicNowUs();
+            }
+        }
+
+        batch.clear();
+        samples.clear();
+        for (const std::unique_ptr<CameraInput>& input : m_inputs) {
+            input->sampleRequested.store(false, std::memory_order_release);
+            bool fresh = false;
+            if (input->samples.fetch()) {
+                const ModelInput& sample = input->samples.readSlot();
+                fresh = sample.captureTimeUs >= requestUs - kMaxSampleAgeUs;
+                if (fresh) {
+                    batch.push_back(input.get());
+                    samples.push_back(&sample);
+                }
+            }
+            input->delivering = fresh;
+        }
+
+        scheduler.setCpuBudget(m_cpuBudget.load(std::memory_order_relaxed));
+        if (!samples.empty()) {
+            const qint64 cpuStartUs = PerfReport::processCpuTimeUs();
+            const qint64 wallStartUs = monotonicNowUs();
+            const QVector<DetectedObjects> results = infer(samples);
+            const qint64 wallUs = monotonicNowUs() - wallStartUs;
+            // 推理库的工作线程也计入，进程中其他线程同时消耗的CPU会使结果偏保守
+            const qint64 cpuUs = cpuStartUs >= 0 ? PerfReport::processCpuTimeUs() - cpuStartUs : wallUs;
+            scheduler.recordInference(cpuUs);
+
+            quint64 objects = 0;
+            for (int i = 0; i < results.size(); ++i) {
+                CameraInput *input = batch[i];
+                objects += results[i].size();
+                const DetectedObjects tracked = input->tracker.update(results[i], samples[i]->captureTimeUs);
+                // 前后都没有目标时通道不会打扰界面
+                if (input->overlay) {
+                    input->overlay->publish(detectionScene(tracked, samples[i]->captureTimeUs));
+                }
+            }
+
+            m_inferences.fetch_add(1, std::memory_order_relaxed);
+            m_inferredImages.fetch_add(samples.size(), std::memory_order_relaxed);
+            m_detectedObjects.fetch_add(objects, std::memory_order_relaxed);
+            m_inferenceCpuUs.fetch_add(cpuUs, std::memory_order_relaxed);
+            m_inferenceWallUs.fetch_add(wallUs, std::memory_order_relaxed);
+        }
+
+        m_intervalUs.store(scheduler.intervalUs(), std::memory_order_relaxed);
+        nextUs = requestUs + scheduler.intervalUs();
+    }
+
+    // 停止后清除各画面块上的目标框
+    for (const std::unique_ptr<CameraInput>& input : m_inputs) {
+        input->sampleRequested.store(false, std::memory_order_release);
+        if (input->overlay) {
+            input->overlay->clear();
+        }
+    }
+}
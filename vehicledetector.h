@@ -0,0 +1,231 @@
+/**
+ * @file vehicledetector.h
+ * @brief 车辆/行人检测线程的头文件
+ *
+ * 该文件定义了VehicleDetector类，在独立线程中用OpenCV DNN（CPU）运行量化的检测模型，
+ * 把所有参与检测的摄像头的画面合并为一批做一次前向推理，推理之间由ObjectTracker外推目标位置。
+ */
+#ifndef VEHICLEDETECTOR_H
+#define VEHICLEDETECTOR_H
+
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+
+#include "detectedobject.h"
+#include "frameanalyzer.h"
+
+class OverlayChannel;
+
+/**
+ * @class VehicleDetector
+ * @brief 多摄像头批量目标检测线程
+ *
+ * 每个摄像头通过addCamera()得到一个FrameAnalyzer，接到该摄像头的采集线程上。
+ * 检测线程按InferenceScheduler给出的间隔向所有摄像头请求一帧采样，只有被请求时
+ * 解码线程才在submit()中把画面缩放并填充为模型输入尺寸，其余帧的开销只是读取一个原子变量。
+ * 各摄像头的采样到齐（或等待超时）后合并为一批做一次前向推理，每个摄像头的检测结果
+ * 交给各自的ObjectTracker，跟踪结果在检测线程中转换为带速度的目标框，直接发布到该摄像头
+ * 画面块叠加层的通道，不经过界面线程；绘制时目标框按速度外推到显示帧的采集时刻。
+ *
+ * 模型为Ultralytics YOLOv8格式导出的ONNX（输出[批, 4+80, 锚点]，COCO类别），
+ * 建议导出为动态批大小并做INT8静态量化；模型不支持批量输入时自动改为逐帧推理。
+ * 只保留行人、自行车、汽车、摩托车、公交车、卡车六类
+ */
+class VehicleDetector : public QThread
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @struct ModelInput
+     * @brief 缩放并填充到模型输入尺寸的一帧
+     */
+    struct ModelInput
+    {
+        cv::Mat resized;            ///< 等比缩放后的画面（中间结果，复用缓冲区）
+        cv::Mat image;              ///< kInputSize见方的模型输入（BGR）
+        double scale = 1.0;         ///< 缩放比例（模型输入/原始画面）
+        int padX = 0;               ///< 左侧填充宽度
+        int padY = 0;               ///< 上方填充高度
+        cv::Size frameSize;         ///< 原始画面尺寸
+        qint64 captureTimeUs = 0;   ///< 采集时刻（单调时钟，微秒）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit VehicleDetector(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，停止线程
+     */
+    ~VehicleDetector() override;
+
+    /**
+     * @brief 加载检测模型（线程未运行时调用）
+     * @param path 模型文件路径，为空时在默认目录中查找kModelFile
+     * @return 是否加载成功，失败时检测不启用
+     */
+    bool loadModel(const QString& path = QString());
+
+    /**
+     * @brief 模型是否已加载
+     * @return 是否已加载
+     */
+    bool isModelLoaded() const { return m_modelLoaded; }
+
+    /**
+     * @brief 添加一个参与检测的摄像头（线程启动前调用）
+     * @param overlay 该摄像头画面块叠加层的通道，须在线程停止后才销毁；为nullptr时只统计不发布
+     * @return 接到该摄像头采集线程上的帧分析器，由检测线程对象拥有
+     */
+    FrameAnalyzer* addCamera(OverlayChannel *overlay);
+
+    /**
+     * @brief 设置推理可以使用的CPU预算（线程安全）
+     * @param cores 核数
+     */
+    void setCpuBudget(double cores);
+
+    /**
+     * @brief 停止线程
+     */
+    void stop();
+
+    /**
+     * @brief 对一批输入做一次前向推理（仅检测线程或线程未运行时调用）
+     * @param inputs 模型输入
+     * @return 每个输入的检测结果，未跟踪
+     */
+    QVector<DetectedObjects> infer(const std::vector<const ModelInput*>& inputs);
+
+    /**
+     * @brief 把一帧画面等比缩放并填充为模型输入
+     * @param image BGR画面
+     * @param input 输出模型输入，复用其缓冲区
+     */
+    static void prepareInput(const cv::Mat& image, ModelInput& input);
+
+    /**
+     * @brief 获取推理次数（线程安全）
+     * @return 推理次数
+     */
+    quint64 inferences() const { return m_inferences.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取推理过的画面数（线程安全）
+     * @return 画面数
+     */
+    quint64 inferredImages() const { return m_inferredImages.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取检测到的目标数（线程安全）
+     * @return 目标数（跟踪前）
+     */
+    quint64 detectedObjects() const { return m_detectedObjects.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取推理消耗的CPU时间（线程安全）
+     * @return 微秒
+     */
+    qint64 inferenceCpuUs() const { return m_inferenceCpuUs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取平均每批画面数（线程安全）
+     * @return 画面数
+     */
+    double meanBatchSize() const;
+
+    /**
+     * @brief 获取平均每次推理的耗时（线程安全）
+     * @return 毫秒（墙钟时间）
+     */
+    double meanInferenceMs() const;
+
+    /**
+     * @brief 获取每核每秒推理的画面数（线程安全）
+     * @return 画面数，尚无推理时为0
+     */
+    double imagesPerCoreSecond() const;
+
+    /**
+     * @brief 获取每核每秒检测到的目标数（线程安全）
+     * @return 目标数，尚无推理时为0
+     */
+    double detectionsPerCoreSecond() const;
+
+    /**
+     * @brief 获取当前每个摄像头的采样频率（线程安全）
+     * @return 每秒采样次数
+     */
+    double sampleRateHz() const;
+
+    static constexpr int kInputSize = 320;                  ///< 模型输入边长
+    static constexpr const char *kModelFile = "yolov8n_int8.onnx"; ///< 默认模型文件名
+
+protected:
+    /**
+     * @brief 线程主函数，按调度间隔采样、批量推理、更新跟踪
+     */
+    void run() override;
+
+private:
+    class CameraInput;
+
+    /**
+     * @brief 采样到达，由CameraInput在解码线程中调用
+     */
+    void sampleArrived();
+
+    /**
+     * @brief 解析一个输入的模型输出
+     * @param output 模型输出
+     * @param batchIndex 输入在批中的位置
+     * @param input 模型输入
+     * @return 检测结果
+     */
+    DetectedObjects decode(const cv::Mat& output, int batchIndex, const ModelInput& input);
+
+    /**
+     * @brief 模型的默认查找目录
+     * @return 目录列表
+     */
+    static QStringList defaultModelDirectories();
+
+    cv::dnn::Net m_net;                                 ///< 检测网络
+    bool m_modelLoaded;                                 ///< 模型是否已加载
+    bool m_batchSupported;                              ///< 模型是否支持批量输入
+    std::vector<std::unique_ptr<CameraInput>> m_inputs; ///< 各摄像头的输入
+    std::atomic<double> m_cpuBudget;                    ///< CPU预算（核数）
+
+    QMutex m_wakeMutex;                                 ///< 唤醒互斥锁
+    QWaitCondition m_wake;                              ///< 采样到达通知
+    int m_arrivals;                                     ///< 本轮已到达的采样数（受m_wakeMutex保护）
+
+    // 以下仅检测线程访问
+    cv::Mat m_blob;                                     ///< 批量输入（复用缓冲区）
+    std::vector<cv::Rect> m_boxes;                      ///< 候选框（模型输入坐标）
+    std::vector<cv::Rect> m_nmsBoxes;                   ///< 按类别错开的候选框，用于分类别抑制
+    std::vector<float> m_scores;                        ///< 候选框置信度
+    std::vector<int> m_classes;                         ///< 候选框类别
+    std::vector<int> m_keep;                            ///< 非极大值抑制后保留的候选框
+
+    std::atomic<quint64> m_inferences;                  ///< 推理次数
+    std::atomic<quint64> m_inferredImages;              ///< 推理过的画面数
+    std::atomic<quint64> m_detectedObjects;             ///< 检测到的目标数
+    std::atomic<qint64> m_inferenceCpuUs;               ///< 推理消耗的CPU时间
+    std::atomic<qint64> m_inferenceWallUs;              ///< 推理耗时总和
+    std::atomic<qint64> m_intervalUs;                   ///< 当前推理间隔
+};
+
+#endif // VEHICLEDETECTOR_H
@@ -0,0 +1,68 @@
+/**
+ * @file vehiclesignal.h
+ * @brief 车辆信号定义的头文件
+ */
+#ifndef VEHICLESIGNAL_H
+#define VEHICLESIGNAL_H
+
+#include <QString>
+
+/**
+ * @brief 从CAN总线解码的车辆信号
+ */
+enum class VehicleSignal {
+    Speed,          ///< 车速（km/h）
+    SteeringAngle,  ///< 方向盘转角（度，左正右负）
+    Gear,           ///< 挡位（0=P，1=R，2=N，3=D）
+    TurnSignal,     ///< 转向灯（0=关，1=左，2=右，3=双闪）
+    Brake,          ///< 制动踏板（0=松开，1=踩下）
+    Count           ///< 信号数量
+};
+
+/// 车辆信号数量
+constexpr int kVehicleSignalCount = static_cast<int>(VehicleSignal::Count);
+
+/**
+ * @brief 获取信号在配置文件中使用的名称
+ * @param signal 车辆信号
+ * @return 名称
+ */
+inline const char* vehicleSignalKey(VehicleSignal signal)
+{
+    switch (signal) {
+    case VehicleSignal::Speed:
+        return "speed";
+    case VehicleSignal::SteeringAngle:
+        return "steering_angle";
+    case VehicleSignal::Gear:
+        return "gear";
+    case VehicleSignal::TurnSignal:
+        return "turn_signal";
+    case VehicleSignal::Brake:
+        return "brake";
+    case VehicleSignal::Count:
+        break;
+    }
+    return "";
+}
+
+/**
+ * @brief 根据配置文件中的名称查找信号
+ * @param key 名称
+ * @param ok 输出是否找到
+ * @return 车辆信号
+ */
+inline VehicleSignal vehicleSignalFromKey(const QString& key, bool *ok)
+{
+    for (int i = 0; i < kVehicleSignalCount; ++i) {
+        const VehicleSignal signal = static_cast<VehicleSignal>(i);
+        if (key == QLatin1String(vehicleSignalKey(signal))) {
+            *ok = true;
+            return signal;
+        }
+    }
+    *ok = false;
+    return VehicleSignal::Count;
+}
+
+#endif // VEHICLESIGNAL_H
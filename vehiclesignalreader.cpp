@@ -0,0 +1,184 @@
+/**
+ * @file vehiclesignalreader.cpp
+ * @brief 车辆信号读取线程的实现文件
+ */
+#include "vehiclesignalreader.h"
+#include "frametiming.h"
+
+#include <iostream>
+
+namespace {
+
+// 默认通知周期，与60Hz显示刷新一致
+constexpr qint64 kDefaultNotifyIntervalUs = 1000000 / 60;
+
+// 无待通知的新值时读取的最长等待时间，决定stop()的响应速度
+constexpr int kReadTimeoutMs = 100;
+
+} // namespace
+
+/**
+ * @brief VehicleSignalReader类的构造函数
+ * @param location 帧源位置
+ * @param table 信号表
+ * @param config 帧源参数
+ * @param parent 父对象指针
+ */
+VehicleSignalReader::VehicleSignalReader(const QString& location, const QVector<CanSignalDef>& table,
+                                         const CanSourceConfig& config, QObject *parent)
+    : QThread(parent)
+    , m_source(createCanFrameSource(location, config))
+    , m_location(location)
+    , m_decoder(table)
+    , m_connected(false)
+    , m_notifyIntervalUs(kDefaultNotifyIntervalUs)
+    , m_lastNotifyUs(0)
+    , m_dirty(false)
+    , m_notifyPending(false)
+    , m_receivedFrames(0)
+    , m_decodedFrames(0)
+{
+    for (int i = 0; i < kVehicleSignalCount; ++i) {
+        m_values[i].store(0.0, std::memory_order_relaxed);
+        m_updatedUs[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief VehicleSignalReader类的析构函数
+ */
+VehicleSignalReader::~VehicleSignalReader()
+{
+    stop();
+}
+
+/**
+ * @brief 停止线程并关闭帧源
+ */
+void VehicleSignalReader::stop()
+{
+    requestInterruption();
+    wait();
+
+    if (m_source) {
+        m_source->close();
+    }
+    m_connected = false;
+}
+
+/**
+ * @brief 取走各信号的最新值
+ * @return 最新值快照
+ *
+ * 先清除通知标志再读取，读取期间写入的新值一定会再触发一次通知
+ */
+VehicleSignalSnapshot VehicleSignalReader::takeSnapshot()
+{
+    m_notifyPending.store(false, std::memory_order_release);
+
+    VehicleSignalSnapshot snapshot;
+    for (int i = 0; i < kVehicleSignalCount; ++i) {
+        snapshot.updatedUs[i] = m_updatedUs[i].load(std::memory_order_acquire);
+        snapshot.values[i] = m_values[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+/**
+ * @brief 线程主函数
+ *
+ * 有新值等待通知时，读取的等待时间不超过距下一个通知时刻的时长，
+ * 总线安静下来后最后一次变化也能在一个通知周期内送达界面
+ */
+void VehicleSignalReader::run()
+{
+    if (!m_source) {
+        std::cerr << "不支持的CAN帧源: " << m_location.toStdString() << std::endl;
+        return;
+    }
+
+    CanFrame frame;
+    while (!isInterruptionRequested()) {
+        if (!m_connected && !reconnect())
+            continue;
+
+        int timeoutMs = kReadTimeoutMs;
+        if (m_dirty) {
+            const qint64 remainingUs = m_lastNotifyUs + m_notifyIntervalUs - monotonicNowUs();
+            timeoutMs = static_cast<int>(qBound<qint64>(0, remainingUs / 1000, kReadTimeoutMs));
+        }
+
+        const CanFrameSource::ReadResult result = m_source->read(frame, timeoutMs);
+        if (result == CanFrameSource::ReadResult::Error) {
+            std::cerr << "CAN帧源读取失败，重新连接: " << m_location.toStdString() << std::endl;
+            m_source->close();
+            m_connected = false;
+            sleepInterruptible(m_backoff.nextDelayMs());
+            continue;
+        }
+
+        if (result == CanFrameSource::ReadResult::Frame) {
+            m_receivedFrames.fetch_add(1, std::memory_order_relaxed);
+            const int decoded = m_decoder.decode(frame, [this, &frame](VehicleSignal signal, double value) {
+                const int index = static_cast<int>(signal);
+                m_values[index].store(value, std::memory_order_relaxed);
+                m_updatedUs[index].store(frame.timeUs, std::memory_order_release);
+            });
+            if (decoded > 0) {
+                m_decodedFrames.fetch_add(1, std::memory_order_relaxed);
+                m_dirty = true;
+            }
+        }
+
+        maybeNotify(monotonicNowUs());
+    }
+}
+
+/**
+ * @brief 尝试打开帧源
+ * @return 是否打开成功
+ */
+bool VehicleSignalReader::reconnect()
+{
+    if (m_source->open()) {
+        m_connected = true;
+        m_backoff.reset();
+        std::cout << "CAN帧源已打开: " << m_location.toStdString() << std::endl;
+        return true;
+    }
+
+    sleepInterruptible(m_backoff.nextDelayMs());
+    return false;
+}
+
+/**
+ * @brief 有新值且距上一次通知已满一个周期时通知界面线程
+ * @param nowUs 当前时刻
+ *
+ * 界面线程尚未取走上一次通知时不再发出，它取走时读到的已经是最新值
+ */
+void VehicleSignalReader::maybeNotify(qint64 nowUs)
+{
+    if (!m_dirty || nowUs - m_lastNotifyUs < m_notifyIntervalUs)
+        return;
+
+    m_dirty = false;
+    m_lastNotifyUs = nowUs;
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        emit signalsAvailable();
+    }
+}
+
+/**
+ * @brief 可被stop()打断的睡眠
+ * @param ms 睡眠时长（毫秒）
+ */
+void VehicleSignalReader::sleepInterruptible(int ms)
+{
+    constexpr int kSliceMs = 50;
+    while (ms > 0 && !isInterruptionRequested()) {
+        const int slice = qMin(ms, kSliceMs);
+        msleep(static_cast<unsigned long>(slice));
+        ms -= slice;
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @file vehiclesignalreader.h
+ * @brief 车辆信号读取线程的头文件
+ *
+ * 该文件定义了VehicleSignalReader类，在独立线程中读取CAN帧并解码车辆信号，
+ * 最新值保存在原子变量中，界面线程按显示刷新率取走，CAN总线的帧率再高也不会堆积Qt事件。
+ */
+#ifndef VEHICLESIGNALREADER_H
+#define VEHICLESIGNALREADER_H
+
+#include <QThread>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+#include "canframesource.h"
+#include "cansignaldecoder.h"
+#include "reconnectbackoff.h"
+#include "vehiclesignal.h"
+
+/**
+ * @struct VehicleSignalSnapshot
+ * @brief 各车辆信号的最新值
+ */
+struct VehicleSignalSnapshot
+{
+    double values[kVehicleSignalCount] = {};    ///< 物理值
+    qint64 updatedUs[kVehicleSignalCount] = {}; ///< 更新时刻（单调时钟，微秒），0表示从未收到
+
+    /**
+     * @brief 获取信号的最新值
+     * @param signal 车辆信号
+     * @return 物理值，从未收到时为0
+     */
+    double value(VehicleSignal signal) const { return values[static_cast<int>(signal)]; }
+
+    /**
+     * @brief 是否收到过该信号
+     * @param signal 车辆信号
+     * @return 是否收到过
+     */
+    bool hasValue(VehicleSignal signal) const { return updatedUs[static_cast<int>(signal)] > 0; }
+};
+
+/**
+ * @class VehicleSignalReader
+ * @brief 车辆信号读取线程
+ *
+ * 帧源的打开、读取和解码都在该线程中进行，打开失败或读取出错时按指数退避重连。
+ * 每个信号的最新值单独原子更新，不加锁；同一次快照中不同信号可能来自相邻的帧。
+ * 有新值时最多每个通知周期发出一次signalsAvailable()，且在界面线程取走之前不重复发出，
+ * 事件队列中始终最多只有一个待处理的通知
+ */
+class VehicleSignalReader : public QThread
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param location "can:<接口名>"或candump日志文件路径
+     * @param table 信号表
+     * @param config 帧源参数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    VehicleSignalReader(const QString& location,
+                        const QVector<CanSignalDef>& table = CanSignalDecoder::defaultTable(),
+                        const CanSourceConfig& config = CanSourceConfig(), QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数，停止线程并关闭帧源
+     */
+    ~VehicleSignalReader() override;
+
+    /**
+     * @brief 停止线程并关闭帧源
+     */
+    void stop();
+
+    /**
+     * @brief 设置通知周期（须在start()之前调用）
+     * @param intervalUs 两次通知之间的最短间隔（微秒），通常为显示刷新周期
+     */
+    void setNotifyIntervalUs(qint64 intervalUs) { m_notifyIntervalUs = intervalUs; }
+
+    /**
+     * @brief 取走各信号的最新值（仅界面线程调用）
+     * @return 最新值快照
+     *
+     * 调用后再有新值会重新触发signalsAvailable()
+     */
+    VehicleSignalSnapshot takeSnapshot();
+
+    /**
+     * @brief 获取收到的CAN帧总数（线程安全）
+     * @return 帧数
+     */
+    quint64 receivedFrames() const { return m_receivedFrames.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取包含已知信号的CAN帧数量（线程安全）
+     * @return 帧数
+     */
+    quint64 decodedFrames() const { return m_decodedFrames.load(std::memory_order_relaxed); }
+
+signals:
+    /**
+     * @brief 有新的信号值可以取走
+     *
+     * 在读取线程中发出，连接到界面线程时自动排队
+     */
+    void signalsAvailable();
+
+protected:
+    /**
+     * @brief 线程主函数，循环读取和解码CAN帧
+     */
+    void run() override;
+
+private:
+    /**
+     * @brief 尝试打开帧源，失败时等待退避时间
+     * @return 是否打开成功
+     */
+    bool reconnect();
+
+    /**
+     * @brief 有新值且距上一次通知已满一个周期时通知界面线程
+     * @param nowUs 当前时刻（单调时钟，微秒）
+     */
+    void maybeNotify(qint64 nowUs);
+
+    /**
+     * @brief 可被stop()打断的睡眠
+     * @param ms 睡眠时长（毫秒）
+     */
+    void sleepInterruptible(int ms);
+
+    std::unique_ptr<CanFrameSource> m_source;                   ///< CAN帧源
+    QString m_location;                                         ///< 帧源位置
+    CanSignalDecoder m_decoder;                                 ///< 信号解码器
+    ReconnectBackoff m_backoff;                                 ///< 重连退避策略
+    bool m_connected;                                           ///< 帧源是否已打开（仅读取线程访问）
+    qint64 m_notifyIntervalUs;                                  ///< 通知周期（微秒）
+    qint64 m_lastNotifyUs;                                      ///< 上一次通知的时刻（仅读取线程访问）
+    bool m_dirty;                                               ///< 上一次通知后是否有新值（仅读取线程访问）
+    std::atomic<double> m_values[kVehicleSignalCount];          ///< 各信号的最新值
+    std::atomic<qint64> m_updatedUs[kVehicleSignalCount];       ///< 各信号的更新时刻
+    std::atomic<bool> m_notifyPending;                          ///< 已通知但界面线程尚未取走
+    std::atomic<quint64> m_receivedFrames;                      ///< 收到的CAN帧总数
+    std::atomic<quint64> m_decodedFrames;                       ///< 包含已知信号的CAN帧数量
+};
+
+#endif // VEHICLESIGNALREADER_H
@@ -0,0 +1,452 @@
+/**
+ * @file videotile.cpp
+ * @brief 摄像头画面块的实现文件
+ */
+#include "videotile.h"
+#include "framecopycounter.h"
+#include "framemailbox.h"
+#include "fusedscaler.h"
+#include "overlaylayer.h"
+#include "stageprofiler.h"
+#include "workerpool.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QRunnable>
+#include <QThreadPool>
+
+/**
+ * @struct ScaledFrame
+ * @brief 已缩放好的画面及其时间戳
+ */
+struct ScaledFrame
+{
+    QImage image;           ///< 已缩放好的画面
+    FrameTiming timing;     ///< 帧时间戳
+};
+
+/**
+ * @struct TileScaleState
+ * @brief 画面块与后台缩放任务共享的状态
+ *
+ * 由shared_ptr持有，画面块销毁后仍在运行的缩放任务可以安全结束。
+ * 同一时刻最多只有一个缩放任务在运行，因此信箱始终只有一个生产者。
+ */
+struct TileScaleState
+{
+    QMutex mutex;                       ///< 保护以下待处理字段
+    QImage pending;                     ///< 待缩放的最新帧
+    FrameTiming pendingTiming;          ///< 待缩放帧的时间戳
+    QSize targetSize;                   ///< 缩放目标尺寸（设备像素）
+    qreal devicePixelRatio = 1.0;       ///< 合成器的设备像素比
+    bool busy = false;                  ///< 是否已有缩放任务在运行
+    VideoTile *tile = nullptr;          ///< 目标画面块，画面块销毁时置空
+
+    FusedBgrScaler scaler;              ///< 颜色转换+缩放融合内核（仅缩放任务使用）
+    FrameMailbox<ScaledFrame> scaled;   ///< 已缩放好的画面
+};
+
+namespace {
+
+// 叠加层统计文字的刷新间隔
+constexpr qint64 kStatsTextIntervalUs = 500000;
+
+/**
+ * @brief 将帧缩放到目标尺寸并转换为绘制最快的RGB32格式
+ * @param source 原始帧
+ * @param targetSize 目标尺寸，为空时保持原尺寸
+ * @param scaler 融合内核
+ * @param out 输出画面，尺寸和格式匹配且未被共享时直接复用其缓冲区
+ *
+ * 三字节格式的帧在一次遍历中完成颜色转换和缩放，其他格式使用Qt的缩放
+ */
+void scaleToTile(const QImage& source, const QSize& targetSize, FusedBgrScaler& scaler, QImage& out)
+{
+    const QSize size = targetSize.isEmpty() ? source.size() : targetSize;
+
+    FusedBgrScaler::ChannelOrder order = FusedBgrScaler::ChannelOrder::RGB;
+    switch (source.format()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    case QImage::Format_BGR888:
+        order = FusedBgrScaler::ChannelOrder::BGR;
+        break;
+#endif
+    case QImage::Format_RGB888:
+        order = FusedBgrScaler::ChannelOrder::RGB;
+        break;
+    default:
+        out = source.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                    .convertToFormat(QImage::Format_RGB32);
+        FrameCopyCounter::recordAllocation();
+        FrameCopyCounter::recordPixelPass(out.sizeInBytes());
+        return;
+    }
+
+    if (out.size() != size || out.format() != QImage::Format_RGB32 || !out.isDetached()) {
+        out = QImage(size, QImage::Format_RGB32);
+        FrameCopyCounter::recordAllocation();
+    }
+
+    scaler.setGeometry(source.width(), source.height(), size.width(), size.height());
+    scaler.process(source.constBits(), static_cast<std::size_t>(source.bytesPerLine()), order,
+                   out.bits(), static_cast<std::size_t>(out.bytesPerLine()));
+    FrameCopyCounter::recordPixelPass(out.sizeInBytes());
+}
+
+/**
+ * @class TileScaleTask
+ * @brief 在线程池中缩放帧的任务
+ *
+ * 循环处理待缩放的最新帧，直到没有新帧为止
+ */
+class TileScaleTask : public QRunnable
+{
+public:
+    explicit TileScaleTask(std::shared_ptr<TileScaleState> state)
+        : m_state(std::move(state))
+    {
+    }
+
+    void run() override
+    {
+        for (;;) {
+            QImage source;
+            FrameTiming timing;
+            QSize targetSize;
+            qreal devicePixelRatio = 1.0;
+            {
+                QMutexLocker locker(&m_state->mutex);
+                if (m_state->pending.isNull() || !m_state->tile) {
+                    m_state->busy = false;
+                    return;
+                }
+                source = m_state->pending;
+                m_state->pending = QImage();
+                timing = m_state->pendingTiming;
+                targetSize = m_state->targetSize;
+                devicePixelRatio = m_state->devicePixelRatio;
+            }
+
+            ScaledFrame& scaled = m_state->scaled.writeSlot();
+            {
+                StageProfiler::Scope profile(StageProfiler::Stage::Scale);
+                scaleToTile(source, targetSize, m_state->scaler, scaled.image);
+            }
+            scaled.image.setDevicePixelRatio(devicePixelRatio);
+            scaled.timing = timing;
+            if (timing.sequence != 0) {
+                scaled.timing.convertUs = monotonicNowUs();
+            }
+            m_state->scaled.publish();
+
+            QMutexLocker locker(&m_state->mutex);
+            if (m_state->tile) {
+                QMetaObject::invokeMethod(m_state->tile, "update", Qt::QueuedConnection);
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<TileScaleState> m_state;
+};
+
+} // namespace
+
+/**
+ * @brief VideoTile类的构造函数
+ * @param parent 父对象指针
+ */
+VideoTile::VideoTile(QObject *parent)
+    : QObject(parent)
+    , m_state(std::make_shared<TileScaleState>())
+    , m_devicePixelRatio(1.0)
+    , m_renderScale(1.0)
+    , m_placeholderText("无信号")
+    , m_overlay(new OverlayLayer(this))
+    , m_currentCaptureUs(0)
+    , m_lastPaintTimeUs(0)
+    , m_averagePaintTimeUs(0.0)
+    , m_statsOverlayVisible(false)
+    , m_statsTextUpdatedUs(0)
+{
+    m_state->tile = this;
+    // 叠加层的通知由分析线程发出，自动排队到界面线程处理
+    connect(m_overlay, &OverlayLayer::changed, this, &VideoTile::onOverlayChanged);
+}
+
+/**
+ * @brief VideoTile类的析构函数
+ *
+ * 与后台任务断开，已投递的重绘请求会随画面块一起被丢弃
+ */
+VideoTile::~VideoTile()
+{
+    QMutexLocker locker(&m_state->mutex);
+    m_state->tile = nullptr;
+    m_state->pending = QImage();
+}
+
+/**
+ * @brief 设置新的一帧画面
+ * @param frame 原始分辨率的帧图像
+ * @param timing 帧时间戳
+ *
+ * 若已有缩放任务在运行，只替换待处理帧，由该任务继续处理
+ */
+void VideoTile::setFrame(const QImage& frame, const FrameTiming& timing)
+{
+    if (frame.isNull())
+        return;
+
+    bool startTask = false;
+    {
+        QMutexLocker locker(&m_state->mutex);
+        m_state->pending = frame;
+        m_state->pendingTiming = timing;
+        startTask = !m_state->busy;
+        m_state->busy = true;
+    }
+
+    if (startTask) {
+        frameWorkerPool()->start(new TileScaleTask(m_state));
+    }
+}
+
+/**
+ * @brief 清除当前画面
+ *
+ * 丢弃待缩放帧和已缩放但未显示的帧，正在运行的缩放任务完成后可能还会显示一帧
+ */
+void VideoTile::clearFrame()
+{
+    {
+        QMutexLocker locker(&m_state->mutex);
+        m_state->pending = QImage();
+    }
+    if (m_state->scaled.fetch()) {
+        m_state->scaled.readSlot().image = QImage();
+    }
+    m_current = QImage();
+    update();
+}
+
+/**
+ * @brief 设置无画面时显示的提示文字
+ * @param text 提示文字
+ */
+void VideoTile::setPlaceholderText(const QString& text)
+{
+    if (m_placeholderText == text)
+        return;
+    m_placeholderText = text;
+    update();
+}
+
+/**
+ * @brief 设置画面块在合成器中的位置
+ * @param rect 位置
+ * @param devicePixelRatio 设备像素比
+ */
+void VideoTile::setGeometry(const QRect& rect, qreal devicePixelRatio)
+{
+    const QSize oldSize = targetSize();
+    m_geometry = rect;
+    m_devicePixelRatio = devicePixelRatio;
+    updateTargetSize(oldSize);
+}
+
+/**
+ * @brief 获取画面块的设备像素尺寸
+ * @return 设备像素尺寸
+ */
+QSize VideoTile::deviceSize() const
+{
+    return m_geometry.size() * m_devicePixelRatio;
+}
+
+/**
+ * @brief 获取后台缩放的目标尺寸
+ * @return 目标尺寸
+ */
+QSize VideoTile::targetSize() const
+{
+    return deviceSize() * m_renderScale;
+}
+
+/**
+ * @brief 设置渲染比例
+ * @param scale 渲染比例
+ */
+void VideoTile::setRenderScale(qreal scale)
+{
+    scale = qBound<qreal>(0.1, scale, 1.0);
+    if (qFuzzyCompare(scale, m_renderScale))
+        return;
+
+    const QSize oldSize = targetSize();
+    m_renderScale = scale;
+    updateTargetSize(oldSize);
+}
+
+/**
+ * @brief 更新后台缩放的目标尺寸
+ * @param oldSize 变化前的目标尺寸
+ *
+ * 尺寸变化时发出targetSizeChanged()，解码尺寸随之变化
+ */
+void VideoTile::updateTargetSize(const QSize& oldSize)
+{
+    const QSize size = targetSize();
+    {
+        QMutexLocker locker(&m_state->mutex);
+        m_state->targetSize = size;
+        m_state->devicePixelRatio = m_devicePixelRatio * m_renderScale;
+    }
+    if (size != oldSize) {
+        emit targetSizeChanged(size);
+    }
+}
+
+/**
+ * @brief 设置是否在画面上叠加延迟统计
+ * @param visible 是否显示
+ */
+void VideoTile::setStatsOverlayVisible(bool visible)
+{
+    if (m_statsOverlayVisible == visible)
+        return;
+    m_statsOverlayVisible = visible;
+    m_statsTextUpdatedUs = 0;
+    update();
+}
+
+/**
+ * @brief 请求合成器重绘该画面块
+ */
+void VideoTile::update()
+{
+    emit updateRequested(this);
+}
+
+/**
+ * @brief 叠加层有新发布的图元
+ *
+ * 画面本身没有变化，只请求重绘新旧图元覆盖的区域；没有画面时不显示叠加层
+ */
+void VideoTile::onOverlayChanged()
+{
+    const QRegion region = m_overlay->takeChanges(m_geometry, m_currentCaptureUs);
+    if (m_current.isNull() || region.isEmpty())
+        return;
+    emit regionUpdateRequested(this, region);
+}
+
+/**
+ * @brief 绘制画面块
+ * @param painter 合成器后备缓冲区的绘制器
+ * @param region 需要重绘的区域
+ *
+ * 完整绘制时取走最新的已缩放画面并直接贴图，新画面绘制完成后把该帧计入延迟统计。
+ * 局部绘制只在叠加层变化时发生，不取新画面，否则同一画面块内会出现新旧两帧；
+ * 有新画面时缩放任务另会请求完整绘制。两种情况都记录绘制耗时
+ */
+void VideoTile::paint(QPainter& painter, const QRegion& region)
+{
+    StageProfiler::Scope profile(StageProfiler::Stage::Paint);
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool partial = !region.isEmpty() && !(QRegion(m_geometry) - region).isEmpty();
+
+    FrameTiming timing;
+    if (!partial && m_state->scaled.fetch()) {
+        const ScaledFrame& scaled = m_state->scaled.readSlot();
+        m_current = scaled.image;
+        timing = scaled.timing;
+        m_currentCaptureUs = scaled.timing.captureUs;
+    }
+
+    if (m_current.isNull()) {
+        painter.fillRect(m_geometry, QColor(0x22, 0x22, 0x22));
+        painter.setPen(Qt::white);
+        painter.drawText(m_geometry, Qt::AlignCenter, m_placeholderText);
+    } else if (partial) {
+        drawPartialFrame(painter, region);
+    } else if (m_current.size() == deviceSize()) {
+        // 尺寸一致，直接贴图
+        painter.drawImage(m_geometry.topLeft(), m_current);
+    } else {
+        // 降低了渲染比例，或布局刚变化、下一帧尚未到来，绘制时缩放
+        painter.drawImage(m_geometry, m_current);
+    }
+
+    // 绘制完成即视为显示，不含合成器和垂直同步的等待时间
+    if (timing.sequence != 0) {
+        timing.presentUs = monotonicNowUs();
+        m_latencyStats.record(timing);
+    }
+
+    if (!m_current.isNull()) {
+        m_overlay->paint(painter, m_geometry, m_currentCaptureUs, partial ? region : QRegion());
+    }
+
+    if (m_statsOverlayVisible) {
+        drawStatsOverlay(painter, !partial);
+    }
+
+    m_lastPaintTimeUs = timer.nsecsElapsed() / 1000;
+    m_averagePaintTimeUs = m_averagePaintTimeUs * 0.9 + m_lastPaintTimeUs * 0.1;
+}
+
+/**
+ * @brief 用当前画面重绘画面块的一部分
+ * @param painter 绘制器
+ * @param region 需要重绘的区域
+ *
+ * 按画面与画面块的比例逐个矩形换算源区域，只读写变化区域的像素
+ */
+void VideoTile::drawPartialFrame(QPainter& painter, const QRegion& region)
+{
+    const qreal scaleX = static_cast<qreal>(m_current.width()) / qMax(1, m_geometry.width());
+    const qreal scaleY = static_cast<qreal>(m_current.height()) / qMax(1, m_geometry.height());
+    for (const QRect& rect : region.intersected(m_geometry)) {
+        const QRectF source((rect.x() - m_geometry.x()) * scaleX, (rect.y() - m_geometry.y()) * scaleY,
+                            rect.width() * scaleX, rect.height() * scaleY);
+        painter.drawImage(QRectF(rect), m_current, source);
+    }
+}
+
+/**
+ * @brief 绘制延迟统计叠加层
+ * @param painter 绘制器
+ * @param refreshText 是否允许刷新统计文字
+ *
+ * 统计文字每500毫秒刷新一次，避免每帧都格式化字符串；局部绘制时不刷新，
+ * 否则统计框内会出现新旧两份文字
+ */
+void VideoTile::drawStatsOverlay(QPainter& painter, bool refreshText)
+{
+    const qint64 nowUs = monotonicNowUs();
+    if (m_statsText.isEmpty() || (refreshText && nowUs - m_statsTextUpdatedUs >= kStatsTextIntervalUs)) {
+        const LatencyStats::Summary stats = m_latencyStats.summary();
+        m_statsText = QString("延迟 p50 %1 / p99 %2 / 最大 %3 ms\n丢帧 %4  间隔 %8 ± %9 ms\n解码 %5 缩放 %6 绘制 %7 ms")
+                          .arg(stats.p50Ms, 0, 'f', 0)
+                          .arg(stats.p99Ms, 0, 'f', 0)
+                          .arg(stats.maxMs, 0, 'f', 1)
+                          .arg(stats.dropped)
+                          .arg(stats.decodeMs, 0, 'f', 1)
+                          .arg(stats.convertMs, 0, 'f', 1)
+                          .arg(stats.presentMs, 0, 'f', 1)
+                          .arg(stats.intervalMs, 0, 'f', 1)
+                          .arg(stats.jitterMs, 0, 'f', 1);
+        m_statsTextUpdatedUs = nowUs;
+    }
+
+    const QRect textRect = painter.fontMetrics().boundingRect(m_geometry, Qt::AlignLeft | Qt::AlignTop, m_statsText);
+    const QRect box = textRect.adjusted(0, 0, 12, 8).translated(6, 6).intersected(m_geometry);
+    painter.fillRect(box, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::green);
+    painter.drawText(box.adjusted(6, 4, -6, -4), Qt::AlignLeft | Qt::AlignTop, m_statsText);
+}
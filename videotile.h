@@ -0,0 +1,223 @@
+/**
+ * @file videotile.h
+ * @brief 摄像头画面块的头文件
+ *
+ * 该文件定义了VideoTile类，表示合成器中一个摄像头的画面区域。
+ * 帧在后台线程中一次性缩放到画面块的设备像素尺寸，合成时直接贴图，不做任何格式转换。
+ */
+#ifndef VIDEOTILE_H
+#define VIDEOTILE_H
+
+#include <QObject>
+#include <QImage>
+#include <QRect>
+#include <QRegion>
+#include <QString>
+
+#include <memory>
+
+#include "frametiming.h"
+#include "latencystats.h"
+
+class OverlayLayer;
+class QPainter;
+struct TileScaleState;
+
+/**
+ * @class VideoTile
+ * @brief 摄像头画面块
+ *
+ * 不是独立的控件，由CameraCompositor布局并绘制到合成器的后备缓冲区。
+ * setFrame()只把帧交给线程池缩放，缩放完成后通过updateRequested()通知合成器；
+ * 若缩放尚未完成又来了新帧，只保留最新的一帧。
+ * 每显示一帧都把该帧的时间戳记入延迟统计，可选择在画面上叠加统计信息。
+ * 车道线、目标框等分析结果由分析线程发布到overlay()叠加层，绘制时按画面块的当前位置叠加，
+ * 不写入画面像素；只有叠加层变化时通过regionUpdateRequested()只重绘变化的区域。
+ */
+class VideoTile : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param parent 父对象指针，默认为nullptr
+     */
+    explicit VideoTile(QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~VideoTile() override;
+
+    /**
+     * @brief 设置新的一帧画面（仅界面线程调用）
+     * @param frame 原始分辨率的帧图像，可以借用采集缓冲区
+     * @param timing 帧时间戳，序号为0时不计入延迟统计
+     */
+    void setFrame(const QImage& frame, const FrameTiming& timing = FrameTiming());
+
+    /**
+     * @brief 清除当前画面，显示提示文字（仅界面线程调用）
+     */
+    void clearFrame();
+
+    /**
+     * @brief 获取矢量叠加层
+     * @return 叠加层，由画面块拥有，分析线程通过其发布通道发布图元
+     */
+    OverlayLayer* overlay() const { return m_overlay; }
+
+    /**
+     * @brief 设置无画面时显示的提示文字
+     * @param text 提示文字
+     */
+    void setPlaceholderText(const QString& text);
+
+    /**
+     * @brief 设置画面块在合成器中的位置
+     * @param rect 位置（合成器的逻辑坐标）
+     * @param devicePixelRatio 合成器的设备像素比
+     */
+    void setGeometry(const QRect& rect, qreal devicePixelRatio);
+
+    /**
+     * @brief 获取画面块在合成器中的位置
+     * @return 位置（合成器的逻辑坐标）
+     */
+    QRect geometry() const { return m_geometry; }
+
+    /**
+     * @brief 获取画面块的设备像素尺寸
+     * @return 设备像素尺寸
+     */
+    QSize deviceSize() const;
+
+    /**
+     * @brief 获取后台缩放的目标尺寸，即设备像素尺寸乘以渲染比例
+     * @return 目标尺寸
+     */
+    QSize targetSize() const;
+
+    /**
+     * @brief 设置渲染比例，小于1时按较小的尺寸解码和缩放，绘制时再放大
+     * @param scale 渲染比例（0~1]
+     */
+    void setRenderScale(qreal scale);
+
+    /**
+     * @brief 获取渲染比例
+     * @return 渲染比例
+     */
+    qreal renderScale() const { return m_renderScale; }
+
+    /**
+     * @brief 绘制画面块（仅界面线程调用）
+     * @param painter 合成器后备缓冲区的绘制器
+     * @param region 需要重绘的区域（合成器的逻辑坐标），为空或覆盖整个画面块时完整绘制
+     *
+     * 完整绘制时取走最新的已缩放画面贴到geometry()处，新画面绘制完成后计入延迟统计；
+     * 局部绘制时只用当前画面重绘region内的部分，再叠加图元
+     */
+    void paint(QPainter& painter, const QRegion& region = QRegion());
+
+    /**
+     * @brief 获取最近一次绘制耗时
+     * @return 绘制耗时（微秒）
+     */
+    qint64 lastPaintTimeUs() const { return m_lastPaintTimeUs; }
+
+    /**
+     * @brief 获取绘制耗时的滑动平均值
+     * @return 平均绘制耗时（微秒）
+     */
+    double averagePaintTimeUs() const { return m_averagePaintTimeUs; }
+
+    /**
+     * @brief 获取延迟统计
+     * @return 延迟统计
+     */
+    const LatencyStats& latencyStats() const { return m_latencyStats; }
+
+    /**
+     * @brief 设置是否在画面上叠加延迟统计
+     * @param visible 是否显示
+     */
+    void setStatsOverlayVisible(bool visible);
+
+    /**
+     * @brief 是否在画面上叠加延迟统计
+     * @return 是否显示
+     */
+    bool statsOverlayVisible() const { return m_statsOverlayVisible; }
+
+public slots:
+    /**
+     * @brief 请求合成器重绘该画面块
+     */
+    void update();
+
+signals:
+    /**
+     * @brief 后台缩放的目标尺寸发生变化
+     * @param size 新的目标尺寸（设备像素）
+     */
+    void targetSizeChanged(const QSize& size);
+
+    /**
+     * @brief 画面块需要重绘
+     * @param tile 画面块
+     */
+    void updateRequested(VideoTile *tile);
+
+    /**
+     * @brief 画面块的一部分需要重绘，画面本身没有变化
+     * @param tile 画面块
+     * @param region 需要重绘的区域（合成器的逻辑坐标）
+     */
+    void regionUpdateRequested(VideoTile *tile, const QRegion& region);
+
+private slots:
+    /**
+     * @brief 叠加层有新发布的图元，请求重绘变化的区域
+     */
+    void onOverlayChanged();
+
+private:
+    /**
+     * @brief 更新后台缩放的目标尺寸
+     * @param oldSize 变化前的目标尺寸
+     */
+    void updateTargetSize(const QSize& oldSize);
+
+    /**
+     * @brief 绘制延迟统计叠加层
+     * @param painter 绘制器
+     * @param refreshText 是否允许刷新统计文字
+     */
+    void drawStatsOverlay(QPainter& painter, bool refreshText);
+
+    /**
+     * @brief 用当前画面重绘画面块的一部分
+     * @param painter 绘制器
+     * @param region 需要重绘的区域
+     */
+    void drawPartialFrame(QPainter& painter, const QRegion& region);
+
+    std::shared_ptr<TileScaleState> m_state;    ///< 与后台缩放任务共享的状态
+    QImage m_current;                           ///< 当前显示的已缩放画面
+    QRect m_geometry;                           ///< 在合成器中的位置（逻辑坐标）
+    qreal m_devicePixelRatio;                   ///< 合成器的设备像素比
+    qreal m_renderScale;                        ///< 渲染比例
+    QString m_placeholderText;                  ///< 无画面时的提示文字
+    OverlayLayer *m_overlay;                    ///< 矢量叠加层（子对象）
+    qint64 m_currentCaptureUs;                  ///< 当前画面的采集时刻（单调时钟，微秒）
+    qint64 m_lastPaintTimeUs;                   ///< 最近一次绘制耗时（微秒）
+    double m_averagePaintTimeUs;                ///< 绘制耗时滑动平均值（微秒）
+    LatencyStats m_latencyStats;                ///< 采集到显示的延迟统计
+    bool m_statsOverlayVisible;                 ///< 是否叠加显示延迟统计
+    QString m_statsText;                        ///< 缓存的统计文字
+    qint64 m_statsTextUpdatedUs;                ///< 统计文字的更新时刻
+};
+
+#endif // VIDEOTILE_H
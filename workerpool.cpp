@@ -0,0 +1,22 @@
+/**
+ * @file workerpool.cpp
+ * @brief 帧处理共享线程池的实现文件
+ */
+#include "workerpool.h"
+
+#include <QThread>
+#include <QThreadPool>
+
+/**
+ * @brief 获取帧处理共享线程池
+ * @return 线程池指针
+ */
+QThreadPool* frameWorkerPool()
+{
+    static QThreadPool *pool = [] {
+        QThreadPool *p = new QThreadPool();
+        p->setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        return p;
+    }();
+    return pool;
+}
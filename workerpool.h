@@ -0,0 +1,19 @@
+/**
+ * @file workerpool.h
+ * @brief 帧处理共享线程池的头文件
+ */
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+class QThreadPool;
+
+/**
+ * @brief 获取帧处理共享线程池
+ * @return 线程池指针，线程数不超过CPU核心数
+ *
+ * 解码、缩放等CPU密集的帧处理任务都提交到这个线程池，
+ * 摄像头数量增加时只会排队，而不会创建更多线程
+ */
+QThreadPool* frameWorkerPool();
+
+#endif // WORKERPOOL_H